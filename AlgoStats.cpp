@@ -0,0 +1,87 @@
+//mail: guyes134@gmail.com
+
+#include "AlgoStats.hpp"
+#include <sstream>
+
+#ifdef GRAPH_STATS
+#include <cstdlib>
+#include <new>
+#endif
+
+using namespace std;
+
+#ifdef GRAPH_STATS
+
+namespace {
+    thread_local AlgoStats *currentStats = nullptr;
+    thread_local long long allocations = 0;
+    thread_local int depth = 0;
+}
+
+AlgoStats *&AlgoStatsDetail::current() {
+    return currentStats;
+}
+
+long long &AlgoStatsDetail::allocationCount() {
+    return allocations;
+}
+
+int &AlgoStatsDetail::callDepth() {
+    return depth;
+}
+
+/**
+ * @brief Replaces the global operator new to count the allocations of the current thread.
+ * The array and nothrow forms of the standard library forward to it.
+ */
+void *operator new(size_t size) {
+    allocations++;
+    if (void *p = malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+#endif
+
+/**
+ * @brief Constructor that installs stats as the collector of the current thread.
+ *
+ * @param stats The counters to fill. They are not reset, so several scopes can add to the same stats.
+ */
+AlgoStatsScope::AlgoStatsScope(AlgoStats &stats) : previous(nullptr) {
+#ifdef GRAPH_STATS
+    previous = AlgoStatsDetail::current();
+    AlgoStatsDetail::current() = &stats;
+#else
+    (void) stats;
+#endif
+}
+
+/**
+ * @brief Destructor that restores the previous collector of the current thread.
+ */
+AlgoStatsScope::~AlgoStatsScope() {
+#ifdef GRAPH_STATS
+    AlgoStatsDetail::current() = previous;
+#endif
+}
+
+/**
+ * @brief Formats the counters as a single-line JSON object, for export to a metrics pipeline.
+ *
+ * @return std::string The counters, e.g. {"engine": "Dijkstra", "calls": 1, ...}.
+ */
+std::string AlgoStats::toJSON() const {
+    ostringstream out;
+    out << "{\"engine\": \"" << engine << "\", \"calls\": " << calls
+        << ", \"settled_vertices\": " << settledVertices << ", \"edges_scanned\": " << edgesScanned
+        << ", \"heap_pushes\": " << heapPushes << ", \"stale_pops\": " << stalePops
+        << ", \"relaxation_passes\": " << relaxationPasses << ", \"max_dfs_depth\": " << maxDFSDepth
+        << ", \"allocations\": " << allocations << ", \"wall_time_ns\": " << wallTimeNs << "}";
+    return out.str();
+}
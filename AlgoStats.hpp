@@ -0,0 +1,124 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include <string>
+
+#ifdef GRAPH_STATS
+#include <chrono>
+#endif
+
+/**
+ * Counters filled by the Algorithms functions called on the current thread while an AlgoStatsScope is alive.
+ *
+ * Collection only exists in builds with GRAPH_STATS defined (make STATS=1). Without it the ALGO_STATS macros
+ * expand to nothing and a scope leaves its counters at zero. Counters add up over every call made in the scope;
+ * wall time and allocations are only measured around the outermost Algorithms call, so nested calls are not
+ * counted twice. Allocations are the calls to the global operator new made during the measured calls.
+ */
+struct AlgoStats {
+    const char *engine; // The engine that ran last, e.g. "Dijkstra"
+    long long calls;
+    long long settledVertices;
+    long long edgesScanned;
+    long long heapPushes;
+    long long stalePops;
+    long long relaxationPasses;
+    long long dfsDepth;
+    long long maxDFSDepth;
+    long long allocations;
+    long long wallTimeNs;
+
+    AlgoStats(){
+        reset();
+    }
+
+    void reset(){
+        engine = "none";
+        calls = settledVertices = edgesScanned = heapPushes = stalePops = relaxationPasses = 0;
+        dfsDepth = maxDFSDepth = allocations = wallTimeNs = 0;
+    }
+
+    std::string toJSON() const;
+};
+
+/**
+ * Makes stats the collector of the current thread until the scope ends (scopes can be nested).
+ */
+class AlgoStatsScope{
+private:
+    AlgoStats *previous;
+
+public:
+    explicit AlgoStatsScope(AlgoStats &stats);
+    ~AlgoStatsScope();
+
+    AlgoStatsScope(const AlgoStatsScope &) = delete;
+    AlgoStatsScope &operator=(const AlgoStatsScope &) = delete;
+};
+
+#ifdef GRAPH_STATS
+
+namespace AlgoStatsDetail {
+    AlgoStats *&current();
+    long long &allocationCount();
+    int &callDepth();
+
+    // Measures the wall time and allocations of the outermost Algorithms call
+    class CallGuard{
+    private:
+        AlgoStats *stats;
+        long long allocationsBefore;
+        std::chrono::steady_clock::time_point begin;
+
+    public:
+        CallGuard() : stats(callDepth()++ == 0 ? current() : nullptr), allocationsBefore(0){
+            if (stats != nullptr) {
+                allocationsBefore = allocationCount();
+                begin = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~CallGuard(){
+            --callDepth();
+            if (stats != nullptr) {
+                stats->calls++;
+                stats->allocations += allocationCount() - allocationsBefore;
+                stats->wallTimeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+            }
+        }
+    };
+
+    // Tracks the depth of a recursive search
+    class DepthGuard{
+    private:
+        AlgoStats *stats;
+
+    public:
+        DepthGuard() : stats(current()){
+            if (stats != nullptr && ++stats->dfsDepth > stats->maxDFSDepth) {
+                stats->maxDFSDepth = stats->dfsDepth;
+            }
+        }
+
+        ~DepthGuard(){
+            if (stats != nullptr) {
+                stats->dfsDepth--;
+            }
+        }
+    };
+}
+
+#define ALGO_STATS_CALL() AlgoStatsDetail::CallGuard algoStatsCall_
+#define ALGO_STATS_DEPTH() AlgoStatsDetail::DepthGuard algoStatsDepth_
+#define ALGO_STATS_ENGINE(name) do { if (AlgoStats *algoStats_ = AlgoStatsDetail::current()) algoStats_->engine = (name); } while (0)
+#define ALGO_STATS_ADD(field, n) do { if (AlgoStats *algoStats_ = AlgoStatsDetail::current()) algoStats_->field += (n); } while (0)
+
+#else
+
+#define ALGO_STATS_CALL() do {} while (0)
+#define ALGO_STATS_DEPTH() do {} while (0)
+#define ALGO_STATS_ENGINE(name) do {} while (0)
+#define ALGO_STATS_ADD(field, n) do {} while (0)
+
+#endif
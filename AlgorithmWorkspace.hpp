@@ -0,0 +1,140 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Array whose reset is O(1): every slot carries the generation it was last written in,
+ * and a slot from an older generation reads as the initial value.
+ */
+template <typename T>
+class StampedArray{
+private:
+    std::vector<T> values;
+    std::vector<uint32_t> stamps;
+    uint32_t generation;
+    T initial;
+
+public:
+    StampedArray() : generation(0), initial() {}
+
+    /**
+     * @brief Makes every slot read as value again. Only allocates when size grows past the largest size seen.
+     */
+    void reset(size_t size, T value){
+        if (stamps.size() < size) {
+            values.resize(size);
+            stamps.resize(size, 0);
+        }
+        initial = value;
+        if (++generation == 0) { // The stamps wrapped around, old stamps could look current
+            std::fill(stamps.begin(), stamps.end(), 0);
+            generation = 1;
+        }
+    }
+
+    T get(size_t i) const{
+        return stamps[i] == generation ? values[i] : initial;
+    }
+
+    void set(size_t i, T value){
+        values[i] = value;
+        stamps[i] = generation;
+    }
+};
+
+/**
+ * The distance buffers of an AlgorithmWorkspace for one distance type.
+ */
+template <typename Distance>
+struct DistanceBuffers {
+    std::vector<std::pair<Distance, int>> heap;
+    StampedArray<Distance> dist;
+    std::vector<Distance> distVector;
+};
+
+/**
+ * Scratch memory reused by the Algorithms functions that accept it.
+ *
+ * All buffers keep their capacity between calls, so once a workspace has served a query on a graph of V vertices,
+ * later queries on graphs up to that size allocate nothing: per-vertex state is reset through generation stamps and
+ * the result is written into the workspace's own string. A workspace must not be shared between threads.
+ */
+class AlgorithmWorkspace{
+private:
+    DistanceBuffers<int> intBuffers;
+    DistanceBuffers<long> longBuffers;
+    DistanceBuffers<long long> longLongBuffers;
+    DistanceBuffers<double> doubleBuffers;
+
+    template <typename Distance>
+    DistanceBuffers<Distance> &buffers();
+
+public:
+    StampedArray<int> parent;
+    StampedArray<int> colors;
+    StampedArray<char> visited;
+    std::vector<int> queue;
+    std::vector<int> path; // The vertices of the last path found (end first) or cycle found (in reverse)
+    std::vector<int> order;
+    std::vector<int> setA;
+    std::vector<int> setB;
+    std::vector<int> counts;
+    std::vector<int> parents;
+    std::vector<int> components;
+    std::vector<int> componentRoots;
+    std::vector<int> componentSizes;
+    std::vector<bool> cyclic;
+    std::vector<bool> visitedFlags;
+    std::vector<bool> onStackFlags;
+    std::string result;
+
+    /**
+     * @brief The generation-stamped distances of the given distance type (int, long, long long or double).
+     */
+    template <typename Distance>
+    StampedArray<Distance> &distances(){
+        return buffers<Distance>().dist;
+    }
+
+    /**
+     * @brief A plain distance vector of the given type, for engines that take std::vector distances.
+     */
+    template <typename Distance>
+    std::vector<Distance> &distanceVector(){
+        return buffers<Distance>().distVector;
+    }
+
+    /**
+     * @brief The binary heap of (distance, vertex) pairs used by Dijkstra.
+     */
+    template <typename Distance>
+    std::vector<std::pair<Distance, int>> &heap(){
+        return buffers<Distance>().heap;
+    }
+};
+
+template <>
+inline DistanceBuffers<int> &AlgorithmWorkspace::buffers<int>(){
+    return intBuffers;
+}
+
+template <>
+inline DistanceBuffers<long> &AlgorithmWorkspace::buffers<long>(){
+    return longBuffers;
+}
+
+template <>
+inline DistanceBuffers<long long> &AlgorithmWorkspace::buffers<long long>(){
+    return longLongBuffers;
+}
+
+template <>
+inline DistanceBuffers<double> &AlgorithmWorkspace::buffers<double>(){
+    return doubleBuffers;
+}
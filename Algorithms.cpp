@@ -1,545 +1,2392 @@
-//mail: guyes134@gmail.com
-
-#include "Algorithms.hpp"
-#include "Graph.hpp"
-#include <iostream>
-#include <queue>
-#include <stack>
-#include <sstream>
-#include <limits>
-#include <algorithm>
-
-using namespace std;
-
-/**
- * @brief Checks if the graph is connected using Depth-First Search (DFS).
- *
- * This function performs a DFS starting from the first vertex and marks all reachable vertices.
- * If all vertices are visited, the graph is considered connected.
- *
- * @param g The graph to be checked.
- * @return int Returns 1 if the graph is connected, 0 otherwise.
- */
-int Algorithms::isConnected(const Graph &g) {
-    if (g.getVertexNum() == 0){
-        return 0;
-    }
-    std::vector<bool> visited(g.getVertexNum(), false);
-    Algorithms::DFS(g, 0, visited);
-    for (bool v : visited){
-        if (!v){
-            return 0;
-        }
-    }
-    return 1;
-}
-
-/**
- * @brief Function to relax all edges |V|-1 times in a graph.
- *
- * This function updates the distance and parent vectors by relaxing all the edges in the graph.
- * It is used in the Bellman-Ford and other shortest path algorithms.
- *
- * @param g The graph containing the edges.
- * @param dist The distance vector that will be updated.
- * @param parent The parent vector that will be updated to reconstruct paths.
- */
-void Algorithms::relaxEdges(const Graph &g, std::vector<int> &dist, std::vector<int> &parent) {
-    int V = g.getVertexNum();
-    std::vector<std::vector<int>> matrix = g.getAdjacencyMatrix();
-    const int INF = std::numeric_limits<int>::max();
-
-    for (int i = 1; i <= V - 1; ++i) {
-        for (int u = 0; u < V; ++u) {
-            for (int v = 0; v < V; ++v) {
-                if (matrix[u][v] != 0 && dist[u] != INF && dist[u] + matrix[u][v] < dist[v]) {
-                    dist[v] = dist[u] + matrix[u][v];
-                    parent[v] = u;
-                }
-            }
-        }
-    }
-}
-
-/**
- * @brief Helper function for Depth-First Search (DFS) to mark visited vertices.
- *
- * This function performs a DFS from a given vertex, marking all reachable vertices as visited.
- *
- * @param g The graph to be searched.
- * @param v The current vertex in the DFS.
- * @param visited A vector tracking which vertices have been visited.
- */
-void Algorithms::DFS(Graph g, int v, std::vector<bool> &visited) {
-    visited[v] = true;
-    for (int i = 0; i < g.getVertexNum(); ++i) {
-        if (g.getAdjacencyMatrix()[v][i] != 0 && !visited[i]) {
-            Algorithms::DFS(g, i, visited);
-        }
-    }
-}
-
-/**
- * @brief Finds the shortest path using Breadth-First Search (BFS) from start to end.
- *
- * This function finds the shortest path in an unweighted graph by exploring all nodes at the current depth level before moving on to nodes at the next depth level.
- *
- * @param g The graph in which the path is to be found.
- * @param start The starting vertex.
- * @param end The ending vertex.
- * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists.
- */
-std::string Algorithms::BFSShortestPath(const Graph &g, int start, int end) {
-    std::stringstream ss;
-    if (start == end) {
-        ss << start; // Same vertex, just print the vertex
-        return ss.str();
-    }
-
-    int vertexNum = g.getVertexNum();
-    if (vertexNum == 0) {
-        return "-1";
-    }
-
-    std::vector<bool> visited(vertexNum, false);
-    std::vector<int> parent(vertexNum, -1); // Parent of each vertex in the shortest path
-    std::queue<int> q;
-    q.push(start);
-    visited[start] = true;
-
-    bool found = false;
-    while (!q.empty() && !found) {
-        int currVertex = q.front();
-        q.pop();
-
-        // Visit neighbors
-        for (int i = 0; i < vertexNum; ++i) {
-            if (g.getAdjacencyMatrix()[currVertex][i] != 0 && !visited[i]) {
-                q.push(i);
-                visited[i] = true;
-                parent[i] = currVertex; // Set parent of i to currVertex
-                if (i == end) {
-                    found = true; // Found the end vertex
-                    break;
-                }
-            }
-        }
-    }
-
-    if (!found) {
-        return "-1";
-    }
-
-    // Reconstruct and print the path
-    std::stack<int> path;
-    int currVertex = end;
-    while (currVertex != -1) {
-        path.push(currVertex);
-        currVertex = parent[currVertex];
-    }
-
-    // Print the path
-    while (!path.empty()) {
-        ss << path.top();
-        path.pop();
-        if (!path.empty()) {
-            ss << "->";
-        }
-    }
-    return ss.str();
-}
-
-/**
- * @brief Finds the shortest path using Dijkstra's algorithm from start to end.
- *
- * This function finds the shortest path in a weighted graph with non-negative weights using Dijkstra's algorithm.
- *
- * @param g The graph in which the path is to be found.
- * @param start The starting vertex.
- * @param end The ending vertex.
- * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists.
- */
-std::string Algorithms::DijkstraShortestPath(const Graph &g, int start, int end) {
-    std::stringstream ss;
-    if (start == end) {
-        ss << start; // Same vertex, just print the vertex
-        return ss.str();
-    }
-
-    int vertexNum = g.getVertexNum();
-    if (vertexNum == 0) {
-        return "-1";
-    }
-
-    std::vector<int> dist(vertexNum, std::numeric_limits<int>::max());
-    std::vector<int> parent(vertexNum, -1); // Parent of each vertex in the shortest path
-    dist[start] = 0;
-
-    using pii = std::pair<int, int>;
-    std::priority_queue<pii, std::vector<pii>, std::greater<pii>> pq;
-    pq.push({0, start});
-
-    while (!pq.empty()) {
-        int currDist = pq.top().first;
-        int currVertex = pq.top().second;
-        pq.pop();
-
-        if (currDist > dist[currVertex]) continue;
-
-        for (int i = 0; i < vertexNum; ++i) {
-            if (g.getAdjacencyMatrix()[currVertex][i] != 0) {
-                int weight = g.getAdjacencyMatrix()[currVertex][i];
-                if (dist[currVertex] + weight < dist[i]) {
-                    dist[i] = dist[currVertex] + weight;
-                    pq.push({dist[i], i});
-                    parent[i] = currVertex;
-                }
-            }
-        }
-    }
-
-    if (dist[end] == std::numeric_limits<int>::max()) {
-        return "-1";
-    }
-
-    // Reconstruct and print the path
-    std::stack<int> path;
-    int currVertex = end;
-    while (currVertex != -1) {
-        path.push(currVertex);
-        currVertex = parent[currVertex];
-    }
-
-    // Print the path
-    while (!path.empty()) {
-        ss << path.top();
-        path.pop();
-        if (!path.empty()) {
-            ss << "->";
-        }
-    }
-    return ss.str();
-}
-
-/**
- * @brief Finds the shortest path using the Bellman-Ford algorithm from start to end.
- *
- * This function finds the shortest path in a graph that may have negative weights using the Bellman-Ford algorithm.
- * It also detects negative weight cycles.
- *
- * @param g The graph in which the path is to be found.
- * @param start The starting vertex.
- * @param end The ending vertex.
- * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists or "Negative cycle detected" if a negative cycle is found.
- */
-std::string Algorithms::BellmanFordShortestPath(const Graph &g, int start, int end) {
-    std::stringstream ss;
-    int vertexNum = g.getVertexNum();
-    const int INF = std::numeric_limits<int>::max();
-
-    if (vertexNum == 0 || start >= vertexNum || end >= vertexNum) {
-        return "-1";
-    }
-
-    std::vector<int> dist(vertexNum, INF);
-    std::vector<int> parent(vertexNum, -1);
-    dist[start] = 0;
-
-    // Relax all edges
-    relaxEdges(g, dist, parent);
-
-    // Check for negative weight cycles
-    for (int u = 0; u < vertexNum; ++u) {
-        for (int v = 0; v < vertexNum; ++v) {
-            int weight = g.getAdjacencyMatrix()[u][v];
-            if (weight != 0 && dist[u] != INF && dist[u] + weight < dist[v]) {
-                // Negative weight cycle found
-                return "Negative cycle detected";
-            }
-        }
-    }
-
-    if (dist[end] == INF) {
-        return "-1"; // No path found
-    }
-
-    // Reconstruct the path
-    std::stack<int> path;
-    int currVertex = end;
-    while (currVertex != -1) {
-        path.push(currVertex);
-        currVertex = parent[currVertex];
-    }
-
-    // Print the path
-    while (!path.empty()) {
-        ss << path.top();
-        path.pop();
-        if (!path.empty()) {
-            ss << "->";
-        }
-    }
-    return ss.str();
-}
-
-/**
- * @brief Determines the shortest path from start to end using the appropriate algorithm
- * based on the presence of negative weights and whether the graph is weighted.
- *
- * This function selects the appropriate shortest path algorithm based on the properties of the graph:
- * - Uses Bellman-Ford if the graph has negative weights.
- * - Uses Dijkstra if the graph is weighted but has no negative weights.
- * - Uses BFS if the graph is unweighted.
- *
- * @param g The graph in which the path is to be found.
- * @param start The starting vertex.
- * @param end The ending vertex.
- * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists.
- */
-std::string Algorithms::shortestPath(const Graph &g, int start, int end) {
-    if(start >= g.getVertexNum() || end >= g.getVertexNum()){
-        return "-1";
-    }
-    else if (g.getHasNegEdges()) {
-        return BellmanFordShortestPath(g, start, end);
-    }
-    else if (g.getIsWeighted()) {
-        return DijkstraShortestPath(g, start, end);
-    }
-    else {
-        return BFSShortestPath(g, start, end);
-    }
-}
-
-/**
- * @brief Utility function for Depth-First Search (DFS) to detect cycles in a graph.
- *
- * This function helps detect cycles by recursively visiting nodes and tracking their parents.
- * If a back edge (an edge that points to one of the node's ancestors in the DFS tree) is found,
- * a cycle exists in the graph.
- *
- * @param g The graph to be checked.
- * @param v The current vertex being visited.
- * @param visited A vector tracking which vertices have been visited.
- * @param parent A vector tracking the parent of each vertex.
- * @param cycleStart Reference to the starting vertex of the detected cycle.
- * @param cycleEnd Reference to the ending vertex of the detected cycle.
- * @return bool Returns true if a cycle is found, false otherwise.
- */
-bool Algorithms::DFSUtil(const Graph &g, int v, std::vector<bool> &visited, std::vector<int> &parent, int &cycleStart, int &cycleEnd) {
-    visited[v] = true;
-
-    for (int i = 0; i < g.getVertexNum(); ++i) {
-        if (g.getAdjacencyMatrix()[v][i] != 0) { // Check for an edge
-            if (!visited[i]) {
-                parent[i] = v;
-                if (DFSUtil(g, i, visited, parent, cycleStart, cycleEnd))
-                    return true;
-            } else if (i != parent[v]) { // A back edge found (and not the parent)
-                cycleStart = i;
-                cycleEnd = v;
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-/**
- * @brief Checks if the graph contains a cycle using Depth-First Search (DFS).
- *
- * This function detects cycles in a graph and returns the cycle as a string.
- * If no cycle is found, it returns "0".
- *
- * @param g The graph to be checked.
- * @return std::string The cycle in the graph as a string in the format "0->1->2". Returns "0" if no cycle is found.
- */
-std::string Algorithms::isContainsCycle(const Graph &g) {
-    std::vector<bool> visited(g.getVertexNum(), false);
-    std::vector<int> parent(g.getVertexNum(), -1);
-    int cycleStart = -1, cycleEnd = -1;
-
-    for (int i = 0; i < g.getVertexNum(); i++) {
-        if (!visited[i] && DFSUtil(g, i, visited, parent, cycleStart, cycleEnd))
-            break;
-    }
-
-    if (cycleStart == -1) {
-        return "0";
-    } else {
-        std::vector<int> cycle;
-        for (int v = cycleEnd; v != cycleStart; v = parent[v]) {
-            cycle.push_back(v);
-        }
-        cycle.push_back(cycleStart);
-        cycle.push_back(cycleEnd);  // Add the starting point to complete the cycle
-
-        // Reverse the cycle
-        std::reverse(cycle.begin(), cycle.end());
-
-        // Print the reversed cycle
-        std::ostringstream cycleStream;
-        cycleStream << "The cycle is: ";
-        for (size_t i = 0; i < cycle.size(); ++i) {
-            cycleStream << cycle[i];
-            if (i < cycle.size() - 1) {
-                cycleStream << "->";
-            }
-        }
-        return cycleStream.str();
-    }
-}
-
-/**
- * @brief Utility function for Breadth-First Search (BFS) to check if the graph is bipartite.
- *
- * This function checks if a graph can be colored with two colors such that no two adjacent vertices
- * share the same color, indicating that the graph is bipartite.
- *
- * @param g The graph to be checked.
- * @param src The source vertex from which BFS starts.
- * @param colors A vector tracking the color assigned to each vertex.
- * @param setA A vector tracking the vertices in set A of the bipartite graph.
- * @param setB A vector tracking the vertices in set B of the bipartite graph.
- * @return bool Returns true if the graph is bipartite, false otherwise.
- */
-bool Algorithms::BFSUtil(const Graph &g, int src, std::vector<int> &colors, std::vector<int> &setA, std::vector<int> &setB) {
-    std::queue<int> q;
-    q.push(src);
-    colors[src] = 1; // Start coloring the source vertex with color 1
-    setA.push_back(src); // Add to set A
-
-    while (!q.empty()) {
-        int u = q.front();
-        q.pop();
-
-        for (int v = 0; v < g.getVertexNum(); ++v) {
-            if (g.getAdjacencyMatrix()[u][v] != 0) { // There is an edge from u to v
-                if (colors[v] == -1) { // If vertex v is not colored
-                    colors[v] = 1 - colors[u]; // Assign an alternate color to v
-                    q.push(v);
-                    if (colors[v] == 1) {
-                        setA.push_back(v);
-                    } else {
-                        setB.push_back(v);
-                    }
-                } else if (colors[v] == colors[u]) { // If vertex u and v have the same color
-                    return false;
-                }
-            }
-        }
-    }
-    return true;
-}
-
-/**
- * @brief Checks if the graph is bipartite using Breadth-First Search (BFS).
- *
- * This function determines if a graph is bipartite by trying to color it with two colors.
- * It returns the sets A and B of the bipartite graph if it is bipartite, or "0" if it is not.
- *
- * @param g The graph to be checked.
- * @return std::string A string representation of the bipartite sets A and B. Returns "0" if the graph is not bipartite.
- */
-std::string Algorithms::isBipartite(const Graph &g) {
-    std::vector<int> colors(g.getVertexNum(), -1); // Initialize all vertices as not colored
-    std::vector<int> setA, setB;
-
-    for (int i = 0; i < g.getVertexNum(); ++i) {
-        if (colors[i] == -1) { // If the vertex is not colored
-            if (!BFSUtil(g, i, colors, setA, setB)) {
-                return "0";
-            }
-        }
-    }
-
-    std::ostringstream result;
-    result << "The graph is bipartite: A={";
-    for (size_t i = 0; i < setA.size(); ++i) {
-        result << setA[i];
-        if (i < setA.size() - 1) {
-            result << ", ";
-        }
-    }
-    result << "}, B={";
-    for (size_t i = 0; i < setB.size(); ++i) {
-        result << setB[i];
-        if (i < setB.size() - 1) {
-            result << ", ";
-        }
-    }
-    result << "}";
-
-    return result.str();
-}
-
-/**
- * @brief Checks for the presence of negative weight cycles using the Bellman-Ford algorithm.
- *
- * This function detects negative weight cycles in a graph. If such a cycle is found, it returns the cycle as a string.
- * If no cycle is found, it returns "0".
- *
- * @param g The graph to be checked.
- * @return std::string The negative weight cycle in the graph as a string in the format "0->1->2". Returns "0" if no cycle is found.
- */
-std::string Algorithms::negativeCycle(const Graph &g) {
-    std::stringstream ss;
-    int V = g.getVertexNum();
-    const int INF = std::numeric_limits<int>::max();
-    std::vector<std::vector<int>> matrix = g.getAdjacencyMatrix();
-    std::vector<int> dist(V, INF);
-    std::vector<int> parent(V, -1);
-
-    dist[0] = 0;
-
-    if (isContainsCycle(g) == "0") {
-        return "0";
-    }
-
-    // Relax all edges
-    relaxEdges(g, dist, parent);
-
-    // Check for negative weight cycles
-    for (int u = 0; u < V; ++u) {
-        for (int v = 0; v < V; ++v) {
-            if (matrix[u][v] != 0 && dist[u] != INF && dist[u] + matrix[u][v] < dist[v]) {
-                std::vector<int> cycle;
-                std::vector<bool> visited(V, false);
-
-                // To find the cycle, we follow the parent links until we find a cycle
-                int cycleVertex = v;
-                while (!visited[cycleVertex]) {
-                    visited[cycleVertex] = true;
-                    cycleVertex = parent[cycleVertex];
-                }
-
-                int startVertex = cycleVertex;
-                cycle.push_back(startVertex);
-                for (int cur = parent[startVertex]; cur != startVertex; cur = parent[cur]) {
-                    cycle.push_back(cur);
-                }
-                cycle.push_back(startVertex);
-
-                std::reverse(cycle.begin(), cycle.end());
-
-                // Check the cycle size for undirected graphs
-                if (cycle.size() < 4) {
-                    ss << "0";
-                    return ss.str();
-                }
-
-                ss << "The negative weight cycle is: ";
-                for (size_t i = 0; i < cycle.size(); ++i) {
-                    ss << cycle[i];
-                    if (i < cycle.size() - 1) {
-                        ss << "->";
-                    }
-                }
-                return ss.str();
-            }
-        }
-    }
-
-    ss << "0";
-    return ss.str();
-}
+//mail: guyes134@gmail.com
+
+#include "Algorithms.hpp"
+#include "Graph.hpp"
+#include "GraphView.hpp"
+#include "GraphTraits.hpp"
+#include "AlgoStats.hpp"
+#include "Trace.hpp"
+#include <iostream>
+#include <queue>
+#include <stack>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief Appends the decimal form of value to out without going through a stream.
+     */
+    void appendInt(std::string &out, long long value) {
+        char digits[24];
+        int n = 0;
+        unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+        do {
+            digits[n++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0) {
+            out += '-';
+        }
+        while (n > 0) {
+            out += digits[--n];
+        }
+    }
+
+    int parentOf(const StampedArray<int> &parent, int v) {
+        return parent.get(v);
+    }
+
+    int parentOf(const std::vector<int> &parent, int v) {
+        return parent[v];
+    }
+
+    /**
+     * @brief Appends the path ending at end in the format "0->1->2", following the parent links.
+     *
+     * @param out The string to append to.
+     * @param path Scratch vector for the reversed path.
+     * @param parent The parent of every vertex, -1 for the source.
+     * @param end The last vertex of the path.
+     */
+    template <typename Parents>
+    void appendPath(std::string &out, std::vector<int> &path, const Parents &parent, int end) {
+        TRACE_SPAN("path reconstruction");
+        path.clear();
+        for (int currVertex = end; currVertex != -1; currVertex = parentOf(parent, currVertex)) {
+            path.push_back(currVertex);
+        }
+        for (size_t i = path.size(); i-- > 0;) {
+            appendInt(out, path[i]);
+            if (i > 0) {
+                out += "->";
+            }
+        }
+    }
+
+    /**
+     * @brief Orders the edges of a spanning forest by weight, then by their endpoints, a strict total order.
+     *
+     * With no two edges equal the minimum spanning forest is unique, so Prim and Borůvka return the same edges
+     * and Borůvka cannot close a cycle between components whose cheapest edges weigh the same.
+     */
+    template <typename Weight>
+    bool lighterEdge(Weight w1, int u1, int v1, Weight w2, int u2, int v2) {
+        if (w1 != w2) {
+            return w1 < w2;
+        }
+        if (std::min(u1, v1) != std::min(u2, v2)) {
+            return std::min(u1, v1) < std::min(u2, v2);
+        }
+        return std::max(u1, v1) < std::max(u2, v2);
+    }
+
+    // The index of the lowest set bit of a non-zero mask
+    int lowestBit(uint64_t mask) {
+#ifdef __GNUC__
+        return __builtin_ctzll(mask);
+#else
+        int bit = 0;
+        for (; (mask & 1) == 0; mask >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    int findRoot(std::vector<int> &root, int v) {
+        while (root[v] != v) {
+            root[v] = root[root[v]];
+            v = root[v];
+        }
+        return v;
+    }
+
+    /**
+     * @brief Runs one batch of up to 64 BFS traversals together, source i of the batch owning bit i of every mask.
+     *
+     * Every level, each vertex of the frontier scans its neighbours once for all the sources that reached it
+     * (visit[u]) and ORs them into next; a source reaches a vertex for the first time when its bit is in next but not
+     * in seen. expand(u, mask, next) must OR mask into next[v] for every out-neighbour v of u.
+     *
+     * @param first The index in sources of the first source of the batch.
+     * @param count The number of sources in the batch, at most 64.
+     */
+    template <typename Expand>
+    void multiSourceBatch(int V, const std::vector<int> &sources, int first, int count, std::vector<std::vector<int>> &distances,
+                          std::vector<uint64_t> &seen, std::vector<uint64_t> &visit, std::vector<uint64_t> &next, Expand expand) {
+        seen.assign(V, 0);
+        visit.assign(V, 0);
+        next.assign(V, 0);
+        for (int i = 0; i < count; ++i) {
+            int source = sources[first + i];
+            seen[source] |= uint64_t(1) << i;
+            visit[source] |= uint64_t(1) << i;
+            distances[first + i][source] = 0;
+        }
+
+        for (int level = 1, active = 1; active; ++level) {
+            for (int u = 0; u < V; ++u) {
+                if (visit[u] != 0) {
+                    ALGO_STATS_ADD(settledVertices, 1);
+                    expand(u, visit[u], next);
+                }
+            }
+            active = 0;
+            for (int v = 0; v < V; ++v) {
+                uint64_t reached = next[v] & ~seen[v];
+                next[v] = 0;
+                visit[v] = reached;
+                if (reached != 0) {
+                    active = 1;
+                    seen[v] |= reached;
+                    for (; reached != 0; reached &= reached - 1) {
+                        distances[first + lowestBit(reached)][v] = level;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Splits the sources into batches of 64 and runs them, in parallel if the context has a pool.
+     *
+     * @return bool false if a source is not a vertex, in which case distances is left empty.
+     */
+    template <typename Expand>
+    bool multiSourceBatches(int V, const std::vector<int> &sources, std::vector<std::vector<int>> &distances, const ExecutionContext &context, Expand expand) {
+        distances.clear();
+        for (int source : sources) {
+            if (source < 0 || source >= V) {
+                return false;
+            }
+        }
+        distances.assign(sources.size(), std::vector<int>(V, -1));
+        int batchNum = static_cast<int>((sources.size() + 63) / 64);
+        std::vector<std::vector<uint64_t>> masks(3 * context.concurrency());
+        auto runBatches = [&](int lane, int begin, int end) {
+            for (int batch = begin; batch < end; ++batch) {
+                int count = std::min(64, static_cast<int>(sources.size()) - 64 * batch);
+                multiSourceBatch(V, sources, 64 * batch, count, distances, masks[3 * lane], masks[3 * lane + 1], masks[3 * lane + 2], expand);
+            }
+        };
+
+        if (context.pool == nullptr) {
+            runBatches(0, 0, batchNum);
+        } else {
+            context.pool->parallelFor(0, batchNum, 1, runBatches, context.maxParallelism);
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Checks if the graph is connected using the strongly connected components of the graph.
+ *
+ * For an undirected graph the strongly connected components are exactly its connected components,
+ * and for a directed graph a single component means every vertex can reach every other vertex
+ * (strong connectivity), rather than only the vertices reachable from vertex 0.
+ *
+ * @param g The graph to be checked.
+ * @return int Returns 1 if the graph is connected, 0 otherwise.
+ */
+template <typename Weight, template <typename> class GraphType>
+int Algorithms::isConnected(const GraphType<Weight> &g) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    if (g.getVertexNum() == 0){
+        return 0;
+    }
+    int componentNum = 0;
+    stronglyConnectedComponents(g, componentNum);
+    return componentNum == 1 ? 1 : 0;
+}
+
+/**
+ * @brief Finds the strongly connected components of the graph using an iterative version of Tarjan's algorithm.
+ *
+ * The recursion of the classic algorithm is replaced by an explicit call stack holding the vertex and the next
+ * neighbour to scan, so large graphs cannot overflow the program stack. Runs in O(V^2) on the adjacency matrix,
+ * i.e. linear in its size.
+ *
+ * @param g The graph to be decomposed.
+ * @param componentNum Set to the number of strongly connected components found.
+ * @return std::vector<int> The component id of every vertex. Ids are given in reverse topological order of the
+ * condensation graph (a component only has edges to components with a smaller id).
+ */
+template <typename Weight, template <typename> class GraphType>
+std::vector<int> Algorithms::stronglyConnectedComponents(const GraphType<Weight> &g, int &componentNum) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("Tarjan");
+    int V = g.getVertexNum();
+    const auto &matrix = g.getAdjacencyMatrix();
+    std::vector<int> components(V, -1);
+    std::vector<int> index(V, -1);
+    std::vector<int> low(V, 0);
+    std::vector<bool> onStack(V, false);
+    std::vector<int> sccStack;
+    std::vector<std::pair<int, int>> callStack; // (vertex, next neighbour to scan)
+    int counter = 0;
+    componentNum = 0;
+
+    auto visit = [&](int v) {
+        ALGO_STATS_ADD(settledVertices, 1);
+        index[v] = low[v] = counter++;
+        sccStack.push_back(v);
+        onStack[v] = true;
+        callStack.push_back({v, 0});
+    };
+
+    for (int s = 0; s < V; ++s) {
+        if (index[s] != -1) {
+            continue;
+        }
+        visit(s);
+
+        while (!callStack.empty()) {
+            int v = callStack.back().first;
+            bool descended = false;
+
+            while (callStack.back().second < V) {
+                int w = callStack.back().second++;
+                if (matrix[v][w] == 0) {
+                    continue;
+                }
+                ALGO_STATS_ADD(edgesScanned, 1);
+                if (index[w] == -1) {
+                    visit(w);
+                    descended = true;
+                    break;
+                }
+                if (onStack[w]) {
+                    low[v] = std::min(low[v], index[w]);
+                }
+            }
+            if (descended) {
+                continue;
+            }
+
+            // All neighbours of v are done, v is the root of a component if nothing below it reached higher
+            if (low[v] == index[v]) {
+                int w;
+                do {
+                    w = sccStack.back();
+                    sccStack.pop_back();
+                    onStack[w] = false;
+                    components[w] = componentNum;
+                } while (w != v);
+                componentNum++;
+            }
+
+            callStack.pop_back();
+            if (!callStack.empty()) {
+                int u = callStack.back().first;
+                low[u] = std::min(low[u], low[v]);
+            }
+        }
+    }
+    return components;
+}
+
+/**
+ * @brief Marks the strongly connected components that can contain a cycle.
+ *
+ * A component can only contain a cycle if it has at least two vertices or a vertex with a self loop.
+ * All other (trivial) components are acyclic and can be skipped by the cycle searches.
+ *
+ * @param g The graph the components were computed for.
+ * @param components The component id of every vertex.
+ * @param componentNum The number of components.
+ * @return std::vector<bool> For every component id, true if the component is non-trivial.
+ */
+template <typename Weight, template <typename> class GraphType>
+std::vector<bool> Algorithms::cyclicComponents(const GraphType<Weight> &g, const std::vector<int> &components, int componentNum) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    std::vector<int> sizes(componentNum, 0);
+    std::vector<bool> cyclic(componentNum, false);
+    for (int v = 0; v < g.getVertexNum(); ++v) {
+        if (++sizes[components[v]] > 1 || g.getAdjacencyMatrix()[v][v] != 0) {
+            cyclic[components[v]] = true;
+        }
+    }
+    return cyclic;
+}
+
+/**
+ * @brief Builds the condensation graph, in which every strongly connected component is contracted to one vertex.
+ *
+ * The result is always a DAG. Vertex i of the condensation is component i, and there is an edge (of weight 1)
+ * from component a to component b if the original graph has an edge from a vertex of a to a vertex of b.
+ *
+ * @param g The original graph.
+ * @param components The component id of every vertex, as returned by stronglyConnectedComponents.
+ * @param componentNum The number of components.
+ * @return Graph The condensation DAG.
+ */
+template <typename Weight, template <typename> class GraphType>
+Graph Algorithms::condensationGraph(const GraphType<Weight> &g, const std::vector<int> &components, int componentNum) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    const auto &matrix = g.getAdjacencyMatrix();
+    std::vector<std::vector<int>> dag(componentNum, std::vector<int>(componentNum, 0));
+    for (int u = 0; u < g.getVertexNum(); ++u) {
+        for (int v = 0; v < g.getVertexNum(); ++v) {
+            if (matrix[u][v] != 0 && components[u] != components[v]) {
+                dag[components[u]][components[v]] = 1;
+            }
+        }
+    }
+    Graph condensation;
+    condensation.loadGraph(std::move(dag));
+    return condensation;
+}
+
+/**
+ * @brief Function to relax all edges |V|-1 times in a graph.
+ *
+ * This function updates the distance and parent vectors by relaxing all the edges in the graph.
+ * It is used in the Bellman-Ford and other shortest path algorithms.
+ *
+ * @param g The graph containing the edges.
+ * @param dist The distance vector that will be updated.
+ * @param parent The parent vector that will be updated to reconstruct paths.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+void Algorithms::relaxEdges(const GraphType<Weight> &g, std::vector<Distance> &dist, std::vector<int> &parent) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    int V = g.getVertexNum();
+    const auto &matrix = g.getAdjacencyMatrix();
+    const Distance INF = infiniteDistance<Distance>();
+
+    for (int i = 1; i <= V - 1; ++i) {
+        ALGO_STATS_ADD(relaxationPasses, 1);
+        TRACE_SPAN("relaxation round");
+        for (int u = 0; u < V; ++u) {
+            for (int v = 0; v < V; ++v) {
+                if (matrix[u][v] == 0) {
+                    continue;
+                }
+                ALGO_STATS_ADD(edgesScanned, 1);
+                if (dist[u] != INF && addDistance(dist[u], matrix[u][v]) < dist[v]) {
+                    dist[v] = addDistance(dist[u], matrix[u][v]);
+                    parent[v] = u;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Function to relax the edges of a single strongly connected component |C|-1 times.
+ *
+ * A shortest walk between two vertices of a component never leaves the component, so running the
+ * relaxation on its vertices alone gives the same distances inside it in O(|C|^3) instead of O(V^3).
+ *
+ * @param g The graph containing the edges.
+ * @param vertices The vertices of the component, in increasing order.
+ * @param dist The distance vector that will be updated.
+ * @param parent The parent vector that will be updated to reconstruct paths.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+void Algorithms::relaxEdges(const GraphType<Weight> &g, const std::vector<int> &vertices, std::vector<Distance> &dist, std::vector<int> &parent) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    const auto &matrix = g.getAdjacencyMatrix();
+    const Distance INF = infiniteDistance<Distance>();
+
+    for (size_t i = 1; i < vertices.size(); ++i) {
+        ALGO_STATS_ADD(relaxationPasses, 1);
+        TRACE_SPAN("relaxation round");
+        for (int u : vertices) {
+            if (dist[u] == INF) {
+                continue;
+            }
+            for (int v : vertices) {
+                if (matrix[u][v] == 0) {
+                    continue;
+                }
+                ALGO_STATS_ADD(edgesScanned, 1);
+                if (addDistance(dist[u], matrix[u][v]) < dist[v]) {
+                    dist[v] = addDistance(dist[u], matrix[u][v]);
+                    parent[v] = u;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Helper function for Depth-First Search (DFS) to mark visited vertices.
+ *
+ * This function performs a DFS from a given vertex, marking all reachable vertices as visited.
+ *
+ * @param g The graph to be searched.
+ * @param v The current vertex in the DFS.
+ * @param visited A vector tracking which vertices have been visited.
+ */
+template <typename Weight, template <typename> class GraphType>
+void Algorithms::DFS(const GraphType<Weight> &g, int v, std::vector<bool> &visited) {
+    ALGO_STATS_DEPTH();
+    visited[v] = true;
+    for (int i = 0; i < g.getVertexNum(); ++i) {
+        if (g.getAdjacencyMatrix()[v][i] != 0 && !visited[i]) {
+            Algorithms::DFS(g, i, visited);
+        }
+    }
+}
+
+/**
+ * @brief Finds the shortest path using Breadth-First Search (BFS) from start to end.
+ *
+ * This function finds the shortest path in an unweighted graph by exploring all nodes at the current depth level before moving on to nodes at the next depth level.
+ *
+ * @param g The graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists.
+ */
+template <typename Weight, template <typename> class GraphType>
+std::string Algorithms::BFSShortestPath(const GraphType<Weight> &g, int start, int end) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    AlgorithmWorkspace ws;
+    return BFSShortestPath(g, start, end, ws);
+}
+
+/**
+ * @brief Finds the shortest path using Breadth-First Search (BFS) from start to end, using the scratch memory of a workspace.
+ *
+ * Only the vertices the search touches are reset, and once the workspace is warm the query allocates nothing.
+ *
+ * @param g The graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @param ws The workspace holding the search state and the result.
+ * @return const std::string& The result of the query, stored in ws and valid until its next use. Same format as BFSShortestPath above.
+ */
+template <typename Weight, template <typename> class GraphType>
+const std::string &Algorithms::BFSShortestPath(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("BFS");
+    std::string &result = ws.result;
+    result.clear();
+    if (start == end) {
+        ws.path.assign(1, start);
+        appendInt(result, start); // Same vertex, just print the vertex
+        return result;
+    }
+
+    int vertexNum = g.getVertexNum();
+    if (vertexNum == 0) {
+        result = "-1";
+        return result;
+    }
+
+    const auto &matrix = g.getAdjacencyMatrix();
+    ws.visited.reset(vertexNum, false);
+    ws.parent.reset(vertexNum, -1); // Parent of each vertex in the shortest path
+    ws.queue.clear();
+    ws.queue.push_back(start);
+    ws.visited.set(start, true);
+
+    bool found = false;
+    for (size_t head = 0; head < ws.queue.size() && !found; ++head) {
+        int currVertex = ws.queue[head];
+        ALGO_STATS_ADD(settledVertices, 1);
+
+        // Visit neighbors
+        for (int i = 0; i < vertexNum; ++i) {
+            if (matrix[currVertex][i] == 0) {
+                continue;
+            }
+            ALGO_STATS_ADD(edgesScanned, 1);
+            if (!ws.visited.get(i)) {
+                ws.queue.push_back(i);
+                ws.visited.set(i, true);
+                ws.parent.set(i, currVertex); // Set parent of i to currVertex
+                if (i == end) {
+                    found = true; // Found the end vertex
+                    break;
+                }
+            }
+        }
+    }
+
+    if (!found) {
+        result = "-1";
+        return result;
+    }
+    appendPath(result, ws.path, ws.parent, end);
+    return result;
+}
+
+/**
+ * @brief Finds the shortest path using Dijkstra's algorithm from start to end.
+ *
+ * This function finds the shortest path in a weighted graph with non-negative weights using Dijkstra's algorithm.
+ *
+ * @param g The graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+std::string Algorithms::DijkstraShortestPath(const GraphType<Weight> &g, int start, int end) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    AlgorithmWorkspace ws;
+    return DijkstraShortestPath<Weight, Distance>(g, start, end, ws);
+}
+
+/**
+ * @brief Finds the shortest path using Dijkstra's algorithm from start to end, using the scratch memory of a workspace.
+ *
+ * The heap is a vector kept in the workspace and the distances are generation-stamped, so nothing is allocated
+ * or cleared in O(V) once the workspace is warm.
+ *
+ * @param g The graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @param ws The workspace holding the search state and the result.
+ * @return const std::string& The result of the query, stored in ws and valid until its next use. Same format as DijkstraShortestPath above.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+const std::string &Algorithms::DijkstraShortestPath(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("Dijkstra");
+    std::string &result = ws.result;
+    result.clear();
+    if (start == end) {
+        ws.path.assign(1, start);
+        appendInt(result, start); // Same vertex, just print the vertex
+        return result;
+    }
+
+    int vertexNum = g.getVertexNum();
+    if (vertexNum == 0) {
+        result = "-1";
+        return result;
+    }
+
+    const auto &matrix = g.getAdjacencyMatrix();
+    StampedArray<Distance> &dist = ws.distances<Distance>();
+    dist.reset(vertexNum, infiniteDistance<Distance>());
+    ws.parent.reset(vertexNum, -1); // Parent of each vertex in the shortest path
+    dist.set(start, 0);
+
+    typedef std::pair<Distance, int> pdi;
+    std::vector<pdi> &heap = ws.heap<Distance>();
+    std::greater<pdi> later;
+    heap.clear();
+    heap.push_back(pdi(0, start));
+    ALGO_STATS_ADD(heapPushes, 1);
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        Distance currDist = heap.back().first;
+        int currVertex = heap.back().second;
+        heap.pop_back();
+
+        if (currDist > dist.get(currVertex)) {
+            ALGO_STATS_ADD(stalePops, 1);
+            continue;
+        }
+        ALGO_STATS_ADD(settledVertices, 1);
+
+        for (int i = 0; i < vertexNum; ++i) {
+            if (matrix[currVertex][i] != 0) {
+                ALGO_STATS_ADD(edgesScanned, 1);
+                Distance candidate = addDistance(currDist, matrix[currVertex][i]);
+                if (candidate < dist.get(i)) {
+                    dist.set(i, candidate);
+                    heap.push_back(pdi(candidate, i));
+                    std::push_heap(heap.begin(), heap.end(), later);
+                    ALGO_STATS_ADD(heapPushes, 1);
+                    ws.parent.set(i, currVertex);
+                }
+            }
+        }
+    }
+
+    if (dist.get(end) == infiniteDistance<Distance>()) {
+        result = "-1";
+        return result;
+    }
+    appendPath(result, ws.path, ws.parent, end);
+    return result;
+}
+
+/**
+ * @brief Finds the shortest path using the Bellman-Ford algorithm from start to end.
+ *
+ * This function finds the shortest path in a graph that may have negative weights using the Bellman-Ford algorithm.
+ * It also detects negative weight cycles.
+ *
+ * @param g The graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists or "Negative cycle detected" if a negative cycle is found.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+std::string Algorithms::BellmanFordShortestPath(const GraphType<Weight> &g, int start, int end) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    AlgorithmWorkspace ws;
+    return BellmanFordShortestPath<Weight, Distance>(g, start, end, ws);
+}
+
+/**
+ * @brief Finds the shortest path using the Bellman-Ford algorithm from start to end, using the scratch memory of a workspace.
+ *
+ * Bellman-Ford touches every vertex anyway, so the distances are plain vectors kept in the workspace.
+ *
+ * @param g The graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @param ws The workspace holding the search state and the result.
+ * @return const std::string& The result of the query, stored in ws and valid until its next use. Same format as BellmanFordShortestPath above.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+const std::string &Algorithms::BellmanFordShortestPath(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("BellmanFord");
+    std::string &result = ws.result;
+    result.clear();
+    int vertexNum = g.getVertexNum();
+    const Distance INF = infiniteDistance<Distance>();
+
+    if (vertexNum == 0 || start >= vertexNum || end >= vertexNum) {
+        result = "-1";
+        return result;
+    }
+
+    std::vector<Distance> &dist = ws.distanceVector<Distance>();
+    dist.assign(vertexNum, INF);
+    ws.parents.assign(vertexNum, -1);
+    dist[start] = 0;
+
+    // Relax all edges
+    relaxEdges(g, dist, ws.parents);
+
+    // Check for negative weight cycles
+    {
+        TRACE_SPAN("negative-cycle check");
+        for (int u = 0; u < vertexNum; ++u) {
+            for (int v = 0; v < vertexNum; ++v) {
+                Weight weight = g.getAdjacencyMatrix()[u][v];
+                if (weight != 0 && dist[u] != INF && addDistance(dist[u], weight) < dist[v]) {
+                    // Negative weight cycle found
+                    result = "Negative cycle detected";
+                    return result;
+                }
+            }
+        }
+    }
+
+    if (dist[end] == INF) {
+        result = "-1"; // No path found
+        return result;
+    }
+    appendPath(result, ws.path, ws.parents, end);
+    return result;
+}
+
+/**
+ * @brief Computes a topological order of the graph using Kahn's algorithm.
+ *
+ * Vertices with no incoming edges are removed one by one together with their outgoing edges.
+ * If some vertices are never removed they lie on a cycle and the graph is not a DAG.
+ * Runs in O(V^2) on the adjacency matrix.
+ *
+ * @param g The graph to be sorted.
+ * @param order Filled with the vertices in topological order (only complete if the graph is a DAG).
+ * @return bool Returns true if the graph is a directed acyclic graph, false otherwise.
+ */
+template <typename Weight, template <typename> class GraphType>
+bool Algorithms::topologicalSort(const GraphType<Weight> &g, std::vector<int> &order) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    AlgorithmWorkspace ws;
+    return topologicalSort(g, order, ws);
+}
+
+/**
+ * @brief Computes a topological order of the graph using Kahn's algorithm, keeping the in-degrees in a workspace.
+ *
+ * The order itself serves as the queue of removed vertices.
+ *
+ * @param g The graph to be sorted.
+ * @param order Filled with the vertices in topological order (only complete if the graph is a DAG).
+ * @param ws The workspace holding the in-degrees.
+ * @return bool Returns true if the graph is a directed acyclic graph, false otherwise.
+ */
+template <typename Weight, template <typename> class GraphType>
+bool Algorithms::topologicalSort(const GraphType<Weight> &g, std::vector<int> &order, AlgorithmWorkspace &ws) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("Kahn");
+    int V = g.getVertexNum();
+    const auto &matrix = g.getAdjacencyMatrix();
+    std::vector<int> &inDegree = ws.counts;
+    inDegree.assign(V, 0);
+    order.clear();
+    order.reserve(V);
+
+    for (int u = 0; u < V; ++u) {
+        for (int v = 0; v < V; ++v) {
+            if (matrix[u][v] != 0) {
+                inDegree[v]++;
+            }
+        }
+    }
+
+    for (int v = 0; v < V; ++v) {
+        if (inDegree[v] == 0) {
+            order.push_back(v);
+        }
+    }
+
+    for (size_t head = 0; head < order.size(); ++head) {
+        int u = order[head];
+        ALGO_STATS_ADD(settledVertices, 1);
+        for (int v = 0; v < V; ++v) {
+            if (matrix[u][v] != 0 && --inDegree[v] == 0) {
+                order.push_back(v);
+            }
+        }
+    }
+    return static_cast<int>(order.size()) == V;
+}
+
+/**
+ * @brief Relaxes every edge exactly once, in topological order, starting from the given vertex.
+ *
+ * When a vertex is reached in topological order all of its incoming edges have already been relaxed,
+ * so its distance is final. This gives exact shortest (or longest) paths in a DAG in a single pass,
+ * regardless of the signs of the weights.
+ *
+ * @param g The graph containing the edges (must be a DAG).
+ * @param order A topological order of the graph.
+ * @param start The source vertex.
+ * @param dist The distance vector that will be filled. Unreached vertices hold the largest distance (the lowest for longest paths).
+ * @param parent The parent vector that will be filled to reconstruct paths.
+ * @param longest Computes longest (critical) paths instead of shortest paths if true.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+void Algorithms::DAGRelaxEdges(const GraphType<Weight> &g, const std::vector<int> &order, int start, std::vector<Distance> &dist, std::vector<int> &parent, bool longest) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("DAG");
+    ALGO_STATS_ADD(relaxationPasses, 1);
+    TRACE_SPAN("relaxation round");
+    int V = g.getVertexNum();
+    const auto &matrix = g.getAdjacencyMatrix();
+    const Distance UNREACHED = longest ? std::numeric_limits<Distance>::lowest() : infiniteDistance<Distance>();
+
+    dist.assign(V, UNREACHED);
+    parent.assign(V, -1);
+    dist[start] = 0;
+
+    // Vertices before start in the order cannot be reached from it
+    size_t first = std::find(order.begin(), order.end(), start) - order.begin();
+    for (size_t k = first; k < order.size(); ++k) {
+        int u = order[k];
+        if (dist[u] == UNREACHED) {
+            continue;
+        }
+        ALGO_STATS_ADD(settledVertices, 1);
+        for (int v = 0; v < V; ++v) {
+            if (matrix[u][v] == 0) {
+                continue;
+            }
+            ALGO_STATS_ADD(edgesScanned, 1);
+            Distance candidate = addDistance(dist[u], matrix[u][v]);
+            if (dist[v] == UNREACHED || (longest ? candidate > dist[v] : candidate < dist[v])) {
+                dist[v] = candidate;
+                parent[v] = u;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Finds the shortest or longest path from start to end in a DAG with a known topological order.
+ *
+ * @param g The graph in which the path is to be found (must be a DAG).
+ * @param order A topological order of the graph.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @param longest Finds the longest (critical) path instead of the shortest one if true.
+ * @return std::string The path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+std::string Algorithms::DAGPath(const GraphType<Weight> &g, const std::vector<int> &order, int start, int end, bool longest) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    AlgorithmWorkspace ws;
+    return DAGPath<Weight, Distance>(g, order, start, end, longest, ws);
+}
+
+/**
+ * @brief Finds the shortest or longest path from start to end in a DAG, using the scratch memory of a workspace.
+ *
+ * @param g The graph in which the path is to be found (must be a DAG).
+ * @param order A topological order of the graph.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @param longest Finds the longest (critical) path instead of the shortest one if true.
+ * @param ws The workspace holding the distances and the result.
+ * @return const std::string& The result of the query, stored in ws and valid until its next use. Same format as DAGPath above.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+const std::string &Algorithms::DAGPath(const GraphType<Weight> &g, const std::vector<int> &order, int start, int end, bool longest, AlgorithmWorkspace &ws) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    std::string &result = ws.result;
+    result.clear();
+    if (start == end) {
+        ws.path.assign(1, start);
+        appendInt(result, start); // Same vertex, just print the vertex
+        return result;
+    }
+
+    DAGRelaxEdges(g, order, start, ws.distanceVector<Distance>(), ws.parents, longest);
+
+    if (ws.parents[end] == -1) {
+        result = "-1"; // No path found
+        return result;
+    }
+    appendPath(result, ws.path, ws.parents, end);
+    return result;
+}
+
+/**
+ * @brief Finds the shortest path in a directed acyclic graph by relaxing the edges in topological order.
+ *
+ * Works with negative weights and runs in O(V^2) on the adjacency matrix instead of the O(V^3) of Bellman-Ford.
+ *
+ * @param g The graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists or the graph is not a DAG.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+std::string Algorithms::DAGShortestPath(const GraphType<Weight> &g, int start, int end) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    std::vector<int> order;
+    if (start >= g.getVertexNum() || end >= g.getVertexNum() || !topologicalSort(g, order)) {
+        return "-1";
+    }
+    return DAGPath<Weight, Distance>(g, order, start, end, false);
+}
+
+/**
+ * @brief Finds the longest (critical) path in a directed acyclic graph by relaxing the edges in topological order.
+ *
+ * @param g The graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @return std::string The longest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists or the graph is not a DAG.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+std::string Algorithms::DAGLongestPath(const GraphType<Weight> &g, int start, int end) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    std::vector<int> order;
+    if (start >= g.getVertexNum() || end >= g.getVertexNum() || !topologicalSort(g, order)) {
+        return "-1";
+    }
+    return DAGPath<Weight, Distance>(g, order, start, end, true);
+}
+
+/**
+ * @brief Reconstructs the path ending at the given vertex by following the parent links.
+ *
+ * @param parent The parent of every vertex in the shortest path tree, -1 for the source.
+ * @param end The last vertex of the path.
+ * @return std::string The path as a string in the format "0->1->2".
+ */
+std::string Algorithms::pathToString(const std::vector<int> &parent, int end) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    std::vector<int> path;
+    for (int currVertex = end; currVertex != -1; currVertex = parent[currVertex]) {
+        path.push_back(currVertex);
+    }
+
+    std::string result;
+    for (size_t i = path.size(); i-- > 0;) {
+        appendInt(result, path[i]);
+        if (i > 0) {
+            result += "->";
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Finds the shortest path using Breadth-First Search (BFS) on a compressed graph.
+ *
+ * Neighbour lists are decoded on the fly, so every vertex costs O(degree) instead of O(V).
+ *
+ * @param g The compressed graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists.
+ */
+std::string Algorithms::BFSShortestPath(const CompressedGraph &g, int start, int end) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("BFS");
+    if (start == end) {
+        return std::to_string(start);
+    }
+
+    std::vector<bool> visited(g.getVertexNum(), false);
+    std::vector<int> parent(g.getVertexNum(), -1);
+    std::queue<int> q;
+    q.push(start);
+    visited[start] = true;
+
+    while (!q.empty()) {
+        int currVertex = q.front();
+        q.pop();
+        ALGO_STATS_ADD(settledVertices, 1);
+
+        for (CompressedGraph::NeighbourIterator it = g.neighbours(currVertex); it.valid(); it.next()) {
+            int i = it.vertex();
+            ALGO_STATS_ADD(edgesScanned, 1);
+            if (!visited[i]) {
+                q.push(i);
+                visited[i] = true;
+                parent[i] = currVertex;
+                if (i == end) {
+                    return pathToString(parent, end);
+                }
+            }
+        }
+    }
+    return "-1";
+}
+
+/**
+ * @brief Finds the shortest path using Dijkstra's algorithm on a compressed graph with non-negative weights.
+ *
+ * @param g The compressed graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists.
+ */
+std::string Algorithms::DijkstraShortestPath(const CompressedGraph &g, int start, int end) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("Dijkstra");
+    if (start == end) {
+        return std::to_string(start);
+    }
+
+    std::vector<long long> dist(g.getVertexNum(), infiniteDistance<long long>());
+    std::vector<int> parent(g.getVertexNum(), -1);
+    dist[start] = 0;
+
+    using pli = std::pair<long long, int>;
+    std::priority_queue<pli, std::vector<pli>, std::greater<pli>> pq;
+    pq.push({0, start});
+    ALGO_STATS_ADD(heapPushes, 1);
+
+    while (!pq.empty()) {
+        long long currDist = pq.top().first;
+        int currVertex = pq.top().second;
+        pq.pop();
+
+        if (currDist > dist[currVertex]) {
+            ALGO_STATS_ADD(stalePops, 1);
+            continue;
+        }
+        ALGO_STATS_ADD(settledVertices, 1);
+        if (currVertex == end) break;
+
+        for (CompressedGraph::NeighbourIterator it = g.neighbours(currVertex); it.valid(); it.next()) {
+            int i = it.vertex();
+            ALGO_STATS_ADD(edgesScanned, 1);
+            if (addDistance(currDist, it.weight()) < dist[i]) {
+                dist[i] = addDistance(currDist, it.weight());
+                pq.push({dist[i], i});
+                ALGO_STATS_ADD(heapPushes, 1);
+                parent[i] = currVertex;
+            }
+        }
+    }
+
+    if (dist[end] == infiniteDistance<long long>()) {
+        return "-1";
+    }
+    return pathToString(parent, end);
+}
+
+/**
+ * @brief Finds the shortest path using the Bellman-Ford algorithm on a compressed graph.
+ *
+ * Each pass walks the compressed edges once (O(E) per pass) and the passes stop as soon as nothing changes.
+ *
+ * @param g The compressed graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists or "Negative cycle detected" if a negative cycle is found.
+ */
+std::string Algorithms::BellmanFordShortestPath(const CompressedGraph &g, int start, int end) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("BellmanFord");
+    int V = g.getVertexNum();
+    const long long INF = infiniteDistance<long long>();
+    std::vector<long long> dist(V, INF);
+    std::vector<int> parent(V, -1);
+    dist[start] = 0;
+
+    bool changed = true;
+    for (int pass = 0; pass < V && changed; ++pass) {
+        changed = false;
+        ALGO_STATS_ADD(relaxationPasses, 1);
+        TRACE_SPAN("relaxation round");
+        for (int u = 0; u < V; ++u) {
+            if (dist[u] == INF) {
+                continue;
+            }
+            for (CompressedGraph::NeighbourIterator it = g.neighbours(u); it.valid(); it.next()) {
+                ALGO_STATS_ADD(edgesScanned, 1);
+                if (addDistance(dist[u], it.weight()) < dist[it.vertex()]) {
+                    dist[it.vertex()] = addDistance(dist[u], it.weight());
+                    parent[it.vertex()] = u;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    if (changed) {
+        return "Negative cycle detected"; // Still relaxing after V passes
+    }
+    if (dist[end] == INF) {
+        return "-1";
+    }
+    return pathToString(parent, end);
+}
+
+/**
+ * @brief Determines the shortest path on a compressed graph, choosing BFS, Dijkstra or Bellman-Ford
+ * from the graph properties like shortestPath does for a Graph.
+ *
+ * @param g The compressed graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists.
+ */
+std::string Algorithms::shortestPath(const CompressedGraph &g, int start, int end) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    if (start < 0 || end < 0 || start >= g.getVertexNum() || end >= g.getVertexNum()) {
+        return "-1";
+    }
+    else if (g.getHasNegEdges()) {
+        return BellmanFordShortestPath(g, start, end);
+    }
+    else if (g.getIsWeighted()) {
+        return DijkstraShortestPath(g, start, end);
+    }
+    else {
+        return BFSShortestPath(g, start, end);
+    }
+}
+
+/**
+ * @brief Computes the BFS distances from many sources at once (MS-BFS) on a compressed graph.
+ *
+ * Like the matrix version, but a frontier vertex decodes its neighbour list once per level for a whole batch.
+ *
+ * @param g The compressed graph to be searched.
+ * @param sources The sources; they may repeat.
+ * @param distances Set to one row per source, -1 for unreachable vertices.
+ * @param context The pool the batches may run on and the most workers to use.
+ * @return bool Returns false if a source is not a vertex of the graph, true otherwise.
+ */
+bool Algorithms::multiSourceBFS(const CompressedGraph &g, const std::vector<int> &sources, std::vector<std::vector<int>> &distances, const ExecutionContext &context) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("MS-BFS");
+    return multiSourceBatches(g.getVertexNum(), sources, distances, context, [&](int u, uint64_t mask, std::vector<uint64_t> &next) {
+        for (CompressedGraph::NeighbourIterator it = g.neighbours(u); it.valid(); it.next()) {
+            ALGO_STATS_ADD(edgesScanned, 1);
+            next[it.vertex()] |= mask;
+        }
+    });
+}
+
+namespace Algorithms {
+    /**
+     * Kernels specialized on the GraphKind tags. They trust the tags instead of checking the graph properties,
+     * so every kernel only contains the work its kind of graph needs.
+     */
+    namespace Kernels {
+        // Unweighted graphs hold only 0 and 1, so they are never signed. A row of the matrix is scanned without
+        // branches: every vertex is written past the end of the queue and the tail moves only for an unvisited
+        // neighbour, then the new part of the queue is marked. Only row u is read, which holds the out-neighbours
+        // of a directed graph and the neighbours of an undirected one, so both directions share the loop.
+        template <typename Weight, typename Distance, typename Direction, template <typename> class GraphType>
+        const std::string &shortestPathKernel(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws, GraphKind<Direction, Unweighted, NonNegative>) {
+            ALGO_STATS_ENGINE("BFS");
+            TRACE_SPAN("BFS kernel");
+            std::string &result = ws.result;
+            result.clear();
+            if (start == end) {
+                ws.path.assign(1, start);
+                appendInt(result, start);
+                return result;
+            }
+
+            const auto &matrix = g.getAdjacencyMatrix();
+            int V = g.getVertexNum();
+            ws.visited.reset(V, false);
+            ws.parent.reset(V, -1);
+            ws.queue.resize(V + 1); // One slot past the last vertex for the unconditional write
+            ws.queue[0] = start;
+            ws.visited.set(start, true);
+
+            size_t tail = 1;
+            for (size_t head = 0; head < tail; ++head) {
+                int u = ws.queue[head];
+                const auto &row = matrix[u];
+                ALGO_STATS_ADD(settledVertices, 1);
+                size_t first = tail;
+                for (int v = 0; v < V; ++v) {
+                    ws.queue[tail] = v;
+                    tail += static_cast<size_t>((row[v] != 0) & (ws.visited.get(v) == 0));
+                }
+                ALGO_STATS_ADD(edgesScanned, tail - first);
+                for (size_t k = first; k < tail; ++k) {
+                    int v = ws.queue[k];
+                    ws.visited.set(v, true);
+                    ws.parent.set(v, u);
+                    if (v == end) {
+                        appendPath(result, ws.path, ws.parent, end);
+                        return result;
+                    }
+                }
+            }
+            result = "-1";
+            return result;
+        }
+
+        // Dijkstra on the matrix. With non-negative weights a settled vertex is final: it is never relaxed again
+        // and the search stops as soon as end is settled. The signed variant serves undirected graphs, where a
+        // negative edge u-v is the negative cycle u->v->u: it settles everything reachable from start and gives
+        // up at the first negative cell it scans, instead of a separate reachability pass before Dijkstra.
+        template <typename Weight, typename Distance, typename Sign, template <typename> class GraphType>
+        const std::string &dijkstraKernel(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws, Sign) {
+            const bool checkSign = std::is_same<Sign, Signed>::value;
+            ALGO_STATS_ENGINE("Dijkstra");
+            TRACE_SPAN("Dijkstra kernel");
+            std::string &result = ws.result;
+            result.clear();
+            if (start == end && !checkSign) {
+                ws.path.assign(1, start);
+                appendInt(result, start);
+                return result;
+            }
+
+            const auto &matrix = g.getAdjacencyMatrix();
+            int V = g.getVertexNum();
+            StampedArray<Distance> &dist = ws.distances<Distance>();
+            dist.reset(V, infiniteDistance<Distance>());
+            ws.parent.reset(V, -1);
+            ws.visited.reset(V, false); // Settled vertices
+            dist.set(start, 0);
+
+            typedef std::pair<Distance, int> pdi;
+            std::vector<pdi> &heap = ws.heap<Distance>();
+            std::greater<pdi> later;
+            heap.clear();
+            heap.push_back(pdi(0, start));
+            ALGO_STATS_ADD(heapPushes, 1);
+
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                Distance currDist = heap.back().first;
+                int u = heap.back().second;
+                heap.pop_back();
+                if (ws.visited.get(u)) {
+                    ALGO_STATS_ADD(stalePops, 1);
+                    continue;
+                }
+                ws.visited.set(u, true);
+                ALGO_STATS_ADD(settledVertices, 1);
+                if (u == end && !checkSign) {
+                    break;
+                }
+
+                const auto &row = matrix[u];
+                for (int v = 0; v < V; ++v) {
+                    Weight weight = row[v];
+                    if (weight == 0) {
+                        continue;
+                    }
+                    if (checkSign && weight < 0) {
+                        result = "Negative cycle detected";
+                        return result;
+                    }
+                    if (ws.visited.get(v)) {
+                        continue;
+                    }
+                    ALGO_STATS_ADD(edgesScanned, 1);
+                    Distance candidate = addDistance(currDist, weight);
+                    if (candidate < dist.get(v)) {
+                        dist.set(v, candidate);
+                        ws.parent.set(v, u);
+                        heap.push_back(pdi(candidate, v));
+                        std::push_heap(heap.begin(), heap.end(), later);
+                        ALGO_STATS_ADD(heapPushes, 1);
+                    }
+                }
+            }
+
+            if (start == end) {
+                ws.path.assign(1, start);
+                appendInt(result, start);
+            }
+            else if (!ws.visited.get(end)) {
+                result = "-1";
+            }
+            else {
+                appendPath(result, ws.path, ws.parent, end);
+            }
+            return result;
+        }
+
+        // Bellman-Ford on the matrix for directed signed graphs. Rows of unreached vertices are skipped, and the
+        // passes stop as soon as one changes nothing; only if V-1 passes all changed something is the extra
+        // negative-cycle pass run.
+        template <typename Weight, typename Distance, template <typename> class GraphType>
+        const std::string &bellmanFordKernel(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws) {
+            ALGO_STATS_ENGINE("BellmanFord");
+            TRACE_SPAN("Bellman-Ford kernel");
+            std::string &result = ws.result;
+            const auto &matrix = g.getAdjacencyMatrix();
+            int V = g.getVertexNum();
+            const Distance INF = infiniteDistance<Distance>();
+            std::vector<Distance> &dist = ws.distanceVector<Distance>();
+            dist.assign(V, INF);
+            ws.parents.assign(V, -1);
+            dist[start] = 0;
+
+            bool changed = true;
+            for (int pass = 0; pass < V && changed; ++pass) {
+                ALGO_STATS_ADD(relaxationPasses, 1);
+                TRACE_SPAN("relaxation round");
+                changed = false;
+                for (int u = 0; u < V; ++u) {
+                    if (dist[u] == INF) {
+                        continue;
+                    }
+                    const auto &row = matrix[u];
+                    for (int v = 0; v < V; ++v) {
+                        if (row[v] == 0) {
+                            continue;
+                        }
+                        ALGO_STATS_ADD(edgesScanned, 1);
+                        Distance candidate = addDistance(dist[u], row[v]);
+                        if (candidate < dist[v]) {
+                            if (pass == V - 1) { // Still improving after V-1 passes
+                                result = "Negative cycle detected";
+                                return result;
+                            }
+                            dist[v] = candidate;
+                            ws.parents[v] = u;
+                            changed = true;
+                        }
+                    }
+                }
+            }
+
+            result.clear();
+            if (dist[end] == INF) {
+                result = "-1";
+                return result;
+            }
+            appendPath(result, ws.path, ws.parents, end);
+            return result;
+        }
+
+        // Directed, non-negative: a DAG takes a single topological pass, anything else Dijkstra stopping at end
+        template <typename Weight, typename Distance, template <typename> class GraphType>
+        const std::string &shortestPathKernel(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws, GraphKind<Directed, Weighted, NonNegative>) {
+            if (topologicalSort(g, ws.order, ws)) {
+                return DAGPath<Weight, Distance>(g, ws.order, start, end, false, ws);
+            }
+            return dijkstraKernel<Weight, Distance>(g, start, end, ws, NonNegative());
+        }
+
+        // Directed, signed: a DAG takes a single topological pass, anything else Bellman-Ford
+        template <typename Weight, typename Distance, template <typename> class GraphType>
+        const std::string &shortestPathKernel(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws, GraphKind<Directed, Weighted, Signed>) {
+            if (topologicalSort(g, ws.order, ws)) {
+                return DAGPath<Weight, Distance>(g, ws.order, start, end, false, ws);
+            }
+            return bellmanFordKernel<Weight, Distance>(g, start, end, ws);
+        }
+
+        // Undirected, non-negative: a symmetric matrix with an edge is never a DAG, so go straight to Dijkstra
+        template <typename Weight, typename Distance, template <typename> class GraphType>
+        const std::string &shortestPathKernel(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws, GraphKind<Undirected, Weighted, NonNegative>) {
+            return dijkstraKernel<Weight, Distance>(g, start, end, ws, NonNegative());
+        }
+
+        // Undirected, signed: a reachable negative edge is a negative cycle Bellman-Ford could only report, so the
+        // signed Dijkstra reports it while it settles the reachable vertices
+        template <typename Weight, typename Distance, template <typename> class GraphType>
+        const std::string &shortestPathKernel(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws, GraphKind<Undirected, Weighted, Signed>) {
+            return dijkstraKernel<Weight, Distance>(g, start, end, ws, Signed());
+        }
+
+        // Directed: cycles live inside the non-trivial strongly connected components
+        template <typename Weight, template <typename> class GraphType>
+        void cycleComponentsKernel(const GraphType<Weight> &g, AlgorithmWorkspace &ws, Directed) {
+            int componentNum = 0;
+            ws.components = stronglyConnectedComponents(g, componentNum);
+            ws.cyclic = cyclicComponents(g, ws.components, componentNum);
+        }
+
+        // Undirected: union-find over the upper half of the matrix. An edge joining two vertices that are
+        // already connected (or a self loop) closes a cycle, so tree components are skipped by the DFS.
+        template <typename Weight, template <typename> class GraphType>
+        void cycleComponentsKernel(const GraphType<Weight> &g, AlgorithmWorkspace &ws, Undirected) {
+            const auto &matrix = g.getAdjacencyMatrix();
+            int V = g.getVertexNum();
+            std::vector<int> &root = ws.componentRoots;
+            std::vector<int> &size = ws.componentSizes;
+            std::vector<int> &closing = ws.path; // Vertices with an edge that closes a cycle
+            root.resize(V);
+            size.assign(V, 1);
+            closing.clear();
+            for (int v = 0; v < V; ++v) {
+                root[v] = v;
+            }
+            auto find = [&](int v) {
+                while (root[v] != v) {
+                    root[v] = root[root[v]];
+                    v = root[v];
+                }
+                return v;
+            };
+
+            for (int u = 0; u < V; ++u) {
+                for (int v = u; v < V; ++v) {
+                    if (matrix[u][v] == 0) {
+                        continue;
+                    }
+                    int a = find(u), b = find(v);
+                    if (a == b) {
+                        closing.push_back(u);
+                        continue;
+                    }
+                    if (size[a] < size[b]) {
+                        std::swap(a, b);
+                    }
+                    root[b] = a;
+                    size[a] += size[b];
+                }
+            }
+
+            std::vector<int> &ids = ws.counts;
+            ids.assign(V, -1);
+            int componentNum = 0;
+            ws.components.assign(V, -1);
+            for (int v = 0; v < V; ++v) {
+                int r = find(v);
+                if (ids[r] == -1) {
+                    ids[r] = componentNum++;
+                }
+                ws.components[v] = ids[r];
+            }
+            ws.cyclic.assign(componentNum, false);
+            for (int v : closing) {
+                ws.cyclic[ws.components[v]] = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Determines the shortest path from start to end using the appropriate algorithm
+ * based on the presence of negative weights and whether the graph is weighted.
+ *
+ * This function reads the properties of the graph once and runs the kernel specialized for its GraphKind:
+ * - Uses a single topological-order pass if the graph is a weighted DAG (even with negative weights).
+ * - Reports a reachable negative edge of an undirected graph as a negative cycle without running Bellman-Ford.
+ * - Uses Bellman-Ford if the graph has negative weights.
+ * - Uses Dijkstra if the graph is weighted but has no negative weights.
+ * - Uses BFS if the graph is unweighted.
+ *
+ * @param g The graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @return std::string The shortest path from start to end as a string in the format "0->1->2". Returns "-1" if no path exists.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+std::string Algorithms::shortestPath(const GraphType<Weight> &g, int start, int end) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    AlgorithmWorkspace ws;
+    return shortestPath<Weight, Distance>(g, start, end, ws);
+}
+
+/**
+ * @brief Determines the shortest path from start to end like shortestPath above, using the scratch memory of a workspace.
+ *
+ * A server answering many queries keeps one workspace per thread; once it is warm the queries allocate nothing.
+ *
+ * @param g The graph in which the path is to be found.
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @param ws The workspace holding the search state and the result.
+ * @return const std::string& The result of the query, stored in ws and valid until its next use.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+const std::string &Algorithms::shortestPath(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    if(start >= g.getVertexNum() || end >= g.getVertexNum()){
+        ws.result = "-1";
+        return ws.result;
+    }
+    else if (!g.getIsWeighted()) {
+        if (g.getIsDirected()) {
+            return Kernels::shortestPathKernel<Weight, Distance>(g, start, end, ws, GraphKind<Directed, Unweighted, NonNegative>());
+        }
+        return Kernels::shortestPathKernel<Weight, Distance>(g, start, end, ws, GraphKind<Undirected, Unweighted, NonNegative>());
+    }
+    else if (g.getIsDirected()) {
+        if (g.getHasNegEdges()) {
+            return Kernels::shortestPathKernel<Weight, Distance>(g, start, end, ws, GraphKind<Directed, Weighted, Signed>());
+        }
+        return Kernels::shortestPathKernel<Weight, Distance>(g, start, end, ws, GraphKind<Directed, Weighted, NonNegative>());
+    }
+    else {
+        if (g.getHasNegEdges()) {
+            return Kernels::shortestPathKernel<Weight, Distance>(g, start, end, ws, GraphKind<Undirected, Weighted, Signed>());
+        }
+        return Kernels::shortestPathKernel<Weight, Distance>(g, start, end, ws, GraphKind<Undirected, Weighted, NonNegative>());
+    }
+}
+
+/**
+ * @brief Answers a batch of shortestPath queries, spread over the workers of the execution context.
+ *
+ * Every lane of the pool gets its own workspace, so the queries share nothing but the graph.
+ * With the default context the batch runs on the calling thread.
+ *
+ * @param g The graph in which the paths are to be found.
+ * @param queries The (start, end) pairs.
+ * @param context The pool to run on and the most workers to use.
+ * @return std::vector<std::string> The result of every query, in the order of the queries.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+std::vector<std::string> Algorithms::shortestPaths(const GraphType<Weight> &g, const std::vector<std::pair<int, int>> &queries, const ExecutionContext &context) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    std::vector<std::string> results(queries.size());
+    std::vector<AlgorithmWorkspace> workspaces(context.concurrency());
+    auto answer = [&](int lane, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            results[i] = shortestPath<Weight, Distance>(g, queries[i].first, queries[i].second, workspaces[lane]);
+        }
+    };
+
+    if (context.pool == nullptr) {
+        answer(0, 0, static_cast<int>(queries.size()));
+    } else {
+        context.pool->parallelFor(0, static_cast<int>(queries.size()), 1, answer, context.maxParallelism);
+    }
+    return results;
+}
+
+/**
+ * @brief Computes the BFS distances (in edges, ignoring weights) from many sources at once (MS-BFS).
+ *
+ * The sources run in batches of 64, one bit of a 64-bit mask per source, so a batch reads every row of the matrix at
+ * most once per level for all of its sources instead of once per source. Batches run on the pool of the context.
+ *
+ * @param g The graph to be searched.
+ * @param sources The sources; they may repeat.
+ * @param distances Set to one row per source: distances[i][v] is the number of edges on a shortest path from
+ * sources[i] to v, -1 if v is unreachable.
+ * @param context The pool the batches may run on and the most workers to use.
+ * @return bool Returns false if a source is not a vertex of the graph, true otherwise.
+ */
+template <typename Weight, template <typename> class GraphType>
+bool Algorithms::multiSourceBFS(const GraphType<Weight> &g, const std::vector<int> &sources, std::vector<std::vector<int>> &distances, const ExecutionContext &context) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("MS-BFS");
+    const auto &matrix = g.getAdjacencyMatrix();
+    int V = g.getVertexNum();
+    return multiSourceBatches(V, sources, distances, context, [&](int u, uint64_t mask, std::vector<uint64_t> &next) {
+        const auto &row = matrix[u];
+        for (int v = 0; v < V; ++v) {
+            next[v] |= mask & (0 - static_cast<uint64_t>(row[v] != 0)); // Without a branch: half the cells of a dense row are edges
+        }
+        ALGO_STATS_ADD(edgesScanned, V);
+    });
+}
+
+/**
+ * @brief Utility function for Depth-First Search (DFS) to detect cycles in a graph.
+ *
+ * This function helps detect cycles by recursively visiting nodes and tracking their parents.
+ * If a back edge (an edge that points to one of the node's ancestors in the DFS tree) is found,
+ * a cycle exists in the graph. Only edges inside the strongly connected component of v are followed,
+ * since an edge between two components can never be part of a cycle.
+ *
+ * @param g The graph to be checked.
+ * @param v The current vertex being visited.
+ * @param visited A vector tracking which vertices have been visited.
+ * @param onStack A vector tracking which vertices are on the current DFS path (the ancestors of v).
+ * @param parent A vector tracking the parent of each vertex.
+ * @param components The strongly connected component id of every vertex.
+ * @param cycleStart Reference to the starting vertex of the detected cycle.
+ * @param cycleEnd Reference to the ending vertex of the detected cycle.
+ * @return bool Returns true if a cycle is found, false otherwise.
+ */
+template <typename Weight, template <typename> class GraphType>
+bool Algorithms::DFSUtil(const GraphType<Weight> &g, int v, std::vector<bool> &visited, std::vector<bool> &onStack, std::vector<int> &parent, const std::vector<int> &components, int &cycleStart, int &cycleEnd) {
+    ALGO_STATS_DEPTH();
+    ALGO_STATS_ADD(settledVertices, 1);
+    const auto &matrix = g.getAdjacencyMatrix();
+    visited[v] = true;
+    onStack[v] = true;
+
+    for (int i = 0; i < g.getVertexNum(); ++i) {
+        if (matrix[v][i] != 0 && components[i] == components[v]) { // Check for an edge inside the component
+            ALGO_STATS_ADD(edgesScanned, 1);
+            if (!visited[i]) {
+                parent[i] = v;
+                if (DFSUtil(g, i, visited, onStack, parent, components, cycleStart, cycleEnd))
+                    return true;
+            } else if (onStack[i] && i != parent[v]) { // A back edge found (and not the parent)
+                cycleStart = i;
+                cycleEnd = v;
+                return true;
+            }
+        }
+    }
+    onStack[v] = false;
+    return false;
+}
+
+/**
+ * @brief Checks if the graph contains a cycle using Depth-First Search (DFS).
+ *
+ * This function detects cycles in a graph and returns the cycle as a string.
+ * If no cycle is found, it returns "0". The search only starts from components that can hold a cycle:
+ * non-trivial strongly connected components of a directed graph, or components of an undirected graph
+ * where union-find saw an edge close a cycle. The acyclic parts are skipped entirely.
+ *
+ * @param g The graph to be checked.
+ * @return std::string The cycle in the graph as a string in the format "0->1->2". Returns "0" if no cycle is found.
+ */
+template <typename Weight, template <typename> class GraphType>
+std::string Algorithms::isContainsCycle(const GraphType<Weight> &g) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    AlgorithmWorkspace ws;
+    return isContainsCycle(g, ws);
+}
+
+/**
+ * @brief Checks if the graph contains a cycle like isContainsCycle above, using the scratch memory of a workspace.
+ *
+ * The DFS state, the union-find arrays of undirected graphs and the result are kept in the workspace.
+ * The strongly connected components of a directed graph are still computed into fresh vectors.
+ *
+ * @param g The graph to be checked.
+ * @param ws The workspace holding the search state and the result.
+ * @return const std::string& The result of the query, stored in ws and valid until its next use.
+ */
+template <typename Weight, template <typename> class GraphType>
+const std::string &Algorithms::isContainsCycle(const GraphType<Weight> &g, AlgorithmWorkspace &ws) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    int V = g.getVertexNum();
+    if (g.getIsDirected()) {
+        Kernels::cycleComponentsKernel(g, ws, Directed());
+    } else {
+        Kernels::cycleComponentsKernel(g, ws, Undirected());
+    }
+    ALGO_STATS_ENGINE("DFS");
+    ws.visitedFlags.assign(V, false);
+    ws.onStackFlags.assign(V, false);
+    ws.parents.assign(V, -1);
+    int cycleStart = -1, cycleEnd = -1;
+
+    for (int i = 0; i < V; i++) {
+        if (ws.cyclic[ws.components[i]] && !ws.visitedFlags[i] &&
+            DFSUtil(g, i, ws.visitedFlags, ws.onStackFlags, ws.parents, ws.components, cycleStart, cycleEnd))
+            break;
+    }
+
+    std::string &result = ws.result;
+    result.clear();
+    if (cycleStart == -1) {
+        result = "0";
+        return result;
+    }
+
+    std::vector<int> &cycle = ws.path;
+    cycle.clear();
+    for (int v = cycleEnd; v != cycleStart; v = ws.parents[v]) {
+        cycle.push_back(v);
+    }
+    cycle.push_back(cycleStart);
+    cycle.push_back(cycleEnd);  // Add the starting point to complete the cycle
+
+    // Print the reversed cycle
+    TRACE_SPAN("string formatting");
+    result = "The cycle is: ";
+    for (size_t i = cycle.size(); i-- > 0;) {
+        appendInt(result, cycle[i]);
+        if (i > 0) {
+            result += "->";
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Utility function for Breadth-First Search (BFS) to check if the graph is bipartite.
+ *
+ * This function checks if a graph can be colored with two colors such that no two adjacent vertices
+ * share the same color, indicating that the graph is bipartite.
+ *
+ * @param g The graph to be checked.
+ * @param src The source vertex from which BFS starts.
+ * @param colors A vector tracking the color assigned to each vertex.
+ * @param setA A vector tracking the vertices in set A of the bipartite graph.
+ * @param setB A vector tracking the vertices in set B of the bipartite graph.
+ * @return bool Returns true if the graph is bipartite, false otherwise.
+ */
+template <typename Weight, template <typename> class GraphType>
+bool Algorithms::BFSUtil(const GraphType<Weight> &g, int src, std::vector<int> &colors, std::vector<int> &setA, std::vector<int> &setB) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("BFS");
+    std::queue<int> q;
+    q.push(src);
+    colors[src] = 1; // Start coloring the source vertex with color 1
+    setA.push_back(src); // Add to set A
+
+    while (!q.empty()) {
+        int u = q.front();
+        q.pop();
+        ALGO_STATS_ADD(settledVertices, 1);
+
+        for (int v = 0; v < g.getVertexNum(); ++v) {
+            if (g.getAdjacencyMatrix()[u][v] != 0) { // There is an edge from u to v
+                ALGO_STATS_ADD(edgesScanned, 1);
+                if (colors[v] == -1) { // If vertex v is not colored
+                    colors[v] = 1 - colors[u]; // Assign an alternate color to v
+                    q.push(v);
+                    if (colors[v] == 1) {
+                        setA.push_back(v);
+                    } else {
+                        setB.push_back(v);
+                    }
+                } else if (colors[v] == colors[u]) { // If vertex u and v have the same color
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Two-colors the component of src like BFSUtil above, with the colors, queue and sets kept in a workspace.
+ *
+ * @param g The graph to be checked.
+ * @param src The source vertex from which BFS starts.
+ * @param ws The workspace whose colors, setA and setB are filled.
+ * @return bool Returns true if the component of src is bipartite, false otherwise.
+ */
+template <typename Weight, template <typename> class GraphType>
+bool Algorithms::BFSUtil(const GraphType<Weight> &g, int src, AlgorithmWorkspace &ws) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("BFS");
+    const auto &matrix = g.getAdjacencyMatrix();
+    ws.queue.clear();
+    ws.queue.push_back(src);
+    ws.colors.set(src, 1); // Start coloring the source vertex with color 1
+    ws.setA.push_back(src); // Add to set A
+
+    for (size_t head = 0; head < ws.queue.size(); ++head) {
+        int u = ws.queue[head];
+        int color = ws.colors.get(u);
+        ALGO_STATS_ADD(settledVertices, 1);
+
+        for (int v = 0; v < g.getVertexNum(); ++v) {
+            if (matrix[u][v] != 0) { // There is an edge from u to v
+                ALGO_STATS_ADD(edgesScanned, 1);
+                int neighbourColor = ws.colors.get(v);
+                if (neighbourColor == -1) { // If vertex v is not colored
+                    ws.colors.set(v, 1 - color); // Assign an alternate color to v
+                    ws.queue.push_back(v);
+                    if (color == 0) {
+                        ws.setA.push_back(v);
+                    } else {
+                        ws.setB.push_back(v);
+                    }
+                } else if (neighbourColor == color) { // If vertex u and v have the same color
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks if the graph is bipartite using Breadth-First Search (BFS).
+ *
+ * This function determines if a graph is bipartite by trying to color it with two colors.
+ * It returns the sets A and B of the bipartite graph if it is bipartite, or "0" if it is not.
+ *
+ * @param g The graph to be checked.
+ * @return std::string A string representation of the bipartite sets A and B. Returns "0" if the graph is not bipartite.
+ */
+template <typename Weight, template <typename> class GraphType>
+std::string Algorithms::isBipartite(const GraphType<Weight> &g) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    AlgorithmWorkspace ws;
+    return isBipartite(g, ws);
+}
+
+/**
+ * @brief Checks if the graph is bipartite like isBipartite above, using the scratch memory of a workspace.
+ *
+ * @param g The graph to be checked.
+ * @param ws The workspace holding the coloring and the result.
+ * @return const std::string& The result of the query, stored in ws and valid until its next use.
+ */
+template <typename Weight, template <typename> class GraphType>
+const std::string &Algorithms::isBipartite(const GraphType<Weight> &g, AlgorithmWorkspace &ws) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    std::string &result = ws.result;
+    ws.colors.reset(g.getVertexNum(), -1); // Initialize all vertices as not colored
+    ws.setA.clear();
+    ws.setB.clear();
+
+    for (int i = 0; i < g.getVertexNum(); ++i) {
+        if (ws.colors.get(i) == -1) { // If the vertex is not colored
+            if (!BFSUtil(g, i, ws)) {
+                result = "0";
+                return result;
+            }
+        }
+    }
+
+    TRACE_SPAN("string formatting");
+    result = "The graph is bipartite: A={";
+    for (size_t i = 0; i < ws.setA.size(); ++i) {
+        appendInt(result, ws.setA[i]);
+        if (i < ws.setA.size() - 1) {
+            result += ", ";
+        }
+    }
+    result += "}, B={";
+    for (size_t i = 0; i < ws.setB.size(); ++i) {
+        appendInt(result, ws.setB[i]);
+        if (i < ws.setB.size() - 1) {
+            result += ", ";
+        }
+    }
+    result += "}";
+    return result;
+}
+
+/**
+ * @brief Finds a maximum matching and a minimum vertex cover of a bipartite graph with Hopcroft-Karp.
+ *
+ * The sides come from the BFSUtil coloring used by isBipartite (side A, color 1, is the left side), and edges are
+ * taken in both directions. Every phase builds the BFS layers from the free left vertices up to the shortest
+ * augmenting length, then augments along vertex-disjoint shortest paths with an iterative DFS, so the matching is
+ * found in O(E sqrt(V)) after the O(V^2) pass over the matrix. The cover follows from König's theorem: the left
+ * vertices not reachable from a free left vertex by alternating paths, plus the right vertices that are.
+ *
+ * @param g The graph.
+ * @param matching Set to the matched (A vertex, B vertex) pairs, ordered by A vertex.
+ * @param vertexCover Set to a minimum vertex cover, in increasing order; it has one vertex per matched pair.
+ * @return bool Returns false (and leaves both empty) if the graph is not bipartite, exactly when isBipartite returns "0".
+ */
+template <typename Weight, template <typename> class GraphType>
+bool Algorithms::maximumMatching(const GraphType<Weight> &g, std::vector<std::pair<int, int>> &matching, std::vector<int> &vertexCover) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("HopcroftKarp");
+    int V = g.getVertexNum();
+    matching.clear();
+    vertexCover.clear();
+
+    AlgorithmWorkspace ws;
+    ws.colors.reset(V, -1);
+    for (int i = 0; i < V; ++i) {
+        if (ws.colors.get(i) == -1 && !BFSUtil(g, i, ws)) {
+            return false;
+        }
+    }
+
+    // Adjacency of the left vertices in CSR form; BFSUtil has checked every edge joins the two sides
+    const auto &matrix = g.getAdjacencyMatrix();
+    std::vector<int> left;
+    std::vector<int> offsets(1, 0);
+    std::vector<int> targets;
+    for (int u = 0; u < V; ++u) {
+        if (ws.colors.get(u) != 1) {
+            continue;
+        }
+        left.push_back(u);
+        for (int v = 0; v < V; ++v) {
+            if (v != u && (matrix[u][v] != 0 || matrix[v][u] != 0)) {
+                targets.push_back(v);
+            }
+        }
+        offsets.push_back(static_cast<int>(targets.size()));
+    }
+    int L = static_cast<int>(left.size());
+
+    // Left vertices are indexed by their position in left, right vertices by their id
+    const int INF = std::numeric_limits<int>::max();
+    std::vector<int> matchLeft(L, -1);
+    std::vector<int> matchRight(V, -1);
+    std::vector<int> dist(L);
+    std::vector<int> next(L);
+    std::vector<int> queue;
+    std::vector<int> stack;
+    while (true) {
+        TRACE_SPAN("matching phase");
+        // Layers from the free left vertices; freeDist is the length of the shortest augmenting path
+        queue.clear();
+        for (int i = 0; i < L; ++i) {
+            dist[i] = matchLeft[i] == -1 ? 0 : INF;
+            if (dist[i] == 0) {
+                queue.push_back(i);
+            }
+        }
+        int freeDist = INF;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int i = queue[head];
+            if (dist[i] >= freeDist) {
+                continue;
+            }
+            for (int k = offsets[i]; k < offsets[i + 1]; ++k) {
+                ALGO_STATS_ADD(edgesScanned, 1);
+                int w = matchRight[targets[k]];
+                if (w == -1) {
+                    freeDist = std::min(freeDist, dist[i] + 1);
+                } else if (dist[w] == INF) {
+                    dist[w] = dist[i] + 1;
+                    queue.push_back(w);
+                }
+            }
+        }
+        if (freeDist == INF) {
+            break;
+        }
+
+        // Vertex-disjoint shortest augmenting paths; a dead end gets dist INF so no later path enters it
+        for (int i = 0; i < L; ++i) {
+            next[i] = offsets[i];
+        }
+        for (int root = 0; root < L; ++root) {
+            if (matchLeft[root] != -1) {
+                continue;
+            }
+            stack.assign(1, root);
+            while (!stack.empty()) {
+                int i = stack.back();
+                if (next[i] == offsets[i + 1]) {
+                    dist[i] = INF;
+                    stack.pop_back();
+                    continue;
+                }
+                int v = targets[next[i]];
+                int w = matchRight[v];
+                if (w == -1 && dist[i] + 1 == freeDist) {
+                    for (int j : stack) {
+                        int u = targets[next[j]];
+                        matchLeft[j] = u;
+                        matchRight[u] = j;
+                    }
+                    break;
+                }
+                if (w != -1 && dist[w] == dist[i] + 1) {
+                    stack.push_back(w);
+                } else {
+                    next[i]++;
+                }
+            }
+        }
+    }
+
+    // König: Z holds the vertices reachable from the free left vertices along alternating paths
+    std::vector<char> reachedLeft(L, false);
+    std::vector<char> reachedRight(V, false);
+    queue.clear();
+    for (int i = 0; i < L; ++i) {
+        if (matchLeft[i] == -1) {
+            reachedLeft[i] = true;
+            queue.push_back(i);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int i = queue[head];
+        for (int k = offsets[i]; k < offsets[i + 1]; ++k) {
+            int v = targets[k];
+            if (!reachedRight[v]) {
+                reachedRight[v] = true;
+                int w = matchRight[v];
+                if (w != -1 && !reachedLeft[w]) {
+                    reachedLeft[w] = true;
+                    queue.push_back(w);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < L; ++i) {
+        if (matchLeft[i] != -1) {
+            matching.push_back(std::make_pair(left[i], matchLeft[i]));
+        }
+        if (!reachedLeft[i]) {
+            vertexCover.push_back(left[i]);
+        }
+    }
+    for (int v = 0; v < V; ++v) {
+        if (reachedRight[v]) {
+            vertexCover.push_back(v);
+        }
+    }
+    std::sort(vertexCover.begin(), vertexCover.end());
+    return true;
+}
+
+/**
+ * @brief Finds a minimum spanning forest, with the engine chosen by density.
+ *
+ * Dense graphs go to PrimMSF, whose O(V^2) scans match the adjacency matrix. Sparse graphs, with fewer than
+ * V^2 / (2 log2 V) edges, go to BoruvkaMSF, which reads the matrix once and then works on adjacency lists.
+ * Both return the same forest. It has one tree per connected component, so it spans the graph (V - 1 edges) exactly
+ * when isConnected returns 1.
+ *
+ * @param g The graph, which must be undirected.
+ * @param edges Set to the edges of the forest as (u, v) pairs with u < v, in increasing order.
+ * @param totalWeight Set to the sum of the weights of the edges.
+ * @param context The pool BoruvkaMSF may run on and the most workers to use.
+ * @return bool Returns false (and leaves edges empty) if the graph is directed.
+ */
+template <typename Weight, template <typename> class GraphType>
+bool Algorithms::minimumSpanningForest(const GraphType<Weight> &g, std::vector<std::pair<int, int>> &edges, typename WeightTraits<Weight>::Distance &totalWeight, const ExecutionContext &context) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    double V = g.getVertexNum();
+    if (V > 2 && 2.0 * g.getEdgesNum() * std::log2(V) < V * V) {
+        return BoruvkaMSF(g, edges, totalWeight, context);
+    }
+    return PrimMSF(g, edges, totalWeight);
+}
+
+/**
+ * @brief Finds a minimum spanning forest with the array-based version of Prim's algorithm in O(V^2).
+ *
+ * Every tree grows from its smallest vertex; each step takes the cheapest edge into the tree by scanning the key
+ * array, then relaxes the row of the new vertex.
+ *
+ * @param g The graph, which must be undirected.
+ * @param edges Set to the edges of the forest as (u, v) pairs with u < v, in increasing order.
+ * @param totalWeight Set to the sum of the weights of the edges.
+ * @return bool Returns false (and leaves edges empty) if the graph is directed.
+ */
+template <typename Weight, template <typename> class GraphType>
+bool Algorithms::PrimMSF(const GraphType<Weight> &g, std::vector<std::pair<int, int>> &edges, typename WeightTraits<Weight>::Distance &totalWeight) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("Prim");
+    edges.clear();
+    totalWeight = 0;
+    if (g.getIsDirected()) {
+        return false;
+    }
+    int V = g.getVertexNum();
+    const auto &matrix = g.getAdjacencyMatrix();
+    std::vector<Weight> key(V);
+    std::vector<int> from(V, -1); // The tree end of the cheapest edge into the tree, -1 if there is none yet
+    std::vector<char> inTree(V, false);
+
+    for (int root = 0; root < V; ++root) {
+        if (inTree[root]) {
+            continue;
+        }
+        int u = root;
+        while (u != -1) {
+            inTree[u] = true;
+            ALGO_STATS_ADD(settledVertices, 1);
+            if (from[u] != -1) {
+                edges.push_back(std::make_pair(std::min(u, from[u]), std::max(u, from[u])));
+                totalWeight += key[u];
+            }
+
+            const auto &row = matrix[u];
+            for (int v = 0; v < V; ++v) {
+                if (row[v] != 0 && !inTree[v]) {
+                    ALGO_STATS_ADD(edgesScanned, 1);
+                    if (from[v] == -1 || lighterEdge(row[v], u, v, key[v], from[v], v)) {
+                        key[v] = row[v];
+                        from[v] = u;
+                    }
+                }
+            }
+
+            u = -1;
+            for (int v = 0; v < V; ++v) {
+                if (!inTree[v] && from[v] != -1 && (u == -1 || lighterEdge(key[v], from[v], v, key[u], from[u], u))) {
+                    u = v;
+                }
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    return true;
+}
+
+/**
+ * @brief Finds a minimum spanning forest with Borůvka's algorithm, in parallel on the pool of the context.
+ *
+ * The matrix is read once into adjacency lists, split by rows over the pool. Every round the lanes find the
+ * cheapest edge out of the component of every vertex (dropping the list entries that became internal), the
+ * components keep their cheapest edge, and the chosen edges are merged with union-find. Each round at least halves
+ * the number of components, so it takes O(E log V) work after the O(V^2) read.
+ *
+ * @param g The graph, which must be undirected.
+ * @param edges Set to the edges of the forest as (u, v) pairs with u < v, in increasing order.
+ * @param totalWeight Set to the sum of the weights of the edges.
+ * @param context The pool to run on and the most workers to use.
+ * @return bool Returns false (and leaves edges empty) if the graph is directed.
+ */
+template <typename Weight, template <typename> class GraphType>
+bool Algorithms::BoruvkaMSF(const GraphType<Weight> &g, std::vector<std::pair<int, int>> &edges, typename WeightTraits<Weight>::Distance &totalWeight, const ExecutionContext &context) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    ALGO_STATS_ENGINE("Boruvka");
+    edges.clear();
+    totalWeight = 0;
+    if (g.getIsDirected()) {
+        return false;
+    }
+    int V = g.getVertexNum();
+    const auto &matrix = g.getAdjacencyMatrix();
+    auto forVertices = [&](const std::function<void(int, int, int)> &body) {
+        if (context.pool == nullptr) {
+            body(0, 0, V);
+        } else {
+            context.pool->parallelFor(0, V, 64, body, context.maxParallelism);
+        }
+    };
+
+    std::vector<std::vector<int>> neighbours(V);
+    forVertices([&](int, int begin, int end) {
+        for (int u = begin; u < end; ++u) {
+            for (int v = 0; v < V; ++v) {
+                if (v != u && matrix[u][v] != 0) {
+                    neighbours[u].push_back(v);
+                }
+            }
+        }
+    });
+
+    std::vector<int> root(V);
+    std::vector<int> component(V);
+    for (int v = 0; v < V; ++v) {
+        root[v] = component[v] = v;
+    }
+    std::vector<int> cheapest(V);      // The cheapest edge out of the component of a vertex, from that vertex
+    std::vector<int> componentEdge(V); // The vertex holding the cheapest edge out of a component
+    while (true) {
+        TRACE_SPAN("Boruvka round");
+        ALGO_STATS_ADD(relaxationPasses, 1);
+        forVertices([&](int, int begin, int end) {
+            for (int u = begin; u < end; ++u) {
+                std::vector<int> &list = neighbours[u];
+                int best = -1;
+                size_t kept = 0;
+                for (size_t k = 0; k < list.size(); ++k) {
+                    int v = list[k];
+                    if (component[v] == component[u]) {
+                        continue;
+                    }
+                    list[kept++] = v;
+                    if (best == -1 || lighterEdge(matrix[u][v], u, v, matrix[u][best], u, best)) {
+                        best = v;
+                    }
+                }
+                ALGO_STATS_ADD(edgesScanned, list.size());
+                list.resize(kept);
+                cheapest[u] = best;
+            }
+        });
+
+        std::fill(componentEdge.begin(), componentEdge.end(), -1);
+        for (int u = 0; u < V; ++u) {
+            int v = cheapest[u];
+            int c = component[u];
+            if (v != -1) {
+                int w = componentEdge[c];
+                if (w == -1 || lighterEdge(matrix[u][v], u, v, matrix[w][cheapest[w]], w, cheapest[w])) {
+                    componentEdge[c] = u;
+                }
+            }
+        }
+
+        size_t added = edges.size();
+        for (int c = 0; c < V; ++c) {
+            int u = componentEdge[c];
+            if (u == -1) {
+                continue;
+            }
+            int v = cheapest[u];
+            int a = findRoot(root, u);
+            int b = findRoot(root, v);
+            if (a != b) { // Two components choosing the same edge add it once
+                root[a] = b;
+                edges.push_back(std::make_pair(std::min(u, v), std::max(u, v)));
+                totalWeight += matrix[u][v];
+            }
+        }
+        if (edges.size() == added) {
+            break;
+        }
+        for (int v = 0; v < V; ++v) {
+            component[v] = findRoot(root, v);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    return true;
+}
+
+/**
+ * @brief Checks for the presence of negative weight cycles using the Bellman-Ford algorithm.
+ *
+ * This function detects negative weight cycles in a graph. If such a cycle is found, it returns the cycle as a string.
+ * If no cycle is found, it returns "0".
+ *
+ * @param g The graph to be checked.
+ * @return std::string The negative weight cycle in the graph as a string in the format "0->1->2". Returns "0" if no cycle is found.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+std::string Algorithms::negativeCycle(const GraphType<Weight> &g) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    std::vector<int> cycle;
+    if (!negativeCycle<Weight, Distance>(g, cycle)) {
+        return "0";
+    }
+
+    TRACE_SPAN("string formatting");
+    std::string result = "The negative weight cycle is: ";
+    for (size_t i = 0; i < cycle.size(); ++i) {
+        appendInt(result, cycle[i]);
+        if (i < cycle.size() - 1) {
+            result += "->";
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Finds a negative weight cycle like negativeCycle above, as a list of vertices.
+ *
+ * A cycle lies entirely inside one strongly connected component and must contain a negative edge, so Bellman-Ford
+ * is only run on the non-trivial components that contain a negative edge, starting from their smallest vertex.
+ *
+ * @param g The graph to be checked.
+ * @param cycle Set to the vertices of the cycle in order, the first vertex repeated at the end.
+ * @return bool Returns true if a negative weight cycle was found, false otherwise.
+ */
+template <typename Weight, typename Distance, template <typename> class GraphType>
+bool Algorithms::negativeCycle(const GraphType<Weight> &g, std::vector<int> &cycle) {
+    ALGO_STATS_CALL();
+    TRACE_SPAN(__func__);
+    int V = g.getVertexNum();
+    const Distance INF = infiniteDistance<Distance>();
+    const auto &matrix = g.getAdjacencyMatrix();
+
+    cycle.clear();
+    if (isContainsCycle(g) == "0") {
+        return false;
+    }
+
+    int componentNum = 0;
+    std::vector<int> components = stronglyConnectedComponents(g, componentNum);
+    std::vector<bool> cyclic = cyclicComponents(g, components, componentNum);
+    ALGO_STATS_ENGINE("BellmanFord");
+    std::vector<std::vector<int>> members(componentNum);
+    std::vector<bool> hasNegEdge(componentNum, false);
+    for (int u = 0; u < V; ++u) {
+        members[components[u]].push_back(u);
+        for (int v = 0; v < V; ++v) {
+            if (matrix[u][v] < 0 && components[u] == components[v]) {
+                hasNegEdge[components[u]] = true;
+            }
+        }
+    }
+
+    std::vector<Distance> dist(V, INF);
+    std::vector<int> parent(V, -1);
+    std::vector<bool> checked(componentNum, false);
+
+    for (int s = 0; s < V; ++s) {
+        int c = components[s];
+        if (checked[c] || !cyclic[c] || !hasNegEdge[c]) {
+            continue;
+        }
+        checked[c] = true;
+        const std::vector<int> &vertices = members[c];
+        dist[s] = 0;
+
+        // Relax the edges of the component
+        relaxEdges(g, vertices, dist, parent);
+
+        // Check for negative weight cycles
+        TRACE_SPAN("negative-cycle check");
+        for (int u : vertices) {
+            for (int v : vertices) {
+                if (matrix[u][v] != 0 && dist[u] != INF && addDistance(dist[u], matrix[u][v]) < dist[v]) {
+                    std::vector<bool> visited(V, false);
+
+                    // To find the cycle, we follow the parent links until we find a cycle
+                    int cycleVertex = v;
+                    while (!visited[cycleVertex]) {
+                        visited[cycleVertex] = true;
+                        cycleVertex = parent[cycleVertex];
+                    }
+
+                    int startVertex = cycleVertex;
+                    cycle.push_back(startVertex);
+                    for (int cur = parent[startVertex]; cur != startVertex; cur = parent[cur]) {
+                        cycle.push_back(cur);
+                    }
+                    cycle.push_back(startVertex);
+
+                    std::reverse(cycle.begin(), cycle.end());
+
+                    // Check the cycle size for undirected graphs
+                    if (cycle.size() < 4) {
+                        cycle.clear();
+                        return false;
+                    }
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+
+#define INSTANTIATE_DISTANCE_ALGORITHMS(GraphType, Weight, Distance) \
+    template std::string Algorithms::shortestPath<Weight, Distance>(const GraphType<Weight> &, int, int); \
+    template std::string Algorithms::negativeCycle<Weight, Distance>(const GraphType<Weight> &); \
+    template bool Algorithms::negativeCycle<Weight, Distance>(const GraphType<Weight> &, std::vector<int> &); \
+    template std::string Algorithms::DijkstraShortestPath<Weight, Distance>(const GraphType<Weight> &, int, int); \
+    template std::string Algorithms::BellmanFordShortestPath<Weight, Distance>(const GraphType<Weight> &, int, int); \
+    template void Algorithms::relaxEdges(const GraphType<Weight> &, std::vector<Distance> &, std::vector<int> &); \
+    template void Algorithms::relaxEdges(const GraphType<Weight> &, const std::vector<int> &, std::vector<Distance> &, std::vector<int> &); \
+    template void Algorithms::DAGRelaxEdges(const GraphType<Weight> &, const std::vector<int> &, int, std::vector<Distance> &, std::vector<int> &, bool); \
+    template std::string Algorithms::DAGPath<Weight, Distance>(const GraphType<Weight> &, const std::vector<int> &, int, int, bool); \
+    template std::string Algorithms::DAGShortestPath<Weight, Distance>(const GraphType<Weight> &, int, int); \
+    template std::string Algorithms::DAGLongestPath<Weight, Distance>(const GraphType<Weight> &, int, int); \
+    template const std::string &Algorithms::shortestPath<Weight, Distance>(const GraphType<Weight> &, int, int, AlgorithmWorkspace &); \
+    template std::vector<std::string> Algorithms::shortestPaths<Weight, Distance>(const GraphType<Weight> &, const std::vector<std::pair<int, int>> &, const ExecutionContext &); \
+    template const std::string &Algorithms::DijkstraShortestPath<Weight, Distance>(const GraphType<Weight> &, int, int, AlgorithmWorkspace &); \
+    template const std::string &Algorithms::BellmanFordShortestPath<Weight, Distance>(const GraphType<Weight> &, int, int, AlgorithmWorkspace &); \
+    template const std::string &Algorithms::DAGPath<Weight, Distance>(const GraphType<Weight> &, const std::vector<int> &, int, int, bool, AlgorithmWorkspace &);
+
+#define INSTANTIATE_ALGORITHMS(GraphType, Weight) \
+    template int Algorithms::isConnected(const GraphType<Weight> &); \
+    template std::string Algorithms::isContainsCycle(const GraphType<Weight> &); \
+    template std::string Algorithms::isBipartite(const GraphType<Weight> &); \
+    template void Algorithms::DFS(const GraphType<Weight> &, int, std::vector<bool> &); \
+    template std::string Algorithms::BFSShortestPath(const GraphType<Weight> &, int, int); \
+    template std::vector<int> Algorithms::stronglyConnectedComponents(const GraphType<Weight> &, int &); \
+    template std::vector<bool> Algorithms::cyclicComponents(const GraphType<Weight> &, const std::vector<int> &, int); \
+    template Graph Algorithms::condensationGraph(const GraphType<Weight> &, const std::vector<int> &, int); \
+    template bool Algorithms::topologicalSort(const GraphType<Weight> &, std::vector<int> &); \
+    template bool Algorithms::multiSourceBFS(const GraphType<Weight> &, const std::vector<int> &, std::vector<std::vector<int>> &, const ExecutionContext &); \
+    template const std::string &Algorithms::isContainsCycle(const GraphType<Weight> &, AlgorithmWorkspace &); \
+    template const std::string &Algorithms::isBipartite(const GraphType<Weight> &, AlgorithmWorkspace &); \
+    template const std::string &Algorithms::BFSShortestPath(const GraphType<Weight> &, int, int, AlgorithmWorkspace &); \
+    template bool Algorithms::BFSUtil(const GraphType<Weight> &, int, AlgorithmWorkspace &); \
+    template bool Algorithms::maximumMatching(const GraphType<Weight> &, std::vector<std::pair<int, int>> &, std::vector<int> &); \
+    template bool Algorithms::minimumSpanningForest(const GraphType<Weight> &, std::vector<std::pair<int, int>> &, WeightTraits<Weight>::Distance &, const ExecutionContext &); \
+    template bool Algorithms::PrimMSF(const GraphType<Weight> &, std::vector<std::pair<int, int>> &, WeightTraits<Weight>::Distance &); \
+    template bool Algorithms::BoruvkaMSF(const GraphType<Weight> &, std::vector<std::pair<int, int>> &, WeightTraits<Weight>::Distance &, const ExecutionContext &); \
+    template bool Algorithms::topologicalSort(const GraphType<Weight> &, std::vector<int> &, AlgorithmWorkspace &); \
+    INSTANTIATE_DISTANCE_ALGORITHMS(GraphType, Weight, WeightTraits<Weight>::Distance)
+
+INSTANTIATE_ALGORITHMS(BasicGraph, int8_t)
+INSTANTIATE_ALGORITHMS(BasicGraph, int16_t)
+INSTANTIATE_ALGORITHMS(BasicGraph, int)
+INSTANTIATE_ALGORITHMS(BasicGraph, int64_t)
+INSTANTIATE_ALGORITHMS(BasicGraph, float)
+INSTANTIATE_ALGORITHMS(BasicGraph, double)
+INSTANTIATE_ALGORITHMS(BasicGraphView, int8_t)
+INSTANTIATE_ALGORITHMS(BasicGraphView, int16_t)
+INSTANTIATE_ALGORITHMS(BasicGraphView, int)
+INSTANTIATE_ALGORITHMS(BasicGraphView, int64_t)
+INSTANTIATE_ALGORITHMS(BasicGraphView, float)
+INSTANTIATE_ALGORITHMS(BasicGraphView, double)
+
+// The other distance types documented in Algorithms.hpp, for integer weights
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraph, int8_t, int)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraph, int8_t, long)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraph, int8_t, double)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraph, int16_t, int)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraph, int16_t, long)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraph, int16_t, double)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraph, int, int)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraph, int, long)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraph, int, double)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraph, int64_t, long)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraph, int64_t, double)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraphView, int8_t, int)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraphView, int8_t, long)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraphView, int8_t, double)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraphView, int16_t, int)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraphView, int16_t, long)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraphView, int16_t, double)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraphView, int, int)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraphView, int, long)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraphView, int, double)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraphView, int64_t, long)
+INSTANTIATE_DISTANCE_ALGORITHMS(BasicGraphView, int64_t, double)
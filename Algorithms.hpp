@@ -1,20 +1,69 @@
-//mail: guyes134@gmail.com
-
-#pragma once
-#include "Graph.hpp"
-#include <string>
-
-namespace Algorithms{
-    int isConnected(const Graph &g);
-    std::string shortestPath(const Graph &g, int start, int end);
-    std::string isContainsCycle(const Graph &g);
-    std::string isBipartite(const Graph &g);
-    std::string negativeCycle(const Graph &g);
-    void DFS(Graph g, int v, std::vector<bool> &visited);
-    std::string BFSShortestPath(const Graph &g, int start, int end);
-    std::string DijkstraShortestPath(const Graph &g, int start, int end);
-    std::string BellmanFordShortestPath(const Graph &g, int start, int end);
-    bool BFSUtil(const Graph &g, int src, std::vector<int> &colors, std::vector<int> &setA, std::vector<int> &setB);
-    bool DFSUtil(const Graph &g, int v, std::vector<bool> &visited, std::vector<int> &parent, int &cycleStart, int &cycleEnd);
-    void relaxEdges(const Graph &g, std::vector<int> &dist, std::vector<int> &parent);
-}
+//mail: guyes134@gmail.com
+
+#pragma once
+#include "Graph.hpp"
+#include "GraphView.hpp"
+#include "CompressedGraph.hpp"
+#include "AlgorithmWorkspace.hpp"
+#include "ThreadPool.hpp"
+#include <string>
+#include <utility>
+
+/**
+ * Every function taking a graph is a template on its weight type, instantiated in Algorithms.cpp for
+ * int8_t, int16_t, int, int64_t, float and double, and on its graph type: a BasicGraph or a filtered BasicGraphView.
+ * Path lengths are accumulated in a separate Distance type, by default the wide type from WeightTraits
+ * (64-bit integers or double). Integer weights may also be summed in int (except int64_t weights), long (int64_t)
+ * or double, e.g. shortestPath<int, int64_t>(g, 0, 5). A sum that does not fit saturates just below the sentinel of
+ * unreached vertices, so a saturated path is still reported as a path.
+ *
+ * The overloads taking an AlgorithmWorkspace keep all of their scratch memory and their result in it and return
+ * a reference to the result, so a caller reusing one workspace per thread makes queries without heap allocations.
+ *
+ * The overloads taking an ExecutionContext may run on the workers of its ThreadPool, up to its parallelism limit.
+ */
+namespace Algorithms{
+    template <typename Weight, template <typename> class GraphType> int isConnected(const GraphType<Weight> &g);
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> std::string shortestPath(const GraphType<Weight> &g, int start, int end);
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> const std::string &shortestPath(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws);
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> std::vector<std::string> shortestPaths(const GraphType<Weight> &g, const std::vector<std::pair<int, int>> &queries, const ExecutionContext &context = ExecutionContext());
+    template <typename Weight, template <typename> class GraphType> bool multiSourceBFS(const GraphType<Weight> &g, const std::vector<int> &sources, std::vector<std::vector<int>> &distances, const ExecutionContext &context = ExecutionContext());
+    template <typename Weight, template <typename> class GraphType> std::string isContainsCycle(const GraphType<Weight> &g);
+    template <typename Weight, template <typename> class GraphType> const std::string &isContainsCycle(const GraphType<Weight> &g, AlgorithmWorkspace &ws);
+    template <typename Weight, template <typename> class GraphType> std::string isBipartite(const GraphType<Weight> &g);
+    template <typename Weight, template <typename> class GraphType> const std::string &isBipartite(const GraphType<Weight> &g, AlgorithmWorkspace &ws);
+    template <typename Weight, template <typename> class GraphType> bool maximumMatching(const GraphType<Weight> &g, std::vector<std::pair<int, int>> &matching, std::vector<int> &vertexCover);
+    template <typename Weight, template <typename> class GraphType> bool minimumSpanningForest(const GraphType<Weight> &g, std::vector<std::pair<int, int>> &edges, typename WeightTraits<Weight>::Distance &totalWeight, const ExecutionContext &context = ExecutionContext());
+    template <typename Weight, template <typename> class GraphType> bool PrimMSF(const GraphType<Weight> &g, std::vector<std::pair<int, int>> &edges, typename WeightTraits<Weight>::Distance &totalWeight);
+    template <typename Weight, template <typename> class GraphType> bool BoruvkaMSF(const GraphType<Weight> &g, std::vector<std::pair<int, int>> &edges, typename WeightTraits<Weight>::Distance &totalWeight, const ExecutionContext &context = ExecutionContext());
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> std::string negativeCycle(const GraphType<Weight> &g);
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> bool negativeCycle(const GraphType<Weight> &g, std::vector<int> &cycle);
+    template <typename Weight, template <typename> class GraphType> void DFS(const GraphType<Weight> &g, int v, std::vector<bool> &visited);
+    template <typename Weight, template <typename> class GraphType> std::string BFSShortestPath(const GraphType<Weight> &g, int start, int end);
+    template <typename Weight, template <typename> class GraphType> const std::string &BFSShortestPath(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws);
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> std::string DijkstraShortestPath(const GraphType<Weight> &g, int start, int end);
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> const std::string &DijkstraShortestPath(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws);
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> std::string BellmanFordShortestPath(const GraphType<Weight> &g, int start, int end);
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> const std::string &BellmanFordShortestPath(const GraphType<Weight> &g, int start, int end, AlgorithmWorkspace &ws);
+    template <typename Weight, template <typename> class GraphType> bool BFSUtil(const GraphType<Weight> &g, int src, std::vector<int> &colors, std::vector<int> &setA, std::vector<int> &setB);
+    template <typename Weight, template <typename> class GraphType> bool BFSUtil(const GraphType<Weight> &g, int src, AlgorithmWorkspace &ws);
+    template <typename Weight, template <typename> class GraphType> bool DFSUtil(const GraphType<Weight> &g, int v, std::vector<bool> &visited, std::vector<bool> &onStack, std::vector<int> &parent, const std::vector<int> &components, int &cycleStart, int &cycleEnd);
+    template <typename Weight, typename Distance, template <typename> class GraphType> void relaxEdges(const GraphType<Weight> &g, std::vector<Distance> &dist, std::vector<int> &parent);
+    template <typename Weight, typename Distance, template <typename> class GraphType> void relaxEdges(const GraphType<Weight> &g, const std::vector<int> &vertices, std::vector<Distance> &dist, std::vector<int> &parent);
+    template <typename Weight, template <typename> class GraphType> std::vector<int> stronglyConnectedComponents(const GraphType<Weight> &g, int &componentNum);
+    template <typename Weight, template <typename> class GraphType> std::vector<bool> cyclicComponents(const GraphType<Weight> &g, const std::vector<int> &components, int componentNum);
+    template <typename Weight, template <typename> class GraphType> Graph condensationGraph(const GraphType<Weight> &g, const std::vector<int> &components, int componentNum);
+    template <typename Weight, template <typename> class GraphType> bool topologicalSort(const GraphType<Weight> &g, std::vector<int> &order);
+    template <typename Weight, template <typename> class GraphType> bool topologicalSort(const GraphType<Weight> &g, std::vector<int> &order, AlgorithmWorkspace &ws);
+    template <typename Weight, typename Distance, template <typename> class GraphType> void DAGRelaxEdges(const GraphType<Weight> &g, const std::vector<int> &order, int start, std::vector<Distance> &dist, std::vector<int> &parent, bool longest);
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> std::string DAGPath(const GraphType<Weight> &g, const std::vector<int> &order, int start, int end, bool longest);
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> const std::string &DAGPath(const GraphType<Weight> &g, const std::vector<int> &order, int start, int end, bool longest, AlgorithmWorkspace &ws);
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> std::string DAGShortestPath(const GraphType<Weight> &g, int start, int end);
+    template <typename Weight, typename Distance = typename WeightTraits<Weight>::Distance, template <typename> class GraphType> std::string DAGLongestPath(const GraphType<Weight> &g, int start, int end);
+    std::string pathToString(const std::vector<int> &parent, int end);
+    std::string shortestPath(const CompressedGraph &g, int start, int end);
+    std::string BFSShortestPath(const CompressedGraph &g, int start, int end);
+    std::string DijkstraShortestPath(const CompressedGraph &g, int start, int end);
+    std::string BellmanFordShortestPath(const CompressedGraph &g, int start, int end);
+    bool multiSourceBFS(const CompressedGraph &g, const std::vector<int> &sources, std::vector<std::vector<int>> &distances, const ExecutionContext &context = ExecutionContext());
+}
@@ -0,0 +1,302 @@
+//mail: guyes134@gmail.com
+
+#include "Graph.hpp"
+#include "Algorithms.hpp"
+#include "GraphGenerator.hpp"
+#include "GraphReorder.hpp"
+#include "ExternalGraph.hpp"
+#include <sys/resource.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Benchmarks for the Algorithms entry points.
+ *
+ * Every operation is run on two random graph families (dense, edge probability 1/2, and sparse, average degree 8)
+ * at several sizes, and reported as one JSON object or CSV row with the time per call, the edges processed per
+ * second and the peak resident set size of the process so far.
+ * isConnected also runs on an ExternalGraph file of the unweighted graph, with a memory cap of 1/8 of the file
+ * (at least 1 MiB); its edges per second, peak memory and blocks read are reported on stderr.
+ * A third family, a square grid with shuffled vertex ids, compares BFS on a CompressedGraph in the shuffled order
+ * and after reverse Cuthill-McKee, and reports the locality of both orders on stderr.
+ *
+ * Usage: bench_program [--format json|csv] [--sizes 100,1000] [--seed N] [--min-time SECONDS] [--cubic-max N] [--max-memory MIB]
+ */
+
+namespace {
+    struct Options {
+        string format = "json";
+        vector<int> sizes = {100, 300, 1000, 3000};
+        unsigned seed = 1;
+        double minTime = 0.2; // Each operation is repeated until it ran for at least this long
+        int cubicMax = 500; // Bellman-Ford and negativeCycle are O(V^3) on the matrix
+        long long maxMemoryMiB = 2048;
+    };
+
+    struct Result {
+        string family;
+        int vertices;
+        int edges;
+        string op;
+        string engine;
+        long long iterations;
+        double nsPerOp;
+        long peakRssKiB;
+    };
+
+    volatile size_t sink = 0; // Keeps the compiler from dropping the timed calls
+
+    long peakRssKiB() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss; // KiB on Linux
+    }
+
+    /**
+     * @brief Runs op repeatedly until minTime seconds have passed (at least once).
+     *
+     * @return pair<long long, double> The number of calls and the average nanoseconds per call.
+     */
+    pair<long long, double> timeOp(const function<void()> &op, double minTime) {
+        typedef chrono::steady_clock Clock;
+        long long iterations = 0;
+        Clock::time_point begin = Clock::now();
+        double elapsed = 0;
+        do {
+            op();
+            iterations++;
+            elapsed = chrono::duration<double>(Clock::now() - begin).count();
+        } while (elapsed < minTime);
+        return make_pair(iterations, elapsed * 1e9 / static_cast<double>(iterations));
+    }
+
+    /**
+     * @brief A plain queue BFS over the matrix, the baseline that multiSourceBFS runs 64 of at once.
+     */
+    void bfsDistances(const Graph &g, int source, vector<int> &dist) {
+        const vector<vector<int>> &matrix = g.getAdjacencyMatrix();
+        int V = g.getVertexNum();
+        dist.assign(V, -1);
+        vector<int> queue(1, source);
+        dist[source] = 0;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int u = queue[head];
+            for (int v = 0; v < V; ++v) {
+                if (matrix[u][v] != 0 && dist[v] == -1) {
+                    dist[v] = dist[u] + 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+    }
+
+    vector<int> parseSizes(const string &list) {
+        vector<int> sizes;
+        stringstream ss(list);
+        string item;
+        while (getline(ss, item, ',')) {
+            sizes.push_back(stoi(item));
+        }
+        return sizes;
+    }
+
+    Options parseOptions(int argc, char *argv[]) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            if (i + 1 >= argc) {
+                throw invalid_argument("Missing value for " + arg);
+            }
+            string value = argv[++i];
+            if (arg == "--format") {
+                if (value != "json" && value != "csv") {
+                    throw invalid_argument("Unknown format " + value);
+                }
+                options.format = value;
+            } else if (arg == "--sizes") {
+                options.sizes = parseSizes(value);
+            } else if (arg == "--seed") {
+                options.seed = static_cast<unsigned>(stoul(value));
+            } else if (arg == "--min-time") {
+                options.minTime = stod(value);
+            } else if (arg == "--cubic-max") {
+                options.cubicMax = stoi(value);
+            } else if (arg == "--max-memory") {
+                options.maxMemoryMiB = stoll(value);
+            } else {
+                throw invalid_argument("Unknown option " + arg);
+            }
+        }
+        return options;
+    }
+
+    void printResult(const Result &r, const string &format, bool first) {
+        double edgesPerSec = r.nsPerOp > 0 ? r.edges / (r.nsPerOp * 1e-9) : 0;
+        if (format == "csv") {
+            cout << r.family << ',' << r.vertices << ',' << r.edges << ',' << r.op << ',' << r.engine << ','
+                 << r.iterations << ',' << r.nsPerOp << ',' << edgesPerSec << ',' << r.peakRssKiB << '\n';
+        } else {
+            cout << (first ? "\n" : ",\n")
+                 << "    {\"family\": \"" << r.family << "\", \"vertices\": " << r.vertices << ", \"edges\": " << r.edges
+                 << ", \"op\": \"" << r.op << "\", \"engine\": \"" << r.engine << "\", \"iterations\": " << r.iterations
+                 << ", \"ns_per_op\": " << r.nsPerOp << ", \"edges_per_sec\": " << edgesPerSec
+                 << ", \"peak_rss_kib\": " << r.peakRssKiB << "}";
+        }
+        cout.flush();
+    }
+}
+
+int main(int argc, char *argv[]) {
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    if (options.format == "csv") {
+        cout << "family,vertices,edges,op,engine,iterations,ns_per_op,edges_per_sec,peak_rss_kib\n";
+    } else {
+        cout << "{\n  \"compiler\": \"" << __VERSION__ << "\",\n  \"seed\": " << options.seed << ",\n  \"results\": [";
+    }
+
+    bool first = true;
+    const char *families[] = {"dense", "sparse"};
+    for (const char *family : families) {
+        for (int n : options.sizes) {
+            // The matrices of the three graphs below plus the source matrix of loadGraph
+            long long bytes = 4LL * n * n * static_cast<long long>(sizeof(int));
+            if (n < 2 || bytes > options.maxMemoryMiB * 1024 * 1024) {
+                cerr << "skipping " << family << " n=" << n << ": needs about " << (bytes >> 20)
+                     << " MiB of adjacency matrices (--max-memory " << options.maxMemoryMiB << ")" << endl;
+                continue;
+            }
+            double p = strcmp(family, "dense") == 0 ? 0.5 : min(1.0, 8.0 / n);
+            GraphGenerator::Options generatorOptions;
+            generatorOptions.seed = options.seed + n;
+            generatorOptions.minWeight = 1;
+            generatorOptions.maxWeight = 100;
+            Graph weighted, unweighted, signedGraph;
+            GraphGenerator::erdosRenyi(weighted, n, p, generatorOptions);
+            vector<vector<int>> weightedMatrix = weighted.getAdjacencyMatrix();
+            vector<vector<int>> unweightedMatrix = weightedMatrix;
+            for (vector<int> &row : unweightedMatrix) {
+                for (int &cell : row) {
+                    cell = cell != 0 ? 1 : 0;
+                }
+            }
+            unweighted.loadGraph(unweightedMatrix);
+            generatorOptions.directed = true;
+            generatorOptions.minWeight = -10;
+            generatorOptions.maxWeight = 90;
+            GraphGenerator::erdosRenyi(signedGraph, n, p, generatorOptions);
+
+            auto run = [&](const string &op, const string &engine, const Graph &g, const function<void()> &call) {
+                pair<long long, double> timing = timeOp(call, options.minTime);
+                Result r = {family, n, g.getEdgesNum(), op, engine, timing.first, timing.second, peakRssKiB()};
+                printResult(r, options.format, first);
+                first = false;
+            };
+
+            run("loadGraph", "matrix", weighted, [&]() {
+                Graph g;
+                g.loadGraph(weightedMatrix);
+                sink = sink + g.getEdgesNum();
+            });
+            run("isConnected", "Tarjan", weighted, [&]() { sink = sink + Algorithms::isConnected(weighted); });
+            {
+                // Out of core with a cap of 1/8 of the file, the adjacency streamed from the page cache
+                ExternalGraph::Options externalOptions;
+                externalOptions.blockSize = 4 << 10;
+                string path = "bench_graph.ext";
+                ExternalGraph::build(unweighted, path, externalOptions);
+                ExternalGraph external(path, externalOptions);
+                externalOptions.memoryBytes = max<size_t>(static_cast<size_t>(external.getBlockNum()) * externalOptions.blockSize / 8, 1 << 20);
+                ExternalGraph capped(path, externalOptions);
+                run("isConnected", "external", unweighted, [&]() { sink = sink + capped.isConnected(); });
+                cerr << "external " << family << " n=" << n << ": " << capped.getStats().edgesPerSecond() << " edges/s, peak "
+                     << capped.getStats().peakMemoryBytes << " bytes, " << capped.getStats().blocksRead << " blocks read" << endl;
+                remove(path.c_str());
+            }
+            run("shortestPath", "BFS", unweighted, [&]() { sink = sink + Algorithms::shortestPath(unweighted, 0, n - 1).size(); });
+            run("shortestPath", "Dijkstra", weighted, [&]() { sink = sink + Algorithms::shortestPath(weighted, 0, n - 1).size(); });
+            vector<int> sources;
+            for (int i = 0; i < 64; ++i) {
+                sources.push_back(static_cast<int>((static_cast<long long>(i) * n) / 64));
+            }
+            vector<vector<int>> distances;
+            run("multiSourceBFS x64", "MS-BFS", unweighted, [&]() {
+                Algorithms::multiSourceBFS(unweighted, sources, distances);
+                sink = sink + distances.size();
+            });
+            run("multiSourceBFS x64", "BFS per source", unweighted, [&]() {
+                for (int source : sources) {
+                    bfsDistances(unweighted, source, distances[0]);
+                    sink = sink + distances[0].size();
+                }
+            });
+            run("isContainsCycle", "DFS", weighted, [&]() { sink = sink + Algorithms::isContainsCycle(weighted).size(); });
+            run("isBipartite", "BFS", unweighted, [&]() { sink = sink + Algorithms::isBipartite(unweighted).size(); });
+            if (n <= options.cubicMax) {
+                run("shortestPath", "BellmanFord", signedGraph, [&]() { sink = sink + Algorithms::shortestPath(signedGraph, 0, n - 1).size(); });
+                run("negativeCycle", "BellmanFord", signedGraph, [&]() { sink = sink + Algorithms::negativeCycle(signedGraph).size(); });
+            } else {
+                cerr << "skipping Bellman-Ford for " << family << " n=" << n << " (--cubic-max " << options.cubicMax << ")" << endl;
+            }
+        }
+    }
+
+    for (int n : options.sizes) {
+        int side = static_cast<int>(sqrt(static_cast<double>(n)));
+        long long bytes = 3LL * side * side * side * side * static_cast<long long>(sizeof(int));
+        if (side < 2 || bytes > options.maxMemoryMiB * 1024 * 1024) {
+            continue;
+        }
+        int vertices = side * side;
+        Graph grid, shuffled;
+        GraphGenerator::grid(grid, side, side);
+        vector<int> newToOld(vertices);
+        for (int v = 0; v < vertices; ++v) {
+            newToOld[v] = v;
+        }
+        shuffle(newToOld.begin(), newToOld.end(), mt19937(options.seed));
+        GraphReorder::permute(grid, newToOld, shuffled);
+        ReorderedGraph reordered(shuffled, GraphReorder::REVERSE_CUTHILL_MCKEE);
+        cerr << "grid n=" << vertices << ": bandwidth " << reordered.getLocalityBefore().bandwidth << " -> "
+             << reordered.getLocalityAfter().bandwidth << ", average gap " << reordered.getLocalityBefore().averageGap
+             << " -> " << reordered.getLocalityAfter().averageGap << " (RCM)" << endl;
+
+        CompressedGraph shuffledCompressed(shuffled);
+        CompressedGraph reorderedCompressed(reordered.getGraph());
+        int start = reordered.toNew(0);
+        int end = reordered.toNew(vertices - 1);
+        auto run = [&](const string &family, const string &op, const string &engine, const function<void()> &call) {
+            pair<long long, double> timing = timeOp(call, options.minTime);
+            Result r = {family, vertices, shuffled.getEdgesNum(), op, engine, timing.first, timing.second, peakRssKiB()};
+            printResult(r, options.format, first);
+            first = false;
+        };
+        run("grid-shuffled", "reorder", "RCM", [&]() { sink = sink + GraphReorder::order(shuffled, GraphReorder::REVERSE_CUTHILL_MCKEE).size(); });
+        run("grid-shuffled", "shortestPath", "BFS compressed", [&]() { sink = sink + Algorithms::shortestPath(shuffledCompressed, 0, vertices - 1).size(); });
+        run("grid-rcm", "shortestPath", "BFS compressed", [&]() { sink = sink + Algorithms::shortestPath(reorderedCompressed, start, end).size(); });
+    }
+
+    if (options.format == "json") {
+        cout << "\n  ]\n}\n";
+    }
+    return 0;
+}
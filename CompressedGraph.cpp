@@ -0,0 +1,233 @@
+//mail: guyes134@gmail.com
+
+#include "CompressedGraph.hpp"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+const int CompressedGraph::BLOCK_SHIFT;
+
+/**
+ * @brief Default constructor for the CompressedGraph class. Creates an empty graph.
+ */
+CompressedGraph::CompressedGraph() : vertexNum(0), edgesNum(0), isDirected(false), isWeighted(false), hasNegWeight(false),
+                                     weightWidth(0), entryNum(0) {}
+
+/**
+ * @brief Constructor that compresses the given graph.
+ *
+ * @param g The graph to be compressed.
+ */
+CompressedGraph::CompressedGraph(const Graph &g) : CompressedGraph() {
+    compress(g);
+}
+
+/**
+ * @brief Constructor that compresses a mapped graph file without building its matrix.
+ *
+ * @param g The mapped graph to be compressed.
+ */
+CompressedGraph::CompressedGraph(const MappedGraph &g) : CompressedGraph() {
+    compress(g);
+}
+
+/**
+ * @brief Appends a value to the buffer as an LEB128 varint (7 bits per byte, high bit set on all but the last).
+ *
+ * @param out The buffer to append to.
+ * @param value The value to be encoded.
+ */
+void CompressedGraph::encodeVarint(std::vector<uint8_t> &out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Appends the record of vertex u: its degree, then the gap and the weight of every neighbour.
+ *
+ * @param u The vertex, the one after the last vertex written.
+ * @param row The neighbours of u and their weights, in increasing order.
+ */
+void CompressedGraph::appendRecord(int u, const std::vector<std::pair<int, int>> &row) {
+    if ((u & ((1 << BLOCK_SHIFT) - 1)) == 0) {
+        blockOffsets.push_back(bytes.size());
+    }
+    vertexOffsets[u] = static_cast<uint32_t>(bytes.size() - blockOffsets.back());
+    encodeVarint(bytes, static_cast<uint32_t>(row.size()));
+
+    int previous = -1;
+    for (const pair<int, int> &entry : row) {
+        int v = entry.first;
+        int w = entry.second;
+        encodeVarint(bytes, static_cast<uint32_t>(v - previous - 1));
+        previous = v;
+        uint8_t raw[4];
+        if (weightWidth == 1) {
+            int8_t narrow = static_cast<int8_t>(w);
+            memcpy(raw, &narrow, 1);
+        } else if (weightWidth == 2) {
+            int16_t narrow = static_cast<int16_t>(w);
+            memcpy(raw, &narrow, 2);
+        } else {
+            int32_t narrow = w;
+            memcpy(raw, &narrow, 4);
+        }
+        bytes.insert(bytes.end(), raw, raw + weightWidth);
+    }
+}
+
+/**
+ * @brief Builds the compressed representation from a stream of edges sorted by source, then target.
+ *
+ * forEachEdge is called twice and must give visit the same edges both times: the first pass finds the weight range
+ * (for the width of the weights) and the number of vertices, the second one encodes the records. Only the neighbours
+ * of one vertex are buffered, so a graph streamed from a file or a MappedGraph never exists as a matrix.
+ * Edges of weight 0 are skipped.
+ *
+ * @param verNum The number of vertices, or -1 for the largest id of the stream plus one.
+ * @param directed The graph is directed; an undirected graph lists every edge in both directions.
+ * @param forEachEdge Calls its argument with every edge (u, v, weight), in increasing (u, v) order.
+ */
+void CompressedGraph::compressSortedEdges(int verNum, bool directed, const std::function<void(const EdgeVisitor &visit)> &forEachEdge) {
+    int minWeight = 1, maxWeight = 1;
+    int maxVertex = -1;
+    uint64_t entries = 0;
+    int lastU = -1, lastV = -1;
+    forEachEdge([&](int u, int v, int weight) {
+        if (weight == 0) {
+            return;
+        }
+        if (u < 0 || v < 0 || (verNum >= 0 && (u >= verNum || v >= verNum))) {
+            throw invalid_argument("Invalid edge: The vertex does not exist.");
+        }
+        if (u < lastU || (u == lastU && v <= lastV)) {
+            throw invalid_argument("Invalid graph: The edges are not sorted by source and target.");
+        }
+        lastU = u;
+        lastV = v;
+        minWeight = min(minWeight, weight);
+        maxWeight = max(maxWeight, weight);
+        maxVertex = max(maxVertex, max(u, v));
+        entries++;
+    });
+
+    vertexNum = verNum >= 0 ? verNum : maxVertex + 1;
+    entryNum = entries;
+    edgesNum = static_cast<int>(directed ? entries : entries / 2);
+    isDirected = directed;
+    isWeighted = minWeight != 1 || maxWeight != 1;
+    hasNegWeight = minWeight < 0;
+    if (minWeight == 1 && maxWeight == 1) {
+        weightWidth = 0;
+    } else if (minWeight >= numeric_limits<int8_t>::min() && maxWeight <= numeric_limits<int8_t>::max()) {
+        weightWidth = 1;
+    } else if (minWeight >= numeric_limits<int16_t>::min() && maxWeight <= numeric_limits<int16_t>::max()) {
+        weightWidth = 2;
+    } else {
+        weightWidth = 4;
+    }
+
+    blockOffsets.clear();
+    vertexOffsets.assign(vertexNum, 0);
+    bytes.clear();
+
+    vector<pair<int, int>> row; // The neighbours of vertex next
+    int next = 0;
+    forEachEdge([&](int u, int v, int weight) {
+        if (weight == 0) {
+            return;
+        }
+        if (u >= vertexNum) {
+            throw invalid_argument("Invalid graph: The edge stream changed between its two passes.");
+        }
+        for (; next < u; ++next) {
+            appendRecord(next, row);
+            row.clear();
+        }
+        row.push_back(make_pair(v, weight));
+    });
+    for (; next < vertexNum; ++next) {
+        appendRecord(next, row);
+        row.clear();
+    }
+    bytes.shrink_to_fit();
+}
+
+/**
+ * @brief Builds the compressed representation of the given graph.
+ *
+ * The rows of the adjacency matrix are scanned in order, so the neighbour lists come out sorted.
+ *
+ * @param g The graph to be compressed.
+ */
+void CompressedGraph::compress(const Graph &g) {
+    const vector<vector<int>> &matrix = g.getAdjacencyMatrix();
+    int V = g.getVertexNum();
+    compressSortedEdges(V, g.getIsDirected(), [&matrix, V](const EdgeVisitor &visit) {
+        for (int u = 0; u < V; ++u) {
+            for (int v = 0; v < V; ++v) {
+                if (matrix[u][v] != 0) {
+                    visit(u, v, matrix[u][v]);
+                }
+            }
+        }
+    });
+}
+
+/**
+ * @brief Builds the compressed representation of a mapped graph file, straight from its sections.
+ *
+ * A CSR file is read list by list, so the graph is never held as a matrix; its lists must be sorted, as save
+ * writes them.
+ *
+ * @param g The mapped graph to be compressed.
+ */
+void CompressedGraph::compress(const MappedGraph &g) {
+    int V = g.getVertexNum();
+    compressSortedEdges(V, g.getIsDirected(), [&g, V](const EdgeVisitor &visit) {
+        for (int u = 0; u < V; ++u) {
+            if (g.isDense()) {
+                for (int v = 0; v < V; ++v) {
+                    visit(u, v, g.getWeight(u, v));
+                }
+                continue;
+            }
+            int degree = g.getDegree(u);
+            for (int k = 0; k < degree; ++k) {
+                visit(u, g.getNeighbour(u, k), g.getNeighbourWeight(u, k));
+            }
+        }
+    });
+}
+
+/**
+ * @brief Returns the number of bytes used by the compressed representation.
+ *
+ * @return size_t The size of the offset arrays and the encoded records.
+ */
+size_t CompressedGraph::memoryBytes() const {
+    return blockOffsets.size() * sizeof(uint64_t) + vertexOffsets.size() * sizeof(uint32_t) + bytes.size();
+}
+
+/**
+ * @brief Returns the size of the same graph as 32-bit CSR (int offsets, int targets and int weights).
+ *
+ * @return size_t The uncompressed size in bytes.
+ */
+size_t CompressedGraph::uncompressedBytes() const {
+    return (static_cast<size_t>(vertexNum) + 1) * sizeof(int) + entryNum * 2 * sizeof(int);
+}
+
+/**
+ * @brief Returns how many times smaller the compressed graph is than its 32-bit CSR form.
+ *
+ * @return double The compression ratio.
+ */
+double CompressedGraph::compressionRatio() const {
+    return memoryBytes() == 0 ? 1.0 : static_cast<double>(uncompressedBytes()) / static_cast<double>(memoryBytes());
+}
@@ -0,0 +1,169 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "Graph.hpp"
+#include "GraphFile.hpp"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * Read-only compressed adjacency lists.
+ *
+ * Every vertex has one record: its degree as an LEB128 varint, then for every neighbour (in increasing order)
+ * the gap to the previous neighbour (t0, t1 - t0 - 1, ...) as a varint followed by the weight in a fixed width
+ * of 1, 2 or 4 bytes, the narrowest that fits all weights, or no bytes at all when every weight is 1.
+ * Record positions are kept as a 64-bit base per block of 64 vertices plus a 32-bit offset per vertex.
+ *
+ * Besides a Graph, it can be built from a MappedGraph file or from any stream of sorted edges (for example
+ * GraphParser::streamEdgeListFile over a sorted edge list), so a graph too large for a matrix never has to be one.
+ */
+class CompressedGraph{
+private:
+    int vertexNum;
+    int edgesNum;
+    bool isDirected;
+    bool isWeighted;
+    bool hasNegWeight;
+    int weightWidth;
+    uint64_t entryNum;
+    std::vector<uint64_t> blockOffsets;
+    std::vector<uint32_t> vertexOffsets;
+    std::vector<uint8_t> bytes;
+
+    static const int BLOCK_SHIFT = 6;
+
+    static void encodeVarint(std::vector<uint8_t> &out, uint32_t value);
+    void appendRecord(int u, const std::vector<std::pair<int, int>> &row);
+
+    static uint32_t decodeVarint(const uint8_t *&p){
+        uint32_t value = *p & 0x7f;
+        int shift = 7;
+        while (*p++ & 0x80) {
+            value |= static_cast<uint32_t>(*p & 0x7f) << shift;
+            shift += 7;
+        }
+        return value;
+    }
+
+    static int readWeight(const uint8_t *&p, int width){
+        switch (width) {
+            case 0:
+                return 1;
+            case 1:
+                return static_cast<int8_t>(*p++);
+            case 2: {
+                int16_t weight;
+                memcpy(&weight, p, 2);
+                p += 2;
+                return weight;
+            }
+            default: {
+                int32_t weight;
+                memcpy(&weight, p, 4);
+                p += 4;
+                return weight;
+            }
+        }
+    }
+
+    const uint8_t *record(int v) const{
+        return bytes.data() + blockOffsets[v >> BLOCK_SHIFT] + vertexOffsets[v];
+    }
+
+public:
+    typedef std::function<void(int u, int v, int weight)> EdgeVisitor;
+
+    /**
+     * Decodes the neighbours of one vertex on the fly, in increasing order.
+     */
+    class NeighbourIterator{
+    private:
+        const uint8_t *p;
+        uint32_t remaining;
+        int width;
+        int current;
+        int currentWeight;
+
+        void decode(int base){
+            current = base + static_cast<int>(decodeVarint(p));
+            currentWeight = readWeight(p, width);
+        }
+
+    public:
+        NeighbourIterator(const CompressedGraph *graph, int v)
+                : p(graph->record(v)), remaining(0), width(graph->weightWidth), current(0), currentWeight(0){
+            remaining = decodeVarint(p);
+            if (remaining > 0) {
+                decode(0);
+            }
+        }
+
+        bool valid() const{
+            return remaining > 0;
+        }
+
+        void next(){
+            if (--remaining > 0) {
+                decode(current + 1);
+            }
+        }
+
+        int vertex() const{
+            return current;
+        }
+
+        int weight() const{
+            return currentWeight;
+        }
+    };
+
+    //methods
+    void compress(const Graph &g);
+    void compress(const MappedGraph &g);
+    void compressSortedEdges(int verNum, bool directed, const std::function<void(const EdgeVisitor &visit)> &forEachEdge);
+    size_t memoryBytes() const;
+    size_t uncompressedBytes() const;
+    double compressionRatio() const;
+
+    //constructors
+    CompressedGraph();
+    explicit CompressedGraph(const Graph &g);
+    explicit CompressedGraph(const MappedGraph &g);
+
+    NeighbourIterator neighbours(int v) const{
+        return NeighbourIterator(this, v);
+    }
+
+    int getDegree(int v) const{
+        const uint8_t *p = record(v);
+        return static_cast<int>(decodeVarint(p));
+    }
+
+    int getVertexNum() const{
+        return vertexNum;
+    }
+
+    int getEdgesNum() const{
+        return edgesNum;
+    }
+
+    bool getIsDirected() const{
+        return isDirected;
+    }
+
+    bool getIsWeighted() const{
+        return isWeighted;
+    }
+
+    bool getHasNegEdges() const{
+        return hasNegWeight;
+    }
+
+    int getWeightWidth() const{
+        return weightWidth;
+    }
+};
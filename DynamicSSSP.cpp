@@ -0,0 +1,227 @@
+//mail: guyes134@gmail.com
+
+#include "DynamicSSSP.hpp"
+#include "Algorithms.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * @brief Constructor that copies the graph, builds its neighbour lists and runs Dijkstra from start.
+ *
+ * @param g The graph; its weights must be non-negative.
+ * @param start The source of the shortest paths.
+ */
+template <typename Weight>
+BasicDynamicSSSP<Weight>::BasicDynamicSSSP(const BasicGraph<Weight> &g, int start) : graph(g), source(start), affectedNum(0) {
+    TRACE_SPAN("DynamicSSSP::build");
+    int V = graph.getVertexNum();
+    if (start < 0 || start >= V) {
+        throw invalid_argument("Invalid vertex: The vertex does not exist.");
+    }
+    if (graph.getHasNegEdges()) {
+        throw invalid_argument("Invalid graph: Dynamic shortest paths need non-negative weights.");
+    }
+
+    const vector<vector<Weight>> &matrix = graph.getAdjacencyMatrix();
+    outNeighbours.resize(V);
+    inNeighbours.resize(V);
+    for (int u = 0; u < V; ++u) {
+        for (int v = 0; v < V; ++v) {
+            if (u != v && matrix[u][v] != 0) {
+                outNeighbours[u].push_back(v);
+                inNeighbours[v].push_back(u);
+            }
+        }
+    }
+
+    dist.assign(V, infiniteDistance<Distance>());
+    parent.assign(V, -1);
+    inSubtree.assign(V, false);
+    dist[source] = 0;
+    push(0, source);
+    settle(false);
+}
+
+template <typename Weight>
+void BasicDynamicSSSP<Weight>::link(int u, int v) {
+    outNeighbours[u].push_back(v);
+    inNeighbours[v].push_back(u);
+}
+
+template <typename Weight>
+void BasicDynamicSSSP<Weight>::unlink(int u, int v) {
+    vector<int> &out = outNeighbours[u];
+    vector<int> &in = inNeighbours[v];
+    *find(out.begin(), out.end(), v) = out.back();
+    out.pop_back();
+    *find(in.begin(), in.end(), u) = in.back();
+    in.pop_back();
+}
+
+template <typename Weight>
+void BasicDynamicSSSP<Weight>::push(Distance distance, int v) {
+    heap.push_back(make_pair(distance, v));
+    push_heap(heap.begin(), heap.end(), greater<pair<Distance, int>>());
+}
+
+/**
+ * @brief Runs Dijkstra from the vertices in the heap until it is empty.
+ *
+ * @param subtreeOnly Relax only the edges into the marked subtree, whose distances are being rebuilt.
+ */
+template <typename Weight>
+void BasicDynamicSSSP<Weight>::settle(bool subtreeOnly) {
+    const vector<vector<Weight>> &matrix = graph.getAdjacencyMatrix();
+    greater<pair<Distance, int>> later;
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), later);
+        Distance currDist = heap.back().first;
+        int u = heap.back().second;
+        heap.pop_back();
+        if (currDist > dist[u]) {
+            continue;
+        }
+        affectedNum++;
+        for (int v : outNeighbours[u]) {
+            if (subtreeOnly && !inSubtree[v]) {
+                continue;
+            }
+            Distance candidate = addDistance(currDist, matrix[u][v]);
+            if (candidate < dist[v]) {
+                dist[v] = candidate;
+                parent[v] = u;
+                push(candidate, v);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Repairs the paths after u->v got cheaper or was inserted: only the vertices it improves are visited.
+ */
+template <typename Weight>
+void BasicDynamicSSSP<Weight>::decrease(int u, int v) {
+    if (dist[u] == infiniteDistance<Distance>()) {
+        return;
+    }
+    Distance candidate = addDistance(dist[u], graph.getAdjacencyMatrix()[u][v]);
+    if (candidate >= dist[v]) {
+        return;
+    }
+    dist[v] = candidate;
+    parent[v] = u;
+    push(candidate, v);
+    settle(false);
+}
+
+/**
+ * @brief Repairs the paths after u->v got more expensive or was deleted. Only the subtree below a tree edge can
+ * change; its vertices restart from their best in-neighbour outside the subtree and are settled among themselves.
+ */
+template <typename Weight>
+void BasicDynamicSSSP<Weight>::increase(int u, int v) {
+    if (parent[v] != u) {
+        return;
+    }
+    const vector<vector<Weight>> &matrix = graph.getAdjacencyMatrix();
+    subtree.clear();
+    subtree.push_back(v);
+    inSubtree[v] = true;
+    for (size_t head = 0; head < subtree.size(); ++head) {
+        int x = subtree[head];
+        for (int y : outNeighbours[x]) {
+            if (parent[y] == x && !inSubtree[y]) {
+                inSubtree[y] = true;
+                subtree.push_back(y);
+            }
+        }
+    }
+
+    for (int x : subtree) {
+        dist[x] = infiniteDistance<Distance>();
+        parent[x] = -1;
+    }
+    for (int x : subtree) {
+        for (int p : inNeighbours[x]) {
+            if (!inSubtree[p] && dist[p] != infiniteDistance<Distance>()) {
+                Distance candidate = addDistance(dist[p], matrix[p][x]);
+                if (candidate < dist[x]) {
+                    dist[x] = candidate;
+                    parent[x] = p;
+                }
+            }
+        }
+        if (dist[x] != infiniteDistance<Distance>()) {
+            push(dist[x], x);
+        }
+    }
+    settle(true);
+    affectedNum = static_cast<int>(subtree.size());
+    for (int x : subtree) {
+        inSubtree[x] = false;
+    }
+}
+
+/**
+ * @brief Sets the weight of the edge u->v (0 deletes it) and updates the shortest paths.
+ *
+ * To change an edge of an undirected graph, set both directions.
+ *
+ * @param u The source vertex.
+ * @param v The destination vertex.
+ * @param weight The new weight, non-negative.
+ */
+template <typename Weight>
+void BasicDynamicSSSP<Weight>::setEdge(int u, int v, Weight weight) {
+    TRACE_SPAN("DynamicSSSP::setEdge");
+    if (u < 0 || v < 0 || u >= graph.getVertexNum() || v >= graph.getVertexNum()) {
+        throw invalid_argument("Invalid edge: The vertex does not exist.");
+    }
+    if (weight < 0) {
+        throw invalid_argument("Invalid weight: Dynamic shortest paths need non-negative weights.");
+    }
+    affectedNum = 0;
+    Weight old = graph.getAdjacencyMatrix()[u][v];
+    if (old == weight) {
+        return;
+    }
+    graph.setEdge(u, v, weight);
+    if (u == v) { // A self loop never lies on a shortest path
+        return;
+    }
+    if (old == 0) {
+        link(u, v);
+    } else if (weight == 0) {
+        unlink(u, v);
+    }
+
+    if (weight != 0 && (old == 0 || weight < old)) {
+        decrease(u, v);
+    } else {
+        increase(u, v);
+    }
+}
+
+/**
+ * @brief Returns the shortest path from the source to end like Algorithms::shortestPath, "-1" if there is none.
+ *
+ * @param end The last vertex of the path.
+ */
+template <typename Weight>
+std::string BasicDynamicSSSP<Weight>::shortestPath(int end) const {
+    if (end < 0 || end >= graph.getVertexNum() || dist[end] == infiniteDistance<Distance>()) {
+        return "-1";
+    }
+    return Algorithms::pathToString(parent, end);
+}
+
+template class BasicDynamicSSSP<int8_t>;
+template class BasicDynamicSSSP<int16_t>;
+template class BasicDynamicSSSP<int>;
+template class BasicDynamicSSSP<int64_t>;
+template class BasicDynamicSSSP<float>;
+template class BasicDynamicSSSP<double>;
@@ -0,0 +1,81 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "Graph.hpp"
+#include "WeightTraits.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Shortest paths from a fixed source that are kept up to date as edges change (Ramalingam-Reps).
+ *
+ * The structure owns a copy of the graph with in- and out-neighbour lists, and the distance and shortest-path tree
+ * parent of every vertex. setEdge applies one change and repairs only what it affects:
+ * - A decrease or insertion of u->v that shortens the path to v runs Dijkstra from v over the vertices it improves.
+ * - An increase or deletion of the tree edge u->v recomputes the subtree of v: each of its vertices starts from its
+ *   best in-neighbour outside the subtree, then Dijkstra runs inside the subtree. Changes to non-tree edges cost O(1).
+ * The work is proportional to the edges of the affected vertices (times a log for the heap), not to the graph.
+ *
+ * Weights must be non-negative. Distances are the ones of a fresh DijkstraShortestPath; among several shortest paths
+ * of the same length the tree may keep another one.
+ */
+template <typename Weight>
+class BasicDynamicSSSP{
+public:
+    typedef typename WeightTraits<Weight>::Distance Distance;
+
+private:
+    BasicGraph<Weight> graph;
+    std::vector<std::vector<int>> outNeighbours;
+    std::vector<std::vector<int>> inNeighbours;
+    int source;
+    std::vector<Distance> dist;
+    std::vector<int> parent;
+    int affectedNum;
+
+    // Scratch memory kept between updates
+    std::vector<char> inSubtree;
+    std::vector<int> subtree;
+    std::vector<std::pair<Distance, int>> heap;
+
+    void link(int u, int v);
+    void unlink(int u, int v);
+    void push(Distance distance, int v);
+    void settle(bool subtreeOnly);
+    void decrease(int u, int v);
+    void increase(int u, int v);
+
+public:
+    //methods
+    void setEdge(int u, int v, Weight weight);
+    std::string shortestPath(int end) const;
+
+    //constructors
+    BasicDynamicSSSP(const BasicGraph<Weight> &g, int start);
+
+    int getSource() const{
+        return source;
+    }
+
+    const BasicGraph<Weight> &getGraph() const{
+        return graph;
+    }
+
+    // The distance from the source, infiniteDistance<Distance>() if v is unreachable
+    Distance getDistance(int v) const{
+        return dist[v];
+    }
+
+    int getParent(int v) const{
+        return parent[v];
+    }
+
+    // The number of vertices whose distance was recomputed by the last update
+    int getAffectedNum() const{
+        return affectedNum;
+    }
+};
+
+typedef BasicDynamicSSSP<int> DynamicSSSP;
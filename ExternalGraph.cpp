@@ -0,0 +1,1016 @@
+//mail: guyes134@gmail.com
+
+#include "ExternalGraph.hpp"
+#include "GraphParser.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    const char MAGIC[4] = {'E', 'X', 'T', 'G'};
+    const uint32_t END_OF_BLOCK = 0xffffffffu;
+    const size_t MIN_BLOCK_SIZE = 64;
+    const size_t MIN_IO_BYTES = 256;
+    const size_t MAX_IO_BYTES = 1 << 20;
+    const size_t MIN_CHUNK_BYTES = 1 << 10;
+
+    /**
+     * The size of every run reader and writer buffer: 1/64 of the cap, between 256 bytes and 1 MiB.
+     */
+    size_t ioBytesFor(size_t memoryBytes) {
+        return max(MIN_IO_BYTES, min(MAX_IO_BYTES, memoryBytes / 64)) & ~static_cast<size_t>(7);
+    }
+
+    /**
+     * The read buffer of an edge list build: 1/64 of the cap, between 1 KiB and the parser's own chunk size.
+     */
+    size_t chunkBytesFor(size_t memoryBytes) {
+        return max(MIN_CHUNK_BYTES, min(GraphParser::CHUNK_SIZE, memoryBytes / 64));
+    }
+
+    bool readAll(int fd, void *data, size_t size, uint64_t offset) {
+        char *p = static_cast<char *>(data);
+        while (size > 0) {
+            ssize_t n = pread(fd, p, size, static_cast<off_t>(offset));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            p += n;
+            size -= static_cast<size_t>(n);
+            offset += static_cast<uint64_t>(n);
+        }
+        return true;
+    }
+
+    void writeAll(int fd, const void *data, size_t size, uint64_t offset) {
+        const char *p = static_cast<const char *>(data);
+        while (size > 0) {
+            ssize_t n = pwrite(fd, p, size, static_cast<off_t>(offset));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw runtime_error(string("Failed writing external graph data: ") + strerror(errno));
+            }
+            p += n;
+            size -= static_cast<size_t>(n);
+            offset += static_cast<uint64_t>(n);
+        }
+    }
+
+    /**
+     * The bytes of the buffers in use, checked against the RAM cap.
+     */
+    class MemoryBudget{
+    private:
+        size_t cap;
+        size_t used;
+        size_t peak;
+
+    public:
+        explicit MemoryBudget(size_t limit) : cap(limit), used(0), peak(0) {}
+
+        void acquire(size_t bytes) {
+            if (bytes > cap - used) {
+                throw runtime_error("External graph: The memory cap of " + to_string(cap) + " bytes is too small.");
+            }
+            used += bytes;
+            peak = max(peak, used);
+        }
+
+        void release(size_t bytes) {
+            used -= bytes;
+        }
+
+        size_t available() const {
+            return cap - used;
+        }
+
+        size_t getPeak() const {
+            return peak;
+        }
+    };
+
+    // A fixed, uninitialized array charged to a budget for its lifetime
+    template <typename T>
+    class Buffer{
+    private:
+        MemoryBudget &budget;
+        unique_ptr<T[]> data;
+        size_t length;
+
+    public:
+        Buffer(MemoryBudget &memory, size_t size) : budget(memory), length(size) {
+            budget.acquire(size * sizeof(T));
+            data.reset(new T[size]);
+        }
+
+        Buffer(const Buffer &) = delete;
+        Buffer &operator=(const Buffer &) = delete;
+
+        ~Buffer() {
+            budget.release(length * sizeof(T));
+        }
+
+        T *get() {
+            return data.get();
+        }
+
+        size_t size() const {
+            return length;
+        }
+    };
+
+    // Bytes charged to a budget for the lifetime of the object, for memory that is not a Buffer
+    class Charge{
+    private:
+        MemoryBudget &budget;
+        size_t bytes;
+
+    public:
+        Charge(MemoryBudget &memory, size_t size) : budget(memory), bytes(size) {
+            budget.acquire(bytes);
+        }
+
+        Charge(const Charge &) = delete;
+        Charge &operator=(const Charge &) = delete;
+
+        ~Charge() {
+            budget.release(bytes);
+        }
+    };
+
+    // An anonymous temporary file, unlinked as soon as it is created
+    class TempFile{
+    private:
+        int fd;
+        uint64_t size;
+
+    public:
+        explicit TempFile(const string &dir) : size(0) {
+            string pattern = dir + "/extgraph-XXXXXX";
+            vector<char> name(pattern.begin(), pattern.end());
+            name.push_back('\0');
+            fd = mkstemp(name.data());
+            if (fd == -1) {
+                throw runtime_error("Cannot create a temporary file in " + dir);
+            }
+            unlink(name.data());
+        }
+
+        TempFile(const TempFile &) = delete;
+        TempFile &operator=(const TempFile &) = delete;
+
+        ~TempFile() {
+            ::close(fd);
+        }
+
+        void append(const void *data, size_t bytes, ExternalGraph::Stats &stats) {
+            writeAll(fd, data, bytes, size);
+            size += bytes;
+            stats.bytesWritten += static_cast<long long>(bytes);
+        }
+
+        size_t read(void *data, size_t bytes, uint64_t offset, ExternalGraph::Stats &stats) const {
+            bytes = static_cast<size_t>(min<uint64_t>(bytes, size - offset));
+            if (!readAll(fd, data, bytes, offset)) {
+                throw runtime_error(string("Failed reading a temporary file: ") + strerror(errno));
+            }
+            stats.bytesRead += static_cast<long long>(bytes);
+            return bytes;
+        }
+
+        uint64_t getSize() const {
+            return size;
+        }
+    };
+
+    template <typename T>
+    class RunWriter{
+    private:
+        TempFile &file;
+        Buffer<T> buffer;
+        size_t used;
+        ExternalGraph::Stats &stats;
+
+    public:
+        RunWriter(TempFile &out, MemoryBudget &budget, size_t bytes, ExternalGraph::Stats &counters)
+            : file(out), buffer(budget, bytes / sizeof(T)), used(0), stats(counters) {}
+
+        void put(T value) {
+            if (used == buffer.size()) {
+                flush();
+            }
+            buffer.get()[used++] = value;
+        }
+
+        void flush() {
+            file.append(buffer.get(), used * sizeof(T), stats);
+            used = 0;
+        }
+    };
+
+    // Reads a run file in order; value() is the current element while valid()
+    template <typename T>
+    class RunReader{
+    private:
+        const TempFile &file;
+        Buffer<T> buffer;
+        uint64_t offset;
+        size_t position;
+        size_t filled;
+        ExternalGraph::Stats &stats;
+
+        void refill() {
+            size_t bytes = file.read(buffer.get(), buffer.size() * sizeof(T), offset, stats);
+            offset += bytes;
+            filled = bytes / sizeof(T);
+            position = 0;
+        }
+
+    public:
+        RunReader(const TempFile &in, MemoryBudget &budget, size_t bytes, ExternalGraph::Stats &counters)
+            : file(in), buffer(budget, bytes / sizeof(T)), offset(0), position(0), filled(0), stats(counters) {
+            refill();
+        }
+
+        bool valid() const {
+            return position < filled;
+        }
+
+        T value() {
+            return buffer.get()[position];
+        }
+
+        void advance() {
+            if (++position >= filled) {
+                refill();
+            }
+        }
+
+        // Skips the elements smaller than v and tells whether v is next
+        bool contains(T v) {
+            while (valid() && value() < v) {
+                advance();
+            }
+            return valid() && value() == v;
+        }
+    };
+
+    /**
+     * External sort of a stream of keys: a sorted, deduplicated run is spilled to a temporary file every time the
+     * buffer fills up, and forEachUnique merges the runs, first in passes of fanIn runs while there are too many for
+     * one reader buffer each. A stream that fits in the buffer never touches the disk.
+     */
+    template <typename T>
+    class RunSorter{
+    private:
+        MemoryBudget &budget;
+        const string &dir;
+        size_t ioBytes;
+        ExternalGraph::Stats &stats;
+        unique_ptr<Buffer<T>> buffer;
+        size_t used;
+        vector<unique_ptr<TempFile>> runs;
+
+        void spill() {
+            T *data = buffer->get();
+            sort(data, data + used);
+            size_t n = static_cast<size_t>(unique(data, data + used) - data);
+            runs.emplace_back(new TempFile(dir));
+            runs.back()->append(data, n * sizeof(T), stats);
+            stats.runFiles++;
+            used = 0;
+        }
+
+        // The memory a run takes in a merge besides its reader buffer: the reader and its heap entry
+        static size_t mergeBytesPerRun() {
+            return sizeof(unique_ptr<RunReader<T>>) + sizeof(RunReader<T>) + sizeof(pair<T, size_t>);
+        }
+
+        template <typename Emit>
+        void merge(size_t count, Emit emit) {
+            Charge bookkeeping(budget, count * mergeBytesPerRun());
+            vector<unique_ptr<RunReader<T>>> readers;
+            vector<pair<T, size_t>> heap;
+            readers.reserve(count);
+            heap.reserve(count);
+            greater<pair<T, size_t>> later;
+            for (size_t i = 0; i < count; ++i) {
+                readers.emplace_back(new RunReader<T>(*runs[i], budget, ioBytes, stats));
+                if (readers[i]->valid()) {
+                    heap.push_back(make_pair(readers[i]->value(), i));
+                }
+            }
+            make_heap(heap.begin(), heap.end(), later);
+            bool emitted = false;
+            T last = T();
+            while (!heap.empty()) {
+                pop_heap(heap.begin(), heap.end(), later);
+                T value = heap.back().first;
+                size_t i = heap.back().second;
+                heap.pop_back();
+                if (!emitted || value != last) {
+                    emit(value);
+                    emitted = true;
+                    last = value;
+                }
+                readers[i]->advance();
+                if (readers[i]->valid()) {
+                    heap.push_back(make_pair(readers[i]->value(), i));
+                    push_heap(heap.begin(), heap.end(), later);
+                }
+            }
+        }
+
+    public:
+        RunSorter(MemoryBudget &memory, const string &tempDir, size_t bufferBytes, size_t io, ExternalGraph::Stats &counters)
+            : budget(memory), dir(tempDir), ioBytes(io), stats(counters), buffer(new Buffer<T>(memory, max<size_t>(bufferBytes / sizeof(T), 1))), used(0) {}
+
+        void put(T value) {
+            if (used == buffer->size()) {
+                spill();
+            }
+            buffer->get()[used++] = value;
+        }
+
+        /**
+         * @brief Spills what is left and frees the sort buffer if runs were spilled, so the merge can use its memory.
+         *
+         * @param always Spill even if everything still fits in the buffer.
+         */
+        void finish(bool always = false) {
+            if (buffer && (always || !runs.empty())) {
+                if (used > 0) {
+                    spill();
+                }
+                buffer.reset();
+            }
+        }
+
+        template <typename Emit>
+        void forEachUnique(Emit emit) {
+            if (buffer && runs.empty()) {
+                T *data = buffer->get();
+                sort(data, data + used);
+                size_t n = static_cast<size_t>(unique(data, data + used) - data);
+                for (size_t i = 0; i < n; ++i) {
+                    emit(data[i]);
+                }
+                return;
+            }
+            finish();
+            size_t fanIn = max<size_t>(2, budget.available() / (ioBytes + mergeBytesPerRun()) - 1); // One buffer for the writer of a pass
+            while (runs.size() > fanIn) {
+                unique_ptr<TempFile> merged(new TempFile(dir));
+                {
+                    RunWriter<T> writer(*merged, budget, ioBytes, stats);
+                    merge(fanIn, [&](T value) { writer.put(value); });
+                    writer.flush();
+                }
+                runs.erase(runs.begin(), runs.begin() + static_cast<ptrdiff_t>(fanIn));
+                runs.push_back(move(merged));
+            }
+            merge(runs.size(), emit);
+        }
+    };
+
+    /**
+     * Reads a list of blocks of one section, in order, with a thread that fills one buffer while the caller
+     * works on the other.
+     */
+    class BlockPrefetcher{
+    private:
+        int fd;
+        uint64_t base;
+        size_t blockSize;
+        const uint32_t *blocks;
+        size_t blockNum;
+        Buffer<char> buffers;
+        mutex lock;
+        condition_variable changed;
+        size_t produced;
+        size_t consumed;
+        bool stopping;
+        bool failed;
+        thread worker;
+
+        void run() {
+            for (size_t i = 0; i < blockNum; ++i) {
+                {
+                    unique_lock<mutex> guard(lock);
+                    changed.wait(guard, [&]() { return stopping || i - consumed < 2; });
+                    if (stopping) {
+                        return;
+                    }
+                }
+                bool ok = readAll(fd, buffers.get() + (i % 2) * blockSize, blockSize, base + static_cast<uint64_t>(blocks[i]) * blockSize);
+                {
+                    lock_guard<mutex> guard(lock);
+                    if (!ok) {
+                        failed = true;
+                    } else {
+                        produced = i + 1;
+                    }
+                }
+                changed.notify_all();
+                if (!ok) {
+                    return;
+                }
+            }
+        }
+
+    public:
+        BlockPrefetcher(int file, uint64_t sectionOffset, size_t size, const uint32_t *blockList, size_t count, MemoryBudget &budget)
+            : fd(file), base(sectionOffset), blockSize(size), blocks(blockList), blockNum(count), buffers(budget, 2 * size),
+              produced(0), consumed(0), stopping(false), failed(false) {
+            worker = thread(&BlockPrefetcher::run, this);
+        }
+
+        ~BlockPrefetcher() {
+            {
+                lock_guard<mutex> guard(lock);
+                stopping = true;
+            }
+            changed.notify_all();
+            worker.join();
+        }
+
+        // Waits for block i of the list; the previous one must have been released
+        const char *acquire(size_t i) {
+            unique_lock<mutex> guard(lock);
+            changed.wait(guard, [&]() { return failed || produced > i; });
+            if (produced <= i) {
+                throw runtime_error("Failed reading the external graph file.");
+            }
+            return buffers.get() + (i % 2) * blockSize;
+        }
+
+        void release() {
+            {
+                lock_guard<mutex> guard(lock);
+                consumed++;
+            }
+            changed.notify_all();
+        }
+    };
+
+    /**
+     * Writes sorted (vertex, target) pairs as the records of consecutive blocks and adds an index entry per block
+     * to a run file, so the index does not have to fit in memory while the graph is built.
+     */
+    class BlockWriter{
+    private:
+        int fd;
+        uint64_t offset;
+        size_t blockSize;
+        Buffer<char> block;
+        size_t used;
+        RunWriter<uint64_t> &index;
+        ExternalGraph::Stats &stats;
+        bool recordOpen;
+        uint32_t vertex;
+        size_t countPosition;
+        uint32_t count;
+        uint64_t blocks;
+        uint64_t entries;
+
+        void putWord(uint32_t word) {
+            memcpy(block.get() + used, &word, sizeof(word));
+            used += sizeof(word);
+        }
+
+        void closeRecord() {
+            if (recordOpen) {
+                memcpy(block.get() + countPosition, &count, sizeof(count));
+                recordOpen = false;
+            }
+        }
+
+        void finishBlock() {
+            if (used + sizeof(uint32_t) <= blockSize) {
+                putWord(END_OF_BLOCK);
+            }
+            memset(block.get() + used, 0, blockSize - used);
+            writeAll(fd, block.get(), blockSize, offset);
+            stats.bytesWritten += static_cast<long long>(blockSize);
+            offset += blockSize;
+            used = 0;
+            blocks++;
+        }
+
+        void startRecord(uint32_t u, bool continuation) {
+            if (used + 3 * sizeof(uint32_t) > blockSize) { // The header and one target must fit
+                finishBlock();
+            }
+            if (used == 0) {
+                index.put(static_cast<uint64_t>(u) << 1 | (continuation ? 1 : 0));
+            }
+            putWord(u);
+            countPosition = used;
+            putWord(0);
+            recordOpen = true;
+            vertex = u;
+            count = 0;
+        }
+
+    public:
+        BlockWriter(int file, uint64_t start, size_t size, RunWriter<uint64_t> &blockIndex, MemoryBudget &memory, ExternalGraph::Stats &counters)
+            : fd(file), offset(start), blockSize(size), block(memory, size), used(0), index(blockIndex), stats(counters),
+              recordOpen(false), vertex(0), countPosition(0), count(0), blocks(0), entries(0) {}
+
+        void put(uint32_t u, uint32_t v) {
+            if (!recordOpen || u != vertex) {
+                closeRecord();
+                startRecord(u, false);
+            } else if (used + sizeof(uint32_t) > blockSize) {
+                closeRecord();
+                finishBlock();
+                startRecord(u, true);
+            }
+            putWord(v);
+            count++;
+            entries++;
+        }
+
+        // Ends the section and returns the number of its blocks
+        uint64_t finishSection() {
+            closeRecord();
+            if (used > 0) {
+                finishBlock();
+            }
+            uint64_t sectionBlocks = blocks;
+            blocks = 0;
+            return sectionBlocks;
+        }
+
+        uint64_t getOffset() const {
+            return offset;
+        }
+
+        uint64_t getEntries() const {
+            return entries;
+        }
+    };
+
+    void checkOptions(const ExternalGraph::Options &options) {
+        if (options.blockSize < MIN_BLOCK_SIZE || options.blockSize % sizeof(uint32_t) != 0 || options.blockSize > 0x7fffffffu) {
+            throw invalid_argument("Invalid options: The block size must be a multiple of 4 of at least 64 bytes.");
+        }
+        if (options.memoryBytes < 2 * options.blockSize + 8 * ioBytesFor(options.memoryBytes)) {
+            throw invalid_argument("Invalid options: The memory cap must hold two blocks and eight I/O buffers.");
+        }
+    }
+
+    /**
+     * @brief Writes an external graph file from a stream of edges, sorting them in runs under the memory cap.
+     *
+     * @param produce Called once with a function that adds the edge u->v; self loops and repeated edges are dropped.
+     * @param produceBytes The memory produce holds while it runs, charged before the sort buffers are sized.
+     * @param vertexNum The number of vertices, or -1 for the largest id plus one.
+     */
+    void writeGraph(const function<void(const function<void(int u, int v)> &add)> &produce, size_t produceBytes, int vertexNum,
+                    bool directed, const string &path, const ExternalGraph::Options &options) {
+        checkOptions(options);
+        ExternalGraph::Stats stats;
+        MemoryBudget budget(options.memoryBytes);
+        unique_ptr<Charge> producer(new Charge(budget, produceBytes));
+        size_t io = ioBytesFor(options.memoryBytes);
+        size_t reserved = options.blockSize + 4 * io;
+        size_t sortBytes = budget.available() > reserved ? (budget.available() - reserved) / (directed ? 2 : 1) : 0;
+        unique_ptr<RunSorter<uint64_t>> forward(new RunSorter<uint64_t>(budget, options.tempDir, sortBytes, io, stats));
+        unique_ptr<RunSorter<uint64_t>> reverse(directed ? new RunSorter<uint64_t>(budget, options.tempDir, sortBytes, io, stats) : nullptr);
+        int maxVertex = -1;
+        produce([&](int u, int v) {
+            maxVertex = max(maxVertex, max(u, v));
+            if (u != v) {
+                forward->put(static_cast<uint64_t>(u) << 32 | static_cast<uint32_t>(v));
+                if (reverse) {
+                    reverse->put(static_cast<uint64_t>(v) << 32 | static_cast<uint32_t>(u));
+                }
+            }
+        });
+        producer.reset();
+        if (reverse) {
+            reverse->finish(true); // Leaves all of the memory to the merge of the forward section
+        }
+
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1) {
+            throw runtime_error("Cannot open graph file for writing: " + path);
+        }
+        try {
+            ExternalGraphHeader header;
+            memset(&header, 0, sizeof(header));
+            memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = ExternalGraph::VERSION;
+            header.flags = directed ? ExternalGraph::FLAG_DIRECTED : 0;
+            header.blockSize = static_cast<uint32_t>(options.blockSize);
+            header.vertexNum = static_cast<uint64_t>(vertexNum >= 0 ? vertexNum : maxVertex + 1);
+            header.dataOffset = (sizeof(header) + 63) & ~static_cast<uint64_t>(63);
+
+            TempFile index(options.tempDir);
+            {
+                RunWriter<uint64_t> indexWriter(index, budget, io, stats);
+                BlockWriter writer(fd, header.dataOffset, options.blockSize, indexWriter, budget, stats);
+                forward->forEachUnique([&](uint64_t key) { writer.put(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key)); });
+                forward.reset();
+                header.forwardBlocks = writer.finishSection();
+                header.entryNum = writer.getEntries();
+                if (reverse) {
+                    reverse->forEachUnique([&](uint64_t key) { writer.put(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key)); });
+                    header.reverseBlocks = writer.finishSection();
+                }
+                header.indexOffset = writer.getOffset();
+                indexWriter.flush();
+            }
+            Buffer<char> copy(budget, io);
+            for (uint64_t offset = 0; offset < index.getSize();) {
+                size_t bytes = index.read(copy.get(), copy.size(), offset, stats);
+                writeAll(fd, copy.get(), bytes, header.indexOffset + offset);
+                offset += bytes;
+            }
+            writeAll(fd, &header, sizeof(header), 0);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+    }
+}
+
+/**
+ * @brief Default constructor; open must be called before any query.
+ */
+ExternalGraph::ExternalGraph() : fd(-1) {
+    memset(&header, 0, sizeof(header));
+}
+
+/**
+ * @brief Constructor that opens the given external graph file.
+ *
+ * @param path The path of a file written by build or buildFromEdgeList.
+ * @param queryOptions The memory cap and temporary directory of the queries.
+ */
+ExternalGraph::ExternalGraph(const std::string &path, const Options &queryOptions) : ExternalGraph() {
+    options = queryOptions;
+    open(path);
+}
+
+/**
+ * @brief Destructor for the ExternalGraph class; closes the file.
+ */
+ExternalGraph::~ExternalGraph() {
+    close();
+}
+
+void ExternalGraph::close() {
+    if (fd != -1) {
+        ::close(fd);
+        fd = -1;
+    }
+    index.clear();
+}
+
+/**
+ * @brief Writes the out-neighbours of a graph (and its in-neighbours if it is directed) to an external graph file.
+ *
+ * @param g The graph to be written; its weights are dropped.
+ * @param path The path of the file to create.
+ * @param options The block size of the file, the memory cap of the build and its temporary directory.
+ */
+void ExternalGraph::build(const Graph &g, const std::string &path, const Options &options) {
+    TRACE_SPAN("ExternalGraph::build");
+    const vector<vector<int>> &matrix = g.getAdjacencyMatrix();
+    int V = g.getVertexNum();
+    writeGraph([&](const function<void(int, int)> &add) {
+        for (int u = 0; u < V; ++u) {
+            for (int v = 0; v < V; ++v) {
+                if (matrix[u][v] != 0) {
+                    add(u, v);
+                }
+            }
+        }
+    }, 0, V, g.getIsDirected(), path, options);
+}
+
+/**
+ * @brief Converts an edge list text file to an external graph file without holding the graph in memory.
+ *
+ * The text is streamed with GraphParser::streamEdgeListFile in chunks of 1/64 of the cap (at least 1 KiB), whose
+ * buffer and edges are charged to the cap, and the edges are sorted in runs under the rest of it. A line longer than
+ * the chunk is rejected. Edges of weight 0 are skipped; the number of vertices is the largest id plus one.
+ *
+ * @param edgeListPath The path of the edge list, one "u v [w]" edge per line.
+ * @param path The path of the file to create.
+ * @param undirected Adds every edge in both directions and marks the graph undirected if true.
+ * @param options The block size of the file, the memory cap of the build and its temporary directory.
+ */
+void ExternalGraph::buildFromEdgeList(const std::string &edgeListPath, const std::string &path, bool undirected, const Options &options) {
+    TRACE_SPAN("ExternalGraph::buildFromEdgeList");
+    size_t chunkBytes = chunkBytesFor(options.memoryBytes);
+    writeGraph([&](const function<void(int, int)> &add) {
+        GraphParser::streamEdgeListFile(edgeListPath, [&](int u, int v, int weight) {
+            if (weight != 0) {
+                add(u, v);
+                if (undirected) {
+                    add(v, u);
+                }
+            }
+        }, 1, chunkBytes);
+    }, GraphParser::streamEdgeListBytes(chunkBytes), -1, !undirected, path, options);
+}
+
+/**
+ * @brief Opens an external graph file and loads its block index.
+ *
+ * The index must fit in the memory cap of the queries next to their block and I/O buffers.
+ *
+ * @param path The path of a file written by build or buildFromEdgeList.
+ */
+void ExternalGraph::open(const std::string &path) {
+    close();
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw runtime_error("Cannot open graph file: " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ExternalGraphHeader) || !readAll(fd, &header, sizeof(header), 0)) {
+        close();
+        throw invalid_argument("Invalid graph file: " + path + " is too small.");
+    }
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        close();
+        throw invalid_argument("Invalid graph file: " + path + " has a wrong magic or version.");
+    }
+    Options fileOptions = options;
+    fileOptions.blockSize = header.blockSize;
+    try {
+        checkOptions(fileOptions);
+    } catch (...) {
+        close();
+        throw;
+    }
+
+    // Every count is checked against the file size before it is multiplied, so nothing below can overflow
+    uint64_t fileSize = static_cast<uint64_t>(st.st_size);
+    uint64_t blockSize = header.blockSize;
+    if (header.vertexNum > static_cast<uint64_t>(numeric_limits<int>::max())) {
+        close();
+        throw invalid_argument("Invalid graph file: " + path + " has more vertices than an int can hold.");
+    }
+    if (header.forwardBlocks > numeric_limits<uint32_t>::max() || header.reverseBlocks > numeric_limits<uint32_t>::max() ||
+        (!getIsDirected() && header.reverseBlocks != 0)) {
+        close();
+        throw invalid_argument("Invalid graph file: " + path + " has a wrong number of blocks.");
+    }
+    uint64_t blocks = header.forwardBlocks + header.reverseBlocks;
+    if (header.dataOffset < sizeof(ExternalGraphHeader) || header.dataOffset > fileSize ||
+        blocks > (fileSize - header.dataOffset) / blockSize || header.indexOffset != header.dataOffset + blocks * blockSize ||
+        blocks > (fileSize - header.indexOffset) / sizeof(uint64_t)) {
+        close();
+        throw invalid_argument("Invalid graph file: " + path + " is truncated or its sections overlap.");
+    }
+
+    // Every query keeps the index resident next to at least two blocks and eight I/O buffers
+    size_t queryBytes = 2 * blockSize + 8 * ioBytesFor(options.memoryBytes);
+    if (blocks > (options.memoryBytes - queryBytes) / sizeof(uint64_t)) {
+        close();
+        throw runtime_error("External graph: The memory cap of " + to_string(options.memoryBytes) + " bytes cannot hold the block index.");
+    }
+    index.resize(blocks);
+    if (!readAll(fd, index.data(), blocks * sizeof(uint64_t), header.indexOffset)) {
+        close();
+        throw runtime_error("Cannot read graph file: " + path);
+    }
+    // The index of each section is searched with upper_bound, so it must be sorted, and name existing vertices
+    for (uint64_t b = 0; b < blocks; ++b) {
+        bool sectionStart = b == 0 || b == header.forwardBlocks;
+        if ((index[b] >> 1) >= header.vertexNum || (!sectionStart && index[b] < index[b - 1])) {
+            close();
+            throw invalid_argument("Invalid graph file: " + path + " has a corrupt block index.");
+        }
+    }
+}
+
+void ExternalGraph::checkVertex(int v) const {
+    if (v < 0 || v >= getVertexNum()) {
+        throw invalid_argument("Invalid vertex: The vertex does not exist.");
+    }
+}
+
+/**
+ * @brief Level-synchronous external BFS from source over one section, adding its counters to stats.
+ *
+ * @param reverse Follow the in-neighbours (the reverse section) instead of the out-neighbours.
+ * @param target Stop after the level that reaches target (-1 for none).
+ * @param visit Called with every vertex reached and its distance, level by level in increasing vertex order.
+ * @param targetDistance Set to the distance of target, -1 if it was not reached.
+ * @return long long The number of vertices reached, the source included.
+ */
+long long ExternalGraph::traverse(int source, bool reverse, int target, const std::function<void(int vertex, int distance)> &visit, int &targetDistance) {
+    TRACE_SPAN("ExternalGraph::traverse");
+    typedef chrono::steady_clock Clock;
+    Clock::time_point begin = Clock::now();
+    MemoryBudget budget(options.memoryBytes);
+    budget.acquire(index.size() * sizeof(uint64_t)); // The index stays resident
+    size_t io = ioBytesFor(options.memoryBytes);
+    size_t blockSize = header.blockSize;
+    const uint64_t *sectionIndex = index.data() + (reverse ? header.forwardBlocks : 0);
+    size_t sectionBlocks = static_cast<size_t>(reverse ? header.reverseBlocks : header.forwardBlocks);
+    uint64_t sectionOffset = header.dataOffset + (reverse ? header.forwardBlocks * blockSize : 0);
+    bool directed = getIsDirected();
+
+    unique_ptr<TempFile> frontier(new TempFile(options.tempDir));
+    unique_ptr<TempFile> previous(new TempFile(options.tempDir));
+    unique_ptr<TempFile> visited(directed ? new TempFile(options.tempDir) : nullptr);
+    uint32_t start = static_cast<uint32_t>(source);
+    frontier->append(&start, sizeof(start), stats);
+    if (visited) {
+        visited->append(&start, sizeof(start), stats);
+    }
+    long long reached = 1;
+    visit(source, 0);
+    targetDistance = source == target ? 0 : -1;
+
+    for (int level = 1; frontier->getSize() > 0 && targetDistance == -1; ++level) {
+        size_t expandBytes = 2 * blockSize + io + sectionBlocks * sizeof(uint32_t);
+        size_t mergeBytes = 3 * io;
+        size_t reserved = max(expandBytes, mergeBytes) + io;
+        if (budget.available() <= reserved) {
+            throw runtime_error("External graph: The memory cap of " + to_string(options.memoryBytes) + " bytes is too small.");
+        }
+        RunSorter<uint32_t> sorter(budget, options.tempDir, budget.available() - reserved, io, stats);
+        {
+            // The blocks holding the lists of the frontier, in file order
+            Buffer<uint32_t> blocks(budget, sectionBlocks);
+            size_t blockNum = 0;
+            {
+                RunReader<uint32_t> reader(*frontier, budget, io, stats);
+                for (; reader.valid(); reader.advance()) {
+                    uint64_t x = reader.value();
+                    size_t hi = static_cast<size_t>(upper_bound(sectionIndex, sectionIndex + sectionBlocks, x << 1 | 1) - sectionIndex);
+                    if (hi == 0) {
+                        continue;
+                    }
+                    size_t lo = --hi;
+                    while (lo > 0 && sectionIndex[lo] == (x << 1 | 1)) { // Blocks continuing the list of x
+                        lo--;
+                    }
+                    for (size_t b = lo; b <= hi; ++b) {
+                        if (blockNum == 0 || blocks.get()[blockNum - 1] < b) {
+                            blocks.get()[blockNum++] = static_cast<uint32_t>(b);
+                        }
+                    }
+                }
+            }
+
+            BlockPrefetcher prefetcher(fd, sectionOffset, blockSize, blocks.get(), blockNum, budget);
+            RunReader<uint32_t> reader(*frontier, budget, io, stats);
+            for (size_t i = 0; i < blockNum; ++i) {
+                const char *block = prefetcher.acquire(i);
+                for (size_t position = 0; position + 2 * sizeof(uint32_t) <= blockSize;) {
+                    uint32_t vertex, count;
+                    memcpy(&vertex, block + position, sizeof(vertex));
+                    if (vertex == END_OF_BLOCK) {
+                        break;
+                    }
+                    memcpy(&count, block + position + sizeof(vertex), sizeof(count));
+                    position += 2 * sizeof(uint32_t);
+                    if (vertex >= header.vertexNum || count > (blockSize - position) / sizeof(uint32_t)) {
+                        throw runtime_error("External graph: Block " + to_string(blocks.get()[i]) + " of the graph file is corrupt.");
+                    }
+                    if (reader.contains(vertex)) {
+                        for (uint32_t k = 0; k < count; ++k) {
+                            uint32_t v;
+                            memcpy(&v, block + position + k * sizeof(uint32_t), sizeof(v));
+                            if (v >= header.vertexNum) {
+                                throw runtime_error("External graph: Block " + to_string(blocks.get()[i]) + " of the graph file is corrupt.");
+                            }
+                            sorter.put(v);
+                        }
+                        stats.edgesScanned += count;
+                    }
+                    position += count * sizeof(uint32_t);
+                }
+                prefetcher.release();
+            }
+            stats.blocksRead += static_cast<long long>(blockNum);
+            stats.bytesRead += static_cast<long long>(blockNum * blockSize);
+        }
+
+        // The next frontier: the new neighbours minus the vertices seen in the last two levels or ever
+        sorter.finish();
+        unique_ptr<TempFile> next(new TempFile(options.tempDir));
+        {
+            RunWriter<uint32_t> writer(*next, budget, io, stats);
+            RunReader<uint32_t> seen(directed ? *visited : *previous, budget, io, stats);
+            unique_ptr<RunReader<uint32_t>> current(directed ? nullptr : new RunReader<uint32_t>(*frontier, budget, io, stats));
+            sorter.forEachUnique([&](uint32_t v) {
+                if (seen.contains(v) || (current && current->contains(v))) {
+                    return;
+                }
+                writer.put(v);
+                reached++;
+                visit(static_cast<int>(v), level);
+                if (static_cast<int>(v) == target) {
+                    targetDistance = level;
+                }
+            });
+            writer.flush();
+        }
+        stats.levels++;
+
+        if (visited && targetDistance == -1) {
+            unique_ptr<TempFile> merged(new TempFile(options.tempDir));
+            {
+                RunWriter<uint32_t> writer(*merged, budget, io, stats);
+                RunReader<uint32_t> a(*visited, budget, io, stats);
+                RunReader<uint32_t> b(*next, budget, io, stats);
+                while (a.valid() || b.valid()) {
+                    if (!b.valid() || (a.valid() && a.value() < b.value())) {
+                        writer.put(a.value());
+                        a.advance();
+                    } else {
+                        writer.put(b.value());
+                        b.advance();
+                    }
+                }
+                writer.flush();
+            }
+            visited = move(merged);
+        }
+        previous = move(frontier);
+        frontier = move(next);
+    }
+
+    stats.peakMemoryBytes = max(stats.peakMemoryBytes, budget.getPeak());
+    stats.seconds += chrono::duration<double>(Clock::now() - begin).count();
+    return reached;
+}
+
+/**
+ * @brief Runs a BFS from source, reporting every vertex reached with its distance in edges.
+ *
+ * @param source The starting vertex.
+ * @param visit Called level by level, in increasing vertex order within a level.
+ * @return long long The number of vertices reached, the source included.
+ */
+long long ExternalGraph::BFS(int source, const std::function<void(int vertex, int distance)> &visit) {
+    checkVertex(source);
+    stats = Stats();
+    int unused;
+    return traverse(source, false, -1, visit, unused);
+}
+
+/**
+ * @brief Returns the number of edges on a shortest path from source to target, -1 if there is none.
+ *
+ * The search stops after the level that reaches target.
+ */
+int ExternalGraph::distance(int source, int target) {
+    checkVertex(source);
+    checkVertex(target);
+    stats = Stats();
+    int targetDistance;
+    traverse(source, false, target, [](int, int) {}, targetDistance);
+    return targetDistance;
+}
+
+/**
+ * @brief Checks if the graph is connected, like Algorithms::isConnected: a directed graph must be strongly
+ * connected, which takes a BFS from vertex 0 on the out-neighbours and one on the in-neighbours.
+ *
+ * @return int Returns 1 if the graph is connected, 0 otherwise.
+ */
+int ExternalGraph::isConnected() {
+    stats = Stats();
+    if (getVertexNum() == 0) {
+        return 0;
+    }
+    int unused;
+    long long V = getVertexNum();
+    if (traverse(0, false, -1, [](int, int) {}, unused) != V) {
+        return 0;
+    }
+    if (getIsDirected() && traverse(0, true, -1, [](int, int) {}, unused) != V) {
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,134 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "Graph.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * On-disk layout of an external graph file (version 1, native byte order):
+ *
+ *   ExternalGraphHeader, padded to dataOffset
+ *   forward section: forwardBlocks blocks of blockSize bytes holding the out-neighbours, in vertex order
+ *   reverse section: reverseBlocks blocks holding the in-neighbours (directed graphs only)
+ *   index:           uint64 per block, forward then reverse: its first vertex << 1, | 1 if it continues that list
+ *
+ * A block holds records "uint32 vertex | uint32 count | uint32 targets[count]" in increasing vertex order, ended by
+ * a vertex of 0xffffffff or by the end of the block. A list that does not fit goes on in the next blocks.
+ */
+struct ExternalGraphHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t blockSize;
+    uint64_t vertexNum;
+    uint64_t entryNum;
+    uint64_t dataOffset;
+    uint64_t forwardBlocks;
+    uint64_t reverseBlocks;
+    uint64_t indexOffset;
+};
+
+// The block size of a new file, the RAM cap and the temporary directory of an ExternalGraph
+struct ExternalGraphOptions {
+    size_t memoryBytes = 64 << 20; // RAM cap of build and of every query
+    size_t blockSize = 64 << 10;   // Bytes per adjacency block, fixed when the file is built
+    std::string tempDir = "/tmp";  // Where the run files are created
+};
+
+// Counters of the last query of an ExternalGraph
+struct ExternalGraphStats {
+    long long edgesScanned = 0;
+    long long blocksRead = 0;
+    long long bytesRead = 0;
+    long long bytesWritten = 0;
+    int levels = 0;
+    int runFiles = 0;
+    size_t peakMemoryBytes = 0;
+    double seconds = 0;
+
+    double edgesPerSecond() const{
+        return seconds > 0 ? static_cast<double>(edgesScanned) / seconds : 0;
+    }
+};
+
+/**
+ * Breadth-first search and connectivity for graphs larger than memory, over an external graph file.
+ *
+ * No array of V entries is kept in memory, only the block index. Every BFS level (Munagala-Ranade):
+ * - The frontier is a sorted run file. The blocks holding its lists are looked up in the index and read in file
+ *   order by a prefetch thread into two block buffers, skipping the others; the neighbours go to an external sorter.
+ * - The sorter spills sorted runs to temporary files and merges them, in several passes if there are too many. The
+ *   merged neighbours minus the last two levels (undirected) or minus every visited vertex (directed, a sorted file
+ *   merged with each new level) are the next frontier.
+ * The buffers, sort runs, merge readers and heaps, the index, and the parser chunk and edges of buildFromEdgeList
+ * (which reads 1/64 of the cap at a time) are charged against Options::memoryBytes: open refuses an index the cap
+ * cannot hold next to a query, and a build or query that would need more throws. Not charged are the stack of the
+ * prefetch thread and a few dozen bytes of bookkeeping per temporary file. getStats reports the peak of the charged
+ * bytes, the I/O and the edges scanned per second of the last query. Temporary files are unlinked as soon as they
+ * are created. Weights are not stored: distances are numbers of edges.
+ */
+class ExternalGraph{
+public:
+    typedef ExternalGraphOptions Options;
+    typedef ExternalGraphStats Stats;
+
+private:
+    int fd;
+    ExternalGraphHeader header;
+    std::vector<uint64_t> index;
+    Options options;
+    Stats stats;
+
+    void close();
+    void checkVertex(int v) const;
+    long long traverse(int source, bool reverse, int target, const std::function<void(int vertex, int distance)> &visit, int &targetDistance);
+
+public:
+    static const uint32_t VERSION = 1;
+    static const uint32_t FLAG_DIRECTED = 1u << 0;
+
+    //methods
+    static void build(const Graph &g, const std::string &path, const Options &options = Options());
+    static void buildFromEdgeList(const std::string &edgeListPath, const std::string &path, bool undirected, const Options &options = Options());
+    void open(const std::string &path);
+    long long BFS(int source, const std::function<void(int vertex, int distance)> &visit);
+    int distance(int source, int target);
+    int isConnected();
+
+    //constructors
+    ExternalGraph();
+    explicit ExternalGraph(const std::string &path, const Options &queryOptions = Options());
+    ExternalGraph(const ExternalGraph &) = delete;
+    ExternalGraph &operator=(const ExternalGraph &) = delete;
+
+    ~ExternalGraph();
+
+    int getVertexNum() const{
+        return static_cast<int>(header.vertexNum);
+    }
+
+    long long getEdgesNum() const{
+        return getIsDirected() ? static_cast<long long>(header.entryNum) : static_cast<long long>(header.entryNum / 2);
+    }
+
+    bool getIsDirected() const{
+        return (header.flags & FLAG_DIRECTED) != 0;
+    }
+
+    size_t getBlockSize() const{
+        return header.blockSize;
+    }
+
+    long long getBlockNum() const{
+        return static_cast<long long>(header.forwardBlocks + header.reverseBlocks);
+    }
+
+    // Counters of the last BFS, distance or isConnected call
+    const Stats &getStats() const{
+        return stats;
+    }
+};
@@ -1,170 +1,306 @@
-//mail: guyes134@gmail.com
-
-#include "Graph.hpp"
-#include <functional>
-
-using namespace std;
-
-/**
- * @brief Constructor to initialize the Graph with a given adjacency matrix and properties.
- *
- * @param matrix The adjacency matrix representing the graph.
- * @param direction Specifies if the graph is directed (true) or undirected (false).
- * @param negWeight Specifies if the graph contains negative weights (true) or not (false).
- * @param weight Specifies if the graph is weighted (true) or unweighted (false).
- * @param verNum The number of vertices in the graph.
- * @param edgNum The number of edges in the graph.
- */
-Graph::Graph(std::vector<std::vector<int>> matrix, bool direction, bool negWeight, bool weight, int verNum, int edgNum) {
-    this->adjacencyMatrix = matrix;
-    this->isDirected = direction;
-    this->isWeighted = weight;
-    this->vertexNum = verNum;
-    this->edgesNum = edgNum;
-    this->hasNegWeight = negWeight;
-}
-
-/**
- * @brief Default constructor for the Graph class.
- *
- * Initializes an empty graph with no vertices or edges, and sets default properties for direction,
- * weight, and negative weight.
- */
-Graph::Graph() : vertexNum(0), edgesNum(0), isDirected(false), isWeighted(false), hasNegWeight(0) {}
-
-/**
- * @brief Destructor for the Graph class.
- *
- * Clears the adjacency matrix to free memory.
- */
-Graph::~Graph() {
-    adjacencyMatrix.clear();
-}
-
-/**
- * @brief Loads a new graph from the given adjacency matrix.
- *
- * Updates the number of vertices and edges, and determines if the graph is directed,
- * weighted, or has negative weights.
- *
- * @param matrix The adjacency matrix representing the graph.
- */
-void Graph::loadGraph(const vector<vector<int>> &matrix) {
-    this->adjacencyMatrix.clear();
-    this->vertexNum = 0;
-    this->edgesNum = 0;
-
-    if (!isSquare(matrix)) {
-        throw invalid_argument("Invalid graph: The graph is not a square matrix.");
-    }
-    this->adjacencyMatrix = matrix;
-    this->vertexNum = matrix.size();
-    int countEdges = 0;
-
-    if (isDirectedGraph()) {
-        isDirected = true;
-    }
-
-    if (isWeightedGraph()) {
-        isWeighted = true;
-    }
-
-    if (hasNegativeWeights()) {
-        hasNegWeight = true;
-    }
-
-    for (int i = 0; i < vertexNum; ++i) {
-        for (int j = 0; j < vertexNum; ++j) {
-            if (adjacencyMatrix[i][j] != 0) {
-                countEdges++;
-            }
-        }
-    }
-    this->edgesNum = isDirected ? countEdges : countEdges / 2;
-}
-
-/**
- * @brief Prints the adjacency matrix of the graph to the console.
- */
-void Graph::printGraph() {
-    for (int i = 0; i < this->vertexNum; ++i) {
-        for (int j = 0; j < this->vertexNum; ++j) {
-            cout << this->adjacencyMatrix[i][j] << " ";
-        }
-        cout << endl;
-    }
-}
-
-/**
- * @brief Checks if the given matrix is a square matrix (the number of rows equals the number of columns).
- *
- * @param matrix The matrix to be checked.
- * @return bool Returns true if the matrix is square, false otherwise.
- */
-bool Graph::isSquare(const vector<vector<int>> &matrix) const {
-    auto numRows = matrix.size();
-    for (const auto &row: matrix) {
-        if (row.size() != numRows) {
-            return false;
-        }
-    }
-    return true;
-}
-
-/**
- * @brief Determines if the graph is weighted by checking if any edge weight is not 0 or 1.
- *
- * @return bool Returns true if the graph is weighted, false otherwise.
- */
-bool Graph::isWeightedGraph() const {
-    for (const auto& row : adjacencyMatrix) {
-        for (int weight : row) {
-            if (weight != 0 && weight != 1) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-/**
- * @brief Checks if the graph has negative weights.
- *
- * @return bool Returns true if the graph has negative weights, false otherwise.
- */
-bool Graph::hasNegativeWeights() const {
-    for (size_t i = 0; i < adjacencyMatrix.size(); ++i) {
-        for (size_t j = 0; j < adjacencyMatrix.size(); ++j) {
-            if (adjacencyMatrix[i][j] < 0) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-/**
- * @brief Determines if the graph is directed by checking if the adjacency matrix is symmetric.
- *
- * @return bool Returns true if the graph is directed, false otherwise.
- */
-bool Graph::isDirectedGraph() const {
-    for (size_t i = 0; i < adjacencyMatrix.size(); ++i) {
-        for (size_t j = i + 1; j < getAdjacencyMatrix().size(); ++j) {
-            if (adjacencyMatrix[i][j] != adjacencyMatrix[j][i]) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-/**
- * @brief Checks if the current graph and the given graph have the same size adjacency matrix.
- *
- * @param graph The graph to compare with.
- * @return bool Returns true if both graphs have the same size adjacency matrix, false otherwise.
- */
-bool Graph::isTheSameSize(const Graph &graph) const {
-    return getAdjacencyMatrix().size() == graph.getAdjacencyMatrix().size();
-}
+//mail: guyes134@gmail.com
+
+#include "Graph.hpp"
+#include "Trace.hpp"
+#include "ResultWriter.hpp"
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+ * @brief Constructor to initialize the Graph with a given adjacency matrix and properties.
+ *
+ * The matrix is moved into the graph, so a caller passing std::move(matrix) hands over its storage without a copy.
+ * The given properties are trusted and not recomputed.
+ *
+ * @param matrix The adjacency matrix representing the graph.
+ * @param direction Specifies if the graph is directed (true) or undirected (false).
+ * @param negWeight Specifies if the graph contains negative weights (true) or not (false).
+ * @param weight Specifies if the graph is weighted (true) or unweighted (false).
+ * @param verNum The number of vertices in the graph.
+ * @param edgNum The number of edges in the graph.
+ */
+template <typename Weight>
+BasicGraph<Weight>::BasicGraph(std::vector<std::vector<Weight>> matrix, bool direction, bool negWeight, bool weight, int verNum, int edgNum)
+    : vertexNum(verNum), edgesNum(edgNum), isDirected(direction), isWeighted(weight), hasNegWeight(negWeight), adjacencyMatrix(std::move(matrix)) {}
+
+/**
+ * @brief Default constructor for the Graph class.
+ *
+ * Initializes an empty graph with no vertices or edges, and sets default properties for direction,
+ * weight, and negative weight.
+ */
+template <typename Weight>
+BasicGraph<Weight>::BasicGraph() : vertexNum(0), edgesNum(0), isDirected(false), isWeighted(false), hasNegWeight(0) {}
+
+/**
+ * @brief Copy constructor; the properties already computed for graph are copied along with the matrix.
+ */
+template <typename Weight>
+BasicGraph<Weight>::BasicGraph(const BasicGraph &graph) : vertexNum(graph.vertexNum), adjacencyMatrix(graph.adjacencyMatrix) {
+    copyProperties(graph);
+}
+
+/**
+ * @brief Move constructor; takes over the matrix of graph and leaves graph empty.
+ */
+template <typename Weight>
+BasicGraph<Weight>::BasicGraph(BasicGraph &&graph) : vertexNum(graph.vertexNum), adjacencyMatrix(std::move(graph.adjacencyMatrix)) {
+    copyProperties(graph);
+    graph.reset(0);
+}
+
+template <typename Weight>
+BasicGraph<Weight> &BasicGraph<Weight>::operator=(const BasicGraph &graph) {
+    if (this != &graph) {
+        this->vertexNum = graph.vertexNum;
+        this->adjacencyMatrix = graph.adjacencyMatrix;
+        copyProperties(graph);
+    }
+    return *this;
+}
+
+template <typename Weight>
+BasicGraph<Weight> &BasicGraph<Weight>::operator=(BasicGraph &&graph) {
+    if (this != &graph) {
+        this->vertexNum = graph.vertexNum;
+        this->adjacencyMatrix = std::move(graph.adjacencyMatrix);
+        copyProperties(graph);
+        graph.reset(0);
+    }
+    return *this;
+}
+
+template <typename Weight>
+void BasicGraph<Weight>::copyProperties(const BasicGraph &graph) {
+    edgesNum.store(graph.edgesNum.load(memory_order_relaxed), memory_order_relaxed);
+    isDirected.store(graph.isDirected.load(memory_order_relaxed), memory_order_relaxed);
+    isWeighted.store(graph.isWeighted.load(memory_order_relaxed), memory_order_relaxed);
+    hasNegWeight.store(graph.hasNegWeight.load(memory_order_relaxed), memory_order_relaxed);
+}
+
+/**
+ * @brief Destructor for the Graph class.
+ *
+ * Clears the adjacency matrix to free memory.
+ */
+template <typename Weight>
+BasicGraph<Weight>::~BasicGraph() {
+    adjacencyMatrix.clear();
+}
+
+/**
+ * @brief Loads a new graph from a copy of the given adjacency matrix.
+ *
+ * Updates the number of vertices; the edge count and whether the graph is directed, weighted, or has negative
+ * weights are determined when first read.
+ *
+ * @param matrix The adjacency matrix representing the graph.
+ */
+template <typename Weight>
+void BasicGraph<Weight>::loadGraph(const vector<vector<Weight>> &matrix) {
+    vector<vector<Weight>> copy;
+    {
+        TRACE_SPAN("loadGraph:copy");
+        copy = matrix;
+    }
+    loadGraph(std::move(copy));
+}
+
+/**
+ * @brief Loads a new graph from the given adjacency matrix, taking over its storage without a copy.
+ *
+ * @param matrix The adjacency matrix representing the graph; left empty unless it is invalid.
+ */
+template <typename Weight>
+void BasicGraph<Weight>::loadGraph(vector<vector<Weight>> &&matrix) {
+    TRACE_SPAN("Graph::loadGraph");
+    this->adjacencyMatrix.clear();
+    this->vertexNum = 0;
+    updateProperties();
+    {
+        TRACE_SPAN("loadGraph:isSquare");
+        if (!isSquare(matrix)) {
+            throw invalid_argument("Invalid graph: The graph is not a square matrix.");
+        }
+    }
+    this->adjacencyMatrix = std::move(matrix);
+    this->vertexNum = this->adjacencyMatrix.size();
+    updateProperties();
+}
+
+/**
+ * @brief Resets the graph to the given number of vertices and no edges.
+ *
+ * Used together with setEdge and updateProperties to build a graph in place,
+ * without first materializing a separate adjacency matrix.
+ *
+ * @param verNum The number of vertices of the new graph.
+ */
+template <typename Weight>
+void BasicGraph<Weight>::reset(int verNum) {
+    if (verNum < 0) {
+        throw invalid_argument("Invalid graph: The number of vertices is negative.");
+    }
+    this->adjacencyMatrix.assign(verNum, vector<Weight>(verNum, 0));
+    this->vertexNum = verNum;
+    this->edgesNum.store(0, memory_order_relaxed);
+    this->isDirected.store(false, memory_order_relaxed);
+    this->isWeighted.store(false, memory_order_relaxed);
+    this->hasNegWeight.store(false, memory_order_relaxed);
+}
+
+/**
+ * @brief Forgets the number of edges and whether the graph is directed, weighted, or has negative weights,
+ * so they are recomputed from the current adjacency matrix when next read. setEdge calls it on its own.
+ */
+template <typename Weight>
+void BasicGraph<Weight>::updateProperties() {
+    this->edgesNum.store(UNKNOWN, memory_order_relaxed);
+    this->isDirected.store(UNKNOWN, memory_order_relaxed);
+    this->isWeighted.store(UNKNOWN, memory_order_relaxed);
+    this->hasNegWeight.store(UNKNOWN, memory_order_relaxed);
+}
+
+template <typename Weight>
+int BasicGraph<Weight>::computeEdgesNum() const {
+    TRACE_SPAN("updateProperties:countEdges");
+    int countEdges = 0;
+    for (int i = 0; i < vertexNum; ++i) {
+        for (int j = 0; j < vertexNum; ++j) {
+            if (adjacencyMatrix[i][j] != 0) {
+                countEdges++;
+            }
+        }
+    }
+    countEdges = getIsDirected() ? countEdges : countEdges / 2;
+    edgesNum.store(countEdges, memory_order_relaxed);
+    return countEdges;
+}
+
+template <typename Weight>
+bool BasicGraph<Weight>::computeIsDirected() const {
+    TRACE_SPAN("updateProperties:isDirected");
+    bool value = isDirectedGraph();
+    isDirected.store(value, memory_order_relaxed);
+    return value;
+}
+
+template <typename Weight>
+bool BasicGraph<Weight>::computeIsWeighted() const {
+    TRACE_SPAN("updateProperties:isWeighted");
+    bool value = isWeightedGraph();
+    isWeighted.store(value, memory_order_relaxed);
+    return value;
+}
+
+template <typename Weight>
+bool BasicGraph<Weight>::computeHasNegWeight() const {
+    TRACE_SPAN("updateProperties:hasNegativeWeights");
+    bool value = hasNegativeWeights();
+    hasNegWeight.store(value, memory_order_relaxed);
+    return value;
+}
+
+/**
+ * @brief Prints the adjacency matrix of the graph to the console.
+ *
+ * The rows are streamed to standard output through the fixed buffer of a ResultWriter, so a large matrix is never
+ * built in memory as text. cout is flushed first to keep the output in order.
+ */
+template <typename Weight>
+void BasicGraph<Weight>::printGraph() {
+    cout.flush();
+    ResultWriter out(STDOUT_FILENO, ResultWriter::TEXT);
+    out.writeMatrix(*this);
+    out.flush();
+}
+
+/**
+ * @brief Checks if the given matrix is a square matrix (the number of rows equals the number of columns).
+ *
+ * @param matrix The matrix to be checked.
+ * @return bool Returns true if the matrix is square, false otherwise.
+ */
+template <typename Weight>
+bool BasicGraph<Weight>::isSquare(const vector<vector<Weight>> &matrix) const {
+    auto numRows = matrix.size();
+    for (const auto &row: matrix) {
+        if (row.size() != numRows) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Determines if the graph is weighted by checking if any edge weight is not 0 or 1.
+ *
+ * @return bool Returns true if the graph is weighted, false otherwise.
+ */
+template <typename Weight>
+bool BasicGraph<Weight>::isWeightedGraph() const {
+    for (const auto& row : adjacencyMatrix) {
+        for (Weight weight : row) {
+            if (weight != 0 && weight != 1) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Checks if the graph has negative weights.
+ *
+ * @return bool Returns true if the graph has negative weights, false otherwise.
+ */
+template <typename Weight>
+bool BasicGraph<Weight>::hasNegativeWeights() const {
+    for (size_t i = 0; i < adjacencyMatrix.size(); ++i) {
+        for (size_t j = 0; j < adjacencyMatrix.size(); ++j) {
+            if (adjacencyMatrix[i][j] < 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Determines if the graph is directed by checking if the adjacency matrix is symmetric.
+ *
+ * @return bool Returns true if the graph is directed, false otherwise.
+ */
+template <typename Weight>
+bool BasicGraph<Weight>::isDirectedGraph() const {
+    for (size_t i = 0; i < adjacencyMatrix.size(); ++i) {
+        for (size_t j = i + 1; j < getAdjacencyMatrix().size(); ++j) {
+            if (adjacencyMatrix[i][j] != adjacencyMatrix[j][i]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Checks if the current graph and the given graph have the same size adjacency matrix.
+ *
+ * @param graph The graph to compare with.
+ * @return bool Returns true if both graphs have the same size adjacency matrix, false otherwise.
+ */
+template <typename Weight>
+bool BasicGraph<Weight>::isTheSameSize(const BasicGraph<Weight> &graph) const {
+    return getAdjacencyMatrix().size() == graph.getAdjacencyMatrix().size();
+}
+
+template class BasicGraph<int8_t>;
+template class BasicGraph<int16_t>;
+template class BasicGraph<int>;
+template class BasicGraph<int64_t>;
+template class BasicGraph<float>;
+template class BasicGraph<double>;
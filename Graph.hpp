@@ -1,58 +1,99 @@
-//mail: guyes134@gmail.com
-
-#pragma once
-
-#include <vector>
-#include <iostream>
-
-
-class Graph{
-private:
-    int vertexNum;
-    int edgesNum;
-    bool isDirected;
-    bool isWeighted;
-    bool hasNegWeight;
-    std::vector<std::vector<int>> adjacencyMatrix;
-
-public:
-    //methods
-    void loadGraph(const std::vector<std::vector<int>>& matrix);
-    void printGraph();
-    bool isSquare(const std::vector<std::vector<int>> &matrix) const;
-    bool hasNegativeWeights() const;
-    bool isDirectedGraph() const;
-
-
-    //constructors
-    Graph();
-    Graph(std::vector<std::vector<int>> matrix, bool direction, bool negWeight, bool weight, int veNum, int edgNum);
-
-    ~Graph();
-
-    int getVertexNum() const{
-        return this->vertexNum;
-    }
-
-    int getEdgesNum() const{
-        return edgesNum;
-    }
-    std::vector<std::vector<int>> getAdjacencyMatrix() const{
-        return this->adjacencyMatrix;
-    }
-
-    bool getIsDirected() const{
-        return isDirected;
-    }
-
-    bool getIsWeighted() const{
-        return isWeighted;
-    }
-
-    bool getHasNegEdges() const{
-        return hasNegWeight;
-    }
-
-    bool isTheSameSize(const Graph& graph) const;
-
-    bool isWeightedGraph() const;
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "WeightTraits.hpp"
+#include <atomic>
+#include <vector>
+#include <iostream>
+
+
+/**
+ * Graph stored as an adjacency matrix of Weight (int8_t, int16_t, int, int64_t, float or double).
+ * Graph is the int instantiation used throughout the project.
+ *
+ * The derived properties (edge count, direction, weights, negative weights) are computed from the matrix the first
+ * time they are read and kept until the matrix changes. They are atomic, so threads sharing a const graph (e.g. a
+ * GraphStore snapshot) may fill them in concurrently.
+ */
+template <typename Weight>
+class BasicGraph{
+private:
+    static const int UNKNOWN = -1;
+
+    int vertexNum;
+    mutable std::atomic<int> edgesNum;
+    mutable std::atomic<signed char> isDirected;
+    mutable std::atomic<signed char> isWeighted;
+    mutable std::atomic<signed char> hasNegWeight;
+    std::vector<std::vector<Weight>> adjacencyMatrix;
+
+    int computeEdgesNum() const;
+    bool computeIsDirected() const;
+    bool computeIsWeighted() const;
+    bool computeHasNegWeight() const;
+    void copyProperties(const BasicGraph &graph);
+
+public:
+    //methods
+    void loadGraph(const std::vector<std::vector<Weight>>& matrix);
+    void loadGraph(std::vector<std::vector<Weight>>&& matrix);
+    void reset(int verNum);
+    void updateProperties();
+    void printGraph();
+    bool isSquare(const std::vector<std::vector<Weight>> &matrix) const;
+    bool hasNegativeWeights() const;
+    bool isDirectedGraph() const;
+
+
+    //constructors
+    BasicGraph();
+    BasicGraph(std::vector<std::vector<Weight>> matrix, bool direction, bool negWeight, bool weight, int veNum, int edgNum);
+    BasicGraph(const BasicGraph &graph);
+    BasicGraph(BasicGraph &&graph);
+    BasicGraph &operator=(const BasicGraph &graph);
+    BasicGraph &operator=(BasicGraph &&graph);
+
+    ~BasicGraph();
+
+    int getVertexNum() const{
+        return this->vertexNum;
+    }
+
+    int getEdgesNum() const{
+        int value = edgesNum.load(std::memory_order_relaxed);
+        return value != UNKNOWN ? value : computeEdgesNum();
+    }
+    const std::vector<std::vector<Weight>> &getAdjacencyMatrix() const{
+        return this->adjacencyMatrix;
+    }
+
+    bool getIsDirected() const{
+        signed char value = isDirected.load(std::memory_order_relaxed);
+        return value != UNKNOWN ? value != 0 : computeIsDirected();
+    }
+
+    bool getIsWeighted() const{
+        signed char value = isWeighted.load(std::memory_order_relaxed);
+        return value != UNKNOWN ? value != 0 : computeIsWeighted();
+    }
+
+    bool getHasNegEdges() const{
+        signed char value = hasNegWeight.load(std::memory_order_relaxed);
+        return value != UNKNOWN ? value != 0 : computeHasNegWeight();
+    }
+
+    void setEdge(int u, int v, Weight weight){
+        adjacencyMatrix[u][v] = weight;
+        if (edgesNum.load(std::memory_order_relaxed) != UNKNOWN || isDirected.load(std::memory_order_relaxed) != UNKNOWN ||
+            isWeighted.load(std::memory_order_relaxed) != UNKNOWN || hasNegWeight.load(std::memory_order_relaxed) != UNKNOWN) {
+            updateProperties(); // Checked first so that threads filling disjoint rows do not all write the shared flags
+        }
+    }
+
+    bool isTheSameSize(const BasicGraph& graph) const;
+
+    bool isWeightedGraph() const;
+};
+
+typedef BasicGraph<int> Graph;
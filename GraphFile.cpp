@@ -0,0 +1,356 @@
+//mail: guyes134@gmail.com
+
+#include "GraphFile.hpp"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    const char MAGIC[4] = {'G', 'R', 'P', 'H'};
+
+    size_t align8(size_t n) {
+        return (n + 7) & ~static_cast<size_t>(7);
+    }
+
+    void writePadding(ofstream &out, size_t written) {
+        static const char zeros[8] = {0};
+        out.write(zeros, align8(written) - written);
+    }
+
+    // Sets end to position + count * width, or returns false if that overflows or passes size
+    bool sectionFits(uint64_t position, uint64_t count, uint64_t width, uint64_t size, uint64_t &end) {
+        if (position > size || count > (size - position) / width) {
+            return false;
+        }
+        end = position + count * width;
+        return true;
+    }
+
+    template <typename T>
+    void writeWeights(ofstream &out, const vector<int> &values) {
+        vector<T> narrow(values.begin(), values.end());
+        out.write(reinterpret_cast<const char *>(narrow.data()), narrow.size() * sizeof(T));
+        writePadding(out, narrow.size() * sizeof(T));
+    }
+}
+
+const uint32_t MappedGraph::VERSION;
+const uint32_t MappedGraph::FLAG_DIRECTED;
+const uint32_t MappedGraph::FLAG_WEIGHTED;
+const uint32_t MappedGraph::FLAG_NEG_WEIGHT;
+const uint32_t MappedGraph::FLAG_DENSE;
+
+/**
+ * @brief Default constructor for the MappedGraph class. Nothing is mapped until open is called.
+ */
+MappedGraph::MappedGraph() : fd(-1), data(nullptr), size(0), header(nullptr), offsets(nullptr), targets(nullptr), weights(nullptr) {}
+
+/**
+ * @brief Constructor that maps the given graph file.
+ *
+ * @param path The path of a file written by MappedGraph::save.
+ */
+MappedGraph::MappedGraph(const std::string &path) : MappedGraph() {
+    open(path);
+}
+
+/**
+ * @brief Destructor for the MappedGraph class.
+ *
+ * Unmaps the file and closes its descriptor.
+ */
+MappedGraph::~MappedGraph() {
+    close();
+}
+
+/**
+ * @brief Unmaps the current file, if any.
+ */
+void MappedGraph::close() {
+    if (data != nullptr) {
+        munmap(data, size);
+    }
+    if (fd != -1) {
+        ::close(fd);
+    }
+    fd = -1;
+    data = nullptr;
+    size = 0;
+    header = nullptr;
+    offsets = nullptr;
+    targets = nullptr;
+    weights = nullptr;
+}
+
+/**
+ * @brief Writes the graph to a binary graph file.
+ *
+ * The CSR layout stores only the non-zero entries of the adjacency matrix and suits sparse graphs,
+ * the dense layout stores the whole matrix. Weights use the narrowest signed width that fits all of them.
+ *
+ * @param g The graph to be written.
+ * @param path The path of the file to create.
+ * @param dense Writes the dense matrix layout if true, the CSR layout otherwise.
+ */
+void MappedGraph::save(const Graph &g, const std::string &path, bool dense) {
+    const vector<vector<int>> &matrix = g.getAdjacencyMatrix();
+    uint64_t V = g.getVertexNum();
+    vector<uint64_t> rowOffsets(1, 0);
+    vector<uint32_t> columns;
+    vector<int> values;
+    int minWeight = 0, maxWeight = 0;
+
+    for (uint64_t u = 0; u < V; ++u) {
+        for (uint64_t v = 0; v < V; ++v) {
+            int w = matrix[u][v];
+            if (dense) {
+                values.push_back(w);
+            } else if (w != 0) {
+                columns.push_back(static_cast<uint32_t>(v));
+                values.push_back(w);
+            }
+            minWeight = min(minWeight, w);
+            maxWeight = max(maxWeight, w);
+        }
+        rowOffsets.push_back(columns.size());
+    }
+
+    GraphFileHeader header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.flags = (g.getIsDirected() ? FLAG_DIRECTED : 0) | (g.getIsWeighted() ? FLAG_WEIGHTED : 0) |
+                   (g.getHasNegEdges() ? FLAG_NEG_WEIGHT : 0) | (dense ? FLAG_DENSE : 0);
+    if (minWeight >= numeric_limits<int8_t>::min() && maxWeight <= numeric_limits<int8_t>::max()) {
+        header.weightWidth = 1;
+    } else if (minWeight >= numeric_limits<int16_t>::min() && maxWeight <= numeric_limits<int16_t>::max()) {
+        header.weightWidth = 2;
+    } else {
+        header.weightWidth = 4;
+    }
+    header.vertexNum = V;
+    header.edgesNum = g.getEdgesNum();
+    header.entryNum = dense ? V * V : columns.size();
+
+    ofstream out(path.c_str(), ios::binary | ios::trunc);
+    if (!out) {
+        throw runtime_error("Cannot open graph file for writing: " + path);
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    writePadding(out, sizeof(header));
+    if (!dense) {
+        out.write(reinterpret_cast<const char *>(rowOffsets.data()), rowOffsets.size() * sizeof(uint64_t));
+        out.write(reinterpret_cast<const char *>(columns.data()), columns.size() * sizeof(uint32_t));
+        writePadding(out, columns.size() * sizeof(uint32_t));
+    }
+    switch (header.weightWidth) {
+        case 1: writeWeights<int8_t>(out, values); break;
+        case 2: writeWeights<int16_t>(out, values); break;
+        default: writeWeights<int32_t>(out, values); break;
+    }
+    if (!out) {
+        throw runtime_error("Failed writing graph file: " + path);
+    }
+}
+
+/**
+ * @brief Maps a binary graph file into memory.
+ *
+ * Nothing is copied: the header and sections are used straight from the shared, read-only mapping, so pages are
+ * shared through the page cache between processes mapping the same file. The section sizes are checked against the
+ * file size, and the CSR offsets and targets are checked once, so a corrupt file is rejected here instead of being
+ * read out of bounds later; the weights are loaded lazily.
+ *
+ * @param path The path of a file written by MappedGraph::save.
+ */
+void MappedGraph::open(const std::string &path) {
+    close();
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw runtime_error("Cannot open graph file: " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(GraphFileHeader)) {
+        close();
+        throw invalid_argument("Invalid graph file: " + path + " is too small.");
+    }
+    size = st.st_size;
+    data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        data = nullptr;
+        close();
+        throw runtime_error("Cannot map graph file: " + path);
+    }
+
+    const char *base = static_cast<const char *>(data);
+    header = reinterpret_cast<const GraphFileHeader *>(base);
+    if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION) {
+        close();
+        throw invalid_argument("Invalid graph file: " + path + " has a wrong magic or version.");
+    }
+    uint32_t width = header->weightWidth;
+    if (width != 1 && width != 2 && width != 4) {
+        close();
+        throw invalid_argument("Invalid graph file: " + path + " has an unsupported weight width.");
+    }
+
+    uint64_t V = header->vertexNum;
+    uint64_t entries = header->entryNum;
+    if (V > static_cast<uint64_t>(numeric_limits<int>::max())) {
+        close();
+        throw invalid_argument("Invalid graph file: " + path + " has more vertices than an int can hold.");
+    }
+    if (isDense() && entries != V * V) { // V fits in an int, so V * V fits in 64 bits
+        close();
+        throw invalid_argument("Invalid graph file: " + path + " has a dense matrix of the wrong size.");
+    }
+
+    uint64_t position = align8(sizeof(GraphFileHeader));
+    uint64_t end = position;
+    bool fits = true;
+    if (!isDense()) {
+        fits = sectionFits(position, V + 1, sizeof(uint64_t), size, end);
+        offsets = reinterpret_cast<const uint64_t *>(base + position);
+        position = end;
+        fits = fits && sectionFits(position, entries, sizeof(uint32_t), size, end);
+        targets = reinterpret_cast<const uint32_t *>(base + position);
+        position = align8(end);
+    }
+    fits = fits && sectionFits(position, entries, width, size, end);
+    if (!fits) {
+        close();
+        throw invalid_argument("Invalid graph file: " + path + " is truncated.");
+    }
+    weights = base + position;
+
+    if (!isDense()) {
+        if (offsets[0] != 0) {
+            close();
+            throw invalid_argument("Invalid graph file: " + path + " has row offsets that do not start at 0.");
+        }
+        for (uint64_t v = 0; v < V; ++v) {
+            if (offsets[v + 1] < offsets[v]) {
+                close();
+                throw invalid_argument("Invalid graph file: " + path + " has decreasing row offsets.");
+            }
+        }
+        if (offsets[V] != entries) {
+            close();
+            throw invalid_argument("Invalid graph file: " + path + " has row offsets that do not end at the entry count.");
+        }
+        for (uint64_t k = 0; k < entries; ++k) {
+            if (targets[k] >= V) {
+                close();
+                throw invalid_argument("Invalid graph file: " + path + " has an edge to a vertex that does not exist.");
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reads the weight stored at the given position of the weight section.
+ *
+ * @param index The position in the weight section.
+ * @return int The weight, widened to int.
+ */
+int MappedGraph::weightAt(size_t index) const {
+    switch (header->weightWidth) {
+        case 1: return static_cast<const int8_t *>(weights)[index];
+        case 2: return static_cast<const int16_t *>(weights)[index];
+        default: return static_cast<const int32_t *>(weights)[index];
+    }
+}
+
+/**
+ * @brief Returns the number of outgoing edges of a vertex.
+ *
+ * @param v The vertex.
+ * @return int The out-degree of v.
+ */
+int MappedGraph::getDegree(int v) const {
+    if (isDense()) {
+        int degree = 0;
+        for (int u = 0; u < getVertexNum(); ++u) {
+            if (getWeight(v, u) != 0) {
+                degree++;
+            }
+        }
+        return degree;
+    }
+    return static_cast<int>(offsets[v + 1] - offsets[v]);
+}
+
+/**
+ * @brief Returns the k-th neighbour of a vertex in the CSR layout.
+ *
+ * @param v The vertex.
+ * @param k The index of the neighbour, 0 <= k < getDegree(v).
+ * @return int The neighbour.
+ */
+int MappedGraph::getNeighbour(int v, int k) const {
+    return static_cast<int>(targets[offsets[v] + k]);
+}
+
+/**
+ * @brief Returns the weight of the edge to the k-th neighbour of a vertex in the CSR layout.
+ *
+ * @param v The vertex.
+ * @param k The index of the neighbour, 0 <= k < getDegree(v).
+ * @return int The weight of the edge.
+ */
+int MappedGraph::getNeighbourWeight(int v, int k) const {
+    return weightAt(offsets[v] + k);
+}
+
+/**
+ * @brief Returns the weight of the edge from u to v, or 0 if there is no such edge.
+ *
+ * The dense layout answers in O(1), the CSR layout scans the row of u.
+ *
+ * @param u The source vertex.
+ * @param v The target vertex.
+ * @return int The weight of the edge.
+ */
+int MappedGraph::getWeight(int u, int v) const {
+    if (isDense()) {
+        return weightAt(static_cast<size_t>(u) * header->vertexNum + v);
+    }
+    for (uint64_t k = offsets[u]; k < offsets[u + 1]; ++k) {
+        if (targets[k] == static_cast<uint32_t>(v)) {
+            return weightAt(k);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Builds a Graph from the mapped file.
+ *
+ * The properties stored in the header are passed to the Graph constructor directly,
+ * so the direction, weight and negative weight scans of loadGraph are skipped.
+ *
+ * @return Graph The graph stored in the file.
+ */
+Graph MappedGraph::toGraph() const {
+    int V = getVertexNum();
+    vector<vector<int>> matrix(V, vector<int>(V, 0));
+    for (int u = 0; u < V; ++u) {
+        if (isDense()) {
+            for (int v = 0; v < V; ++v) {
+                matrix[u][v] = weightAt(static_cast<size_t>(u) * V + v);
+            }
+        } else {
+            for (uint64_t k = offsets[u]; k < offsets[u + 1]; ++k) {
+                matrix[u][targets[k]] = weightAt(k);
+            }
+        }
+    }
+    return Graph(std::move(matrix), getIsDirected(), getHasNegEdges(), getIsWeighted(), V, getEdgesNum());
+}
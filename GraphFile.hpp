@@ -0,0 +1,94 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "Graph.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * On-disk layout of a binary graph file (version 1, native byte order, every section 8-byte aligned):
+ *
+ *   GraphFileHeader
+ *   CSR layout:   uint64 offsets[V + 1] | uint32 targets[entries] | weights[entries]
+ *   dense layout: weights[V * V] (row major)
+ *
+ * Weights are stored as signed integers of weightWidth bytes (1, 2 or 4), the narrowest width that fits.
+ */
+struct GraphFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t weightWidth;
+    uint64_t vertexNum;
+    uint64_t edgesNum;
+    uint64_t entryNum;
+};
+
+class MappedGraph{
+private:
+    int fd;
+    void *data;
+    size_t size;
+    const GraphFileHeader *header;
+    const uint64_t *offsets;
+    const uint32_t *targets;
+    const void *weights;
+
+    void close();
+
+public:
+    static const uint32_t VERSION = 1;
+    static const uint32_t FLAG_DIRECTED = 1u << 0;
+    static const uint32_t FLAG_WEIGHTED = 1u << 1;
+    static const uint32_t FLAG_NEG_WEIGHT = 1u << 2;
+    static const uint32_t FLAG_DENSE = 1u << 3;
+
+    //methods
+    static void save(const Graph &g, const std::string &path, bool dense = false);
+    void open(const std::string &path);
+    Graph toGraph() const;
+    int weightAt(size_t index) const;
+
+    //constructors
+    MappedGraph();
+    explicit MappedGraph(const std::string &path);
+    MappedGraph(const MappedGraph &) = delete;
+    MappedGraph &operator=(const MappedGraph &) = delete;
+
+    ~MappedGraph();
+
+    int getVertexNum() const{
+        return static_cast<int>(header->vertexNum);
+    }
+
+    int getEdgesNum() const{
+        return static_cast<int>(header->edgesNum);
+    }
+
+    bool getIsDirected() const{
+        return (header->flags & FLAG_DIRECTED) != 0;
+    }
+
+    bool getIsWeighted() const{
+        return (header->flags & FLAG_WEIGHTED) != 0;
+    }
+
+    bool getHasNegEdges() const{
+        return (header->flags & FLAG_NEG_WEIGHT) != 0;
+    }
+
+    bool isDense() const{
+        return (header->flags & FLAG_DENSE) != 0;
+    }
+
+    int getWeightWidth() const{
+        return static_cast<int>(header->weightWidth);
+    }
+
+    int getDegree(int v) const;
+    int getNeighbour(int v, int k) const;
+    int getNeighbourWeight(int v, int k) const;
+    int getWeight(int u, int v) const;
+};
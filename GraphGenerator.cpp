@@ -0,0 +1,377 @@
+//mail: guyes134@gmail.com
+
+#include "GraphGenerator.hpp"
+#include "GraphParser.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    typedef mt19937_64 Engine;
+
+    /**
+     * SplitMix64 finalizer, used to derive an independent seed for every row or block.
+     */
+    uint64_t mix(uint64_t seed, uint64_t stream) {
+        uint64_t z = seed + 0x9e3779b97f4a7c15ULL * (stream + 1);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    double uniform(Engine &rng) {
+        return uniform_real_distribution<double>(0.0, 1.0)(rng);
+    }
+
+    int drawWeight(Engine &rng, const GraphGenerator::Options &options) {
+        if (options.minWeight == options.maxWeight) {
+            return options.minWeight == 0 ? 1 : options.minWeight;
+        }
+        int w = uniform_int_distribution<int>(options.minWeight, options.maxWeight)(rng);
+        return w == 0 ? 1 : w;
+    }
+
+    /**
+     * Calls visit(v) for every v in [begin, end) kept with probability p, jumping over the skipped ones
+     * with geometric gaps, so a row costs O(kept) draws instead of O(end - begin).
+     */
+    template <typename Visit>
+    void sampleRange(Engine &rng, int begin, int end, double p, Visit visit) {
+        if (p <= 0 || begin >= end) {
+            return;
+        }
+        if (p >= 1) {
+            for (int v = begin; v < end; ++v) {
+                visit(v);
+            }
+            return;
+        }
+        double logMiss = log(1.0 - p);
+        long long v = begin - 1;
+        while (true) {
+            double r = uniform(rng);
+            v += 1 + static_cast<long long>(floor(log(1.0 - r) / logMiss));
+            if (v >= end) {
+                return;
+            }
+            visit(static_cast<int>(v));
+        }
+    }
+
+    /**
+     * Runs work(i) for i in [0, count) on the given number of threads. Items are dealt out round-robin,
+     * which balances the triangular rows of undirected graphs.
+     */
+    template <typename Work>
+    void runItems(int count, int threads, Work work) {
+        threads = max(1, min(threads, count));
+        if (threads == 1) {
+            for (int i = 0; i < count; ++i) {
+                work(i);
+            }
+            return;
+        }
+        vector<thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(thread([=]() {
+                for (int i = t; i < count; i += threads) {
+                    work(i);
+                }
+            }));
+        }
+        for (thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    void checkProbability(double p) {
+        if (!(p >= 0 && p <= 1)) {
+            throw invalid_argument("Invalid generator: The edge probability must be in [0, 1].");
+        }
+    }
+
+    // Bounds n like the edge list parser, since the graph is a dense n x n matrix
+    void checkVertices(long long n) {
+        if (n < 0 || n > GraphParser::MAX_VERTEX_NUM) {
+            throw invalid_argument("Invalid generator: The number of vertices must be in [0, " + to_string(GraphParser::MAX_VERTEX_NUM) + "].");
+        }
+    }
+
+    // Writes the edge u-v, or u->v for directed graphs. Distinct (u, v) pairs touch distinct cells,
+    // so threads handling different rows never write the same cell.
+    void addEdge(Graph &g, int u, int v, int weight, bool directed) {
+        g.setEdge(u, v, weight);
+        if (!directed) {
+            g.setEdge(v, u, weight);
+        }
+    }
+
+    // Edges of one R-MAT block, kept so that they can be written in block order
+    struct EdgeBlock {
+        vector<pair<int, int>> edges;
+        vector<int> weights;
+    };
+
+    const long long RMAT_BLOCK = 1 << 14;
+}
+
+/**
+ * @brief Generates an Erdős–Rényi G(n, p) graph: every pair of vertices is joined with probability p.
+ *
+ * @param g The graph to be filled.
+ * @param n The number of vertices.
+ * @param p The probability of every edge.
+ * @param options The seed, threads, direction and weight range.
+ */
+void GraphGenerator::erdosRenyi(Graph &g, int n, double p, const Options &options) {
+    checkVertices(n);
+    checkProbability(p);
+    g.reset(n);
+    runItems(n, options.threads, [&](int u) {
+        Engine rng(mix(options.seed, u));
+        sampleRange(rng, options.directed ? 0 : u + 1, n, p, [&](int v) {
+            if (v != u) {
+                addEdge(g, u, v, drawWeight(rng, options), options.directed);
+            }
+        });
+    });
+    g.updateProperties();
+}
+
+/**
+ * @brief Generates an Erdős–Rényi G(n, m) graph: exactly m distinct edges chosen uniformly, without self loops.
+ *
+ * Edges are drawn by rejection. When more than half of all possible edges are requested, the complement
+ * is drawn instead and removed from the complete graph. Runs on a single stream, so options.threads is not used.
+ *
+ * @param g The graph to be filled.
+ * @param n The number of vertices.
+ * @param m The number of edges.
+ * @param options The seed, direction and weight range.
+ */
+void GraphGenerator::erdosRenyiEdges(Graph &g, int n, long long m, const Options &options) {
+    checkVertices(n);
+    long long maxEdges = static_cast<long long>(n) * (n - 1) / (options.directed ? 1 : 2);
+    if (m < 0 || m > maxEdges) {
+        throw invalid_argument("Invalid generator: The number of edges is out of range.");
+    }
+    g.reset(n);
+    Engine rng(mix(options.seed, 0));
+    uniform_int_distribution<int> vertex(0, max(n - 1, 0));
+    const vector<vector<int>> &matrix = g.getAdjacencyMatrix();
+
+    bool complement = m > maxEdges / 2;
+    if (complement) {
+        for (int u = 0; u < n; ++u) {
+            for (int v = options.directed ? 0 : u + 1; v < n; ++v) {
+                if (u != v) {
+                    addEdge(g, u, v, drawWeight(rng, options), options.directed);
+                }
+            }
+        }
+    }
+    for (long long drawn = 0, target = complement ? maxEdges - m : m; drawn < target;) {
+        int u = vertex(rng), v = vertex(rng);
+        if (u == v || (matrix[u][v] != 0) != complement) {
+            continue;
+        }
+        addEdge(g, u, v, complement ? 0 : drawWeight(rng, options), options.directed);
+        drawn++;
+    }
+    g.updateProperties();
+}
+
+/**
+ * @brief Generates an R-MAT (recursive matrix) graph with 2^scale vertices and skewed, power-law-like degrees.
+ *
+ * Every edge picks one quadrant of the matrix with probabilities a, b, c and 1 - a - b - c, scale times.
+ * Self loops are dropped and duplicate edges are merged, so the graph may have fewer than m edges.
+ * Blocks of edges are generated in parallel and written in block order.
+ *
+ * @param g The graph to be filled.
+ * @param scale The base 2 logarithm of the number of vertices.
+ * @param m The number of edges to draw.
+ * @param a The probability of the top left quadrant.
+ * @param b The probability of the top right quadrant.
+ * @param c The probability of the bottom left quadrant.
+ * @param options The seed, threads, direction and weight range.
+ */
+void GraphGenerator::rmat(Graph &g, int scale, long long m, double a, double b, double c, const Options &options) {
+    if (scale < 0 || scale > 30) {
+        throw invalid_argument("Invalid generator: The R-MAT scale must be in [0, 30].");
+    }
+    if (m < 0 || a < 0 || b < 0 || c < 0 || a + b + c > 1) {
+        throw invalid_argument("Invalid generator: Invalid R-MAT parameters.");
+    }
+    int n = 1 << scale;
+    checkVertices(n);
+    g.reset(n);
+
+    int blockNum = static_cast<int>((m + RMAT_BLOCK - 1) / RMAT_BLOCK);
+    vector<EdgeBlock> blocks(blockNum);
+    runItems(blockNum, options.threads, [&](int block) {
+        Engine rng(mix(options.seed, block));
+        long long count = min(RMAT_BLOCK, m - block * RMAT_BLOCK);
+        EdgeBlock &out = blocks[block];
+        out.edges.reserve(count);
+        out.weights.reserve(count);
+        for (long long i = 0; i < count; ++i) {
+            int u = 0, v = 0;
+            for (int bit = scale - 1; bit >= 0; --bit) {
+                double r = uniform(rng);
+                if (r >= a + b + c) {
+                    u |= 1 << bit;
+                    v |= 1 << bit;
+                } else if (r >= a + b) {
+                    u |= 1 << bit;
+                } else if (r >= a) {
+                    v |= 1 << bit;
+                }
+            }
+            out.edges.push_back(make_pair(u, v));
+            out.weights.push_back(drawWeight(rng, options));
+        }
+    });
+
+    for (const EdgeBlock &block : blocks) {
+        for (size_t i = 0; i < block.edges.size(); ++i) {
+            if (block.edges[i].first != block.edges[i].second) {
+                addEdge(g, block.edges[i].first, block.edges[i].second, block.weights[i], options.directed);
+            }
+        }
+    }
+    g.updateProperties();
+}
+
+/**
+ * @brief Generates a rows x cols grid where vertex r * cols + c is joined to its right and lower neighbours.
+ *
+ * With keep below 1 every grid edge survives with probability keep, which gives an irregular, road-like network.
+ *
+ * @param g The graph to be filled.
+ * @param rows The number of rows.
+ * @param cols The number of columns.
+ * @param keep The probability of every grid edge.
+ * @param options The seed, threads, direction and weight range. Directed grids only have right and down edges.
+ */
+void GraphGenerator::grid(Graph &g, int rows, int cols, double keep, const Options &options) {
+    if (rows < 0 || cols < 0) {
+        throw invalid_argument("Invalid generator: The grid size is negative.");
+    }
+    checkVertices(static_cast<long long>(rows) * cols);
+    checkProbability(keep);
+    g.reset(rows * cols);
+    runItems(rows, options.threads, [&](int r) {
+        Engine rng(mix(options.seed, r));
+        for (int c = 0; c < cols; ++c) {
+            int u = r * cols + c;
+            if (c + 1 < cols && uniform(rng) < keep) {
+                addEdge(g, u, u + 1, drawWeight(rng, options), options.directed);
+            }
+            if (r + 1 < rows && uniform(rng) < keep) {
+                addEdge(g, u, u + cols, drawWeight(rng, options), options.directed);
+            }
+        }
+    });
+    g.updateProperties();
+}
+
+/**
+ * @brief Generates a random DAG: the vertices are shuffled into a hidden topological order and every pair
+ * is joined from the earlier to the later vertex with probability p. The graph is always directed.
+ *
+ * @param g The graph to be filled.
+ * @param n The number of vertices.
+ * @param p The probability of every edge.
+ * @param options The seed, threads and weight range.
+ */
+void GraphGenerator::randomDAG(Graph &g, int n, double p, const Options &options) {
+    checkVertices(n);
+    checkProbability(p);
+    g.reset(n);
+    vector<int> order(n);
+    for (int i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+    Engine shuffleRng(mix(options.seed, n));
+    for (int i = n - 1; i > 0; --i) { // Fisher-Yates, the standard shuffle is not portable across libraries
+        swap(order[i], order[uniform_int_distribution<int>(0, i)(shuffleRng)]);
+    }
+
+    runItems(n, options.threads, [&](int i) {
+        Engine rng(mix(options.seed, i));
+        sampleRange(rng, i + 1, n, p, [&](int j) {
+            g.setEdge(order[i], order[j], drawWeight(rng, options));
+        });
+    });
+    g.updateProperties();
+}
+
+/**
+ * @brief Generates a random bipartite graph: vertices [0, left) on one side, [left, left + right) on the other,
+ * and every cross pair joined with probability p. Directed graphs only have edges from left to right.
+ *
+ * @param g The graph to be filled.
+ * @param left The number of vertices on the left side.
+ * @param right The number of vertices on the right side.
+ * @param p The probability of every edge.
+ * @param options The seed, threads, direction and weight range.
+ */
+void GraphGenerator::bipartite(Graph &g, int left, int right, double p, const Options &options) {
+    if (left < 0 || right < 0) {
+        throw invalid_argument("Invalid generator: The side sizes are negative.");
+    }
+    checkVertices(static_cast<long long>(left) + right);
+    checkProbability(p);
+    g.reset(left + right);
+    runItems(left, options.threads, [&](int u) {
+        Engine rng(mix(options.seed, u));
+        sampleRange(rng, left, left + right, p, [&](int v) {
+            addEdge(g, u, v, drawWeight(rng, options), options.directed);
+        });
+    });
+    g.updateProperties();
+}
+
+/**
+ * @brief Generates a directed G(n, p) graph and plants a cycle of the given length with total weight -1.
+ *
+ * The cycle visits cycleLength distinct random vertices; its edges weigh 1 except for the closing edge,
+ * which weighs -cycleLength. With non-negative weights for the random edges, every negative cycle of the graph
+ * goes through that closing edge. The graph is always directed.
+ *
+ * @param g The graph to be filled.
+ * @param n The number of vertices.
+ * @param p The probability of every random edge.
+ * @param cycleLength The number of vertices on the planted cycle (at least 3, at most n).
+ * @param options The seed, threads and weight range of the random edges.
+ */
+void GraphGenerator::plantedNegativeCycle(Graph &g, int n, double p, int cycleLength, const Options &options) {
+    if (cycleLength < 3 || cycleLength > n) {
+        throw invalid_argument("Invalid generator: The cycle length must be between 3 and the number of vertices.");
+    }
+    Options directed = options;
+    directed.directed = true;
+    erdosRenyi(g, n, p, directed);
+
+    vector<int> vertices(n);
+    for (int i = 0; i < n; ++i) {
+        vertices[i] = i;
+    }
+    Engine rng(mix(options.seed, static_cast<uint64_t>(n) + 1));
+    for (int i = 0; i < cycleLength; ++i) { // Partial Fisher-Yates picks the cycle vertices
+        swap(vertices[i], vertices[uniform_int_distribution<int>(i, n - 1)(rng)]);
+    }
+    for (int i = 0; i < cycleLength; ++i) {
+        int u = vertices[i], v = vertices[(i + 1) % cycleLength];
+        g.setEdge(u, v, i + 1 < cycleLength ? 1 : -cycleLength);
+        g.setEdge(v, u, 0); // Keep the cycle from being read as 2-cycles of an undirected graph
+    }
+    g.updateProperties();
+}
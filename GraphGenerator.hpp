@@ -0,0 +1,34 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "Graph.hpp"
+#include <cstdint>
+
+/**
+ * Seeded synthetic graphs for load tests and benchmarks.
+ *
+ * Every generator resets the graph and writes the edges straight into its matrix with setEdge, then classifies it
+ * with updateProperties. Random numbers are drawn from a stream derived from the seed and the row (or block) being
+ * generated, so the same seed gives the same graph for any number of threads.
+ * Weights are drawn uniformly from [minWeight, maxWeight]; a drawn 0 becomes 1, since 0 means "no edge".
+ * A graph may have at most GraphParser::MAX_VERTEX_NUM (32768) vertices, whose matrix takes 4 GiB (R-MAT scale 15);
+ * a larger one throws std::invalid_argument before anything is allocated.
+ */
+namespace GraphGenerator{
+    struct Options {
+        uint64_t seed = 1;
+        int threads = 1;
+        bool directed = false;
+        int minWeight = 1;
+        int maxWeight = 1;
+    };
+
+    void erdosRenyi(Graph &g, int n, double p, const Options &options = Options());
+    void erdosRenyiEdges(Graph &g, int n, long long m, const Options &options = Options());
+    void rmat(Graph &g, int scale, long long m, double a, double b, double c, const Options &options = Options());
+    void grid(Graph &g, int rows, int cols, double keep = 1.0, const Options &options = Options());
+    void randomDAG(Graph &g, int n, double p, const Options &options = Options());
+    void bipartite(Graph &g, int left, int right, double p, const Options &options = Options());
+    void plantedNegativeCycle(Graph &g, int n, double p, int cycleLength, const Options &options = Options());
+}
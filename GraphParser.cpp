@@ -0,0 +1,521 @@
+//mail: guyes134@gmail.com
+
+#include "GraphParser.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    // A range of complete lines handed to one thread
+    struct Piece {
+        const char *begin;
+        const char *end;
+    };
+
+    // The first error found in a piece, with the line counted from the start of the piece
+    struct PieceError {
+        bool failed = false;
+        long line = 0;
+        long column = 0;
+        string message;
+    };
+
+    struct Edge {
+        int u;
+        int v;
+        int weight;
+    };
+
+    struct MatrixState {
+        Graph &g;
+        int vertexNum;
+        long rows;
+        long line;
+    };
+
+    struct EdgeListState {
+        vector<Edge> edges;
+        int maxVertex;
+        int maxVertexNum;
+        long line;
+    };
+
+    inline bool isSeparator(char c) {
+        return c == ' ' || c == '\t' || c == ',' || c == '\r';
+    }
+
+    inline void skipSeparators(const char *&p, const char *end) {
+        while (p < end && isSeparator(*p)) {
+            ++p;
+        }
+    }
+
+    inline const char *lineEnd(const char *p, const char *end) {
+        const char *newline = static_cast<const char *>(memchr(p, '\n', end - p));
+        return newline == nullptr ? end : newline;
+    }
+
+    inline bool isBlankLine(const char *p, const char *end) {
+        skipSeparators(p, end);
+        return p == end;
+    }
+
+    /**
+     * Parses a signed decimal integer in place, without allocating. The number must be followed by a
+     * separator or the end of the line.
+     */
+    inline bool parseInt(const char *&p, const char *end, int &value) {
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = *p == '-';
+            ++p;
+        }
+        const char *digits = p;
+        long long result = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result = result * 10 + (*p - '0');
+            if (result > static_cast<long long>(INT_MAX) + 1) {
+                return false;
+            }
+            ++p;
+        }
+        if (p == digits || (p < end && !isSeparator(*p))) {
+            return false;
+        }
+        result = negative ? -result : result;
+        if (result > INT_MAX) {
+            return false;
+        }
+        value = static_cast<int>(result);
+        return true;
+    }
+
+    void fail(PieceError &error, long line, const char *lineStart, const char *p, const string &message) {
+        error.failed = true;
+        error.line = line;
+        error.column = static_cast<long>(p - lineStart) + 1;
+        error.message = message;
+    }
+
+    /**
+     * Splits [begin, end) into at most threads pieces, cutting only after a newline.
+     */
+    vector<Piece> splitLines(const char *begin, const char *end, int threads) {
+        vector<Piece> pieces;
+        size_t target = (end - begin) / max(threads, 1) + 1;
+        const char *p = begin;
+        while (p < end) {
+            const char *cut = end - p > static_cast<ptrdiff_t>(target) ? lineEnd(p + target, end) : end;
+            if (cut < end) {
+                ++cut;
+            }
+            pieces.push_back({p, cut});
+            p = cut;
+        }
+        return pieces;
+    }
+
+    template <typename Work>
+    void runPieces(size_t pieceNum, Work work) {
+        if (pieceNum <= 1) {
+            if (pieceNum == 1) {
+                work(0);
+            }
+            return;
+        }
+        vector<thread> workers;
+        for (size_t i = 0; i < pieceNum; ++i) {
+            workers.push_back(thread(work, i));
+        }
+        for (thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * Throws the error of the first failed piece, converting its line to a line of the whole input.
+     */
+    void throwFirstError(const vector<Piece> &pieces, const vector<PieceError> &errors, long line) {
+        for (size_t i = 0; i < pieces.size(); ++i) {
+            if (errors[i].failed) {
+                long errorLine = line + errors[i].line;
+                throw GraphParser::ParseError(errors[i].message, errorLine, errors[i].column);
+            }
+            line += count(pieces[i].begin, pieces[i].end, '\n');
+        }
+    }
+
+    long countRows(const Piece &piece) {
+        long rows = 0;
+        for (const char *p = piece.begin; p < piece.end;) {
+            const char *eol = lineEnd(p, piece.end);
+            if (!isBlankLine(p, eol)) {
+                rows++;
+            }
+            p = eol + 1;
+        }
+        return rows;
+    }
+
+    void parseMatrixPiece(const Piece &piece, long firstRow, Graph &g, int vertexNum, PieceError &error) {
+        long row = firstRow;
+        long line = 0;
+        for (const char *p = piece.begin; p < piece.end; ++line) {
+            const char *lineStart = p;
+            const char *eol = lineEnd(p, piece.end);
+            if (isBlankLine(p, eol)) {
+                p = eol + 1;
+                continue;
+            }
+            if (row >= vertexNum) {
+                fail(error, line, lineStart, p, "Invalid graph: The graph is not a square matrix (too many rows).");
+                return;
+            }
+            int column = 0;
+            skipSeparators(p, eol);
+            while (p < eol) {
+                int value;
+                if (column == vertexNum) {
+                    fail(error, line, lineStart, p, "Invalid graph: The graph is not a square matrix (too many values in row).");
+                    return;
+                }
+                if (!parseInt(p, eol, value)) {
+                    fail(error, line, lineStart, p, "Invalid graph: Expected an integer weight.");
+                    return;
+                }
+                if (value != 0) {
+                    g.setEdge(static_cast<int>(row), column, value);
+                }
+                column++;
+                skipSeparators(p, eol);
+            }
+            if (column != vertexNum) {
+                fail(error, line, lineStart, p, "Invalid graph: The graph is not a square matrix (too few values in row).");
+                return;
+            }
+            row++;
+            p = eol + 1;
+        }
+    }
+
+    /**
+     * Parses a block of complete matrix lines. The first non-blank row fixes the number of vertices.
+     */
+    void parseMatrixBlock(MatrixState &state, const char *begin, const char *end, int threads) {
+        if (state.vertexNum == -1) {
+            const char *p = begin;
+            while (p < end && isBlankLine(p, lineEnd(p, end))) {
+                p = lineEnd(p, end) + 1;
+                state.line++;
+            }
+            if (p >= end) {
+                return;
+            }
+            // Count the values of the first row, the rest of the row is parsed with the block below
+            const char *eol = lineEnd(p, end);
+            const char *q = p;
+            int vertexNum = 0;
+            skipSeparators(q, eol);
+            while (q < eol) {
+                int value;
+                if (!parseInt(q, eol, value)) {
+                    throw GraphParser::ParseError("Invalid graph: Expected an integer weight.", state.line, q - p + 1);
+                }
+                vertexNum++;
+                skipSeparators(q, eol);
+            }
+            state.vertexNum = vertexNum;
+            state.g.reset(vertexNum);
+            begin = p;
+        }
+
+        vector<Piece> pieces = splitLines(begin, end, threads);
+        vector<long> firstRows(pieces.size() + 1, state.rows);
+        vector<PieceError> errors(pieces.size());
+        vector<long> rows(pieces.size(), 0);
+
+        runPieces(pieces.size(), [&](size_t i) {
+            rows[i] = countRows(pieces[i]);
+        });
+        for (size_t i = 0; i < pieces.size(); ++i) {
+            firstRows[i + 1] = firstRows[i] + rows[i];
+        }
+        runPieces(pieces.size(), [&](size_t i) {
+            parseMatrixPiece(pieces[i], firstRows[i], state.g, state.vertexNum, errors[i]);
+        });
+        throwFirstError(pieces, errors, state.line);
+
+        state.rows = firstRows[pieces.size()];
+        state.line += count(begin, end, '\n');
+    }
+
+    void finishMatrix(MatrixState &state) {
+        if (state.vertexNum == -1) {
+            state.g.reset(0);
+        } else if (state.rows != state.vertexNum) {
+            throw GraphParser::ParseError("Invalid graph: The graph is not a square matrix (too few rows).", state.line, 1);
+        }
+        state.g.updateProperties();
+    }
+
+    void parseEdgeListPiece(const Piece &piece, int maxVertexNum, vector<Edge> &edges, int &maxVertex, PieceError &error) {
+        long line = 0;
+        for (const char *p = piece.begin; p < piece.end; ++line) {
+            const char *lineStart = p;
+            const char *eol = lineEnd(p, piece.end);
+            skipSeparators(p, eol);
+            if (p == eol || *p == '#' || *p == '%') { // Blank line or comment
+                p = eol + 1;
+                continue;
+            }
+            Edge edge;
+            edge.weight = 1;
+            const char *token = p;
+            if (!parseInt(p, eol, edge.u) || edge.u < 0) {
+                fail(error, line, lineStart, p, "Invalid edge: Expected a non-negative source vertex.");
+                return;
+            }
+            if (edge.u >= maxVertexNum) {
+                fail(error, line, lineStart, token, "Invalid edge: The source vertex is not below the limit of " + to_string(maxVertexNum) + ".");
+                return;
+            }
+            skipSeparators(p, eol);
+            token = p;
+            if (!parseInt(p, eol, edge.v) || edge.v < 0) {
+                fail(error, line, lineStart, p, "Invalid edge: Expected a non-negative target vertex.");
+                return;
+            }
+            if (edge.v >= maxVertexNum) {
+                fail(error, line, lineStart, token, "Invalid edge: The target vertex is not below the limit of " + to_string(maxVertexNum) + ".");
+                return;
+            }
+            skipSeparators(p, eol);
+            if (p < eol && !parseInt(p, eol, edge.weight)) {
+                fail(error, line, lineStart, p, "Invalid edge: Expected an integer weight.");
+                return;
+            }
+            skipSeparators(p, eol);
+            if (p < eol) {
+                fail(error, line, lineStart, p, "Invalid edge: Unexpected value after the weight.");
+                return;
+            }
+            maxVertex = max(maxVertex, max(edge.u, edge.v));
+            edges.push_back(edge);
+            p = eol + 1;
+        }
+    }
+
+    // Parses a block into one edge vector per piece, in the order of the text
+    vector<vector<Edge>> parseEdgeListPieces(EdgeListState &state, const char *begin, const char *end, int threads) {
+        vector<Piece> pieces = splitLines(begin, end, threads);
+        vector<vector<Edge>> edges(pieces.size());
+        vector<int> maxVertex(pieces.size(), -1);
+        vector<PieceError> errors(pieces.size());
+
+        runPieces(pieces.size(), [&](size_t i) {
+            parseEdgeListPiece(pieces[i], state.maxVertexNum, edges[i], maxVertex[i], errors[i]);
+        });
+        throwFirstError(pieces, errors, state.line);
+
+        for (size_t i = 0; i < pieces.size(); ++i) {
+            state.maxVertex = max(state.maxVertex, maxVertex[i]);
+        }
+        state.line += count(begin, end, '\n');
+        return edges;
+    }
+
+    void parseEdgeListBlock(EdgeListState &state, const char *begin, const char *end, int threads) {
+        vector<vector<Edge>> edges = parseEdgeListPieces(state, begin, end, threads);
+        for (const vector<Edge> &piece : edges) {
+            state.edges.insert(state.edges.end(), piece.begin(), piece.end());
+        }
+    }
+
+    void finishEdgeList(EdgeListState &state, Graph &g, bool undirected) {
+        g.reset(state.maxVertex + 1);
+        for (const Edge &edge : state.edges) {
+            g.setEdge(edge.u, edge.v, edge.weight);
+            if (undirected) {
+                g.setEdge(edge.v, edge.u, edge.weight);
+            }
+        }
+        g.updateProperties();
+    }
+
+    // Lets a line longer than the chunk double the buffer
+    inline void growBuffer() {}
+
+    /**
+     * Reads the file in chunks and hands every run of complete lines to the block parser.
+     * A line cut by the end of a chunk is carried over to the next one; a line longer than the whole chunk is passed
+     * to longLine first, which may throw to keep the buffer at its size.
+     */
+    template <typename Block, typename LongLine>
+    void streamFile(const string &path, size_t chunkBytes, Block block, LongLine longLine) {
+        ifstream in(path.c_str(), ios::binary);
+        if (!in) {
+            throw runtime_error("Cannot open graph file: " + path);
+        }
+        vector<char> buffer(max<size_t>(chunkBytes, 1));
+        size_t carry = 0;
+
+        while (true) {
+            in.read(buffer.data() + carry, buffer.size() - carry);
+            size_t filled = carry + static_cast<size_t>(in.gcount());
+            if (filled == carry) { // End of file, the remainder is the last line
+                if (carry > 0) {
+                    block(buffer.data(), buffer.data() + carry);
+                }
+                return;
+            }
+
+            size_t complete = filled;
+            while (complete > 0 && buffer[complete - 1] != '\n') {
+                complete--;
+            }
+            if (complete == 0) { // A single line longer than the buffer
+                carry = filled;
+                if (filled == buffer.size()) {
+                    longLine();
+                    buffer.resize(buffer.size() * 2);
+                }
+                continue;
+            }
+            block(buffer.data(), buffer.data() + complete);
+            copy(buffer.begin() + complete, buffer.begin() + filled, buffer.begin());
+            carry = filled - complete;
+        }
+    }
+}
+
+/**
+ * @brief Constructor for a parse error at the given position.
+ *
+ * @param message A description of the problem.
+ * @param line The 1-based line of the problem.
+ * @param column The 1-based column of the problem.
+ */
+GraphParser::ParseError::ParseError(const std::string &message, long line, long column)
+        : std::invalid_argument(message + " (line " + to_string(line) + ", column " + to_string(column) + ")"),
+          line(line), column(column) {}
+
+/**
+ * @brief Parses an adjacency matrix from a text buffer straight into the graph.
+ *
+ * Rows are lines, values are separated by whitespace and/or commas (so CSV works too), blank lines are ignored.
+ * The graph is sized from the first row and filled in place, so no intermediate matrix is built.
+ *
+ * @param data The text to parse.
+ * @param size The length of the text.
+ * @param g The graph to be filled.
+ * @param threads The number of threads to split the text between.
+ */
+void GraphParser::parseMatrix(const char *data, size_t size, Graph &g, int threads) {
+    MatrixState state = {g, -1, 0, 1};
+    parseMatrixBlock(state, data, data + size, threads);
+    finishMatrix(state);
+}
+
+/**
+ * @brief Parses an edge list from a text buffer straight into the graph.
+ *
+ * Every line holds "u v" or "u v w" (w defaults to 1), separated by whitespace and/or commas.
+ * Blank lines and lines starting with '#' or '%' are ignored. The number of vertices is the largest id plus one;
+ * an id of maxVertexNum or more is rejected before the V x V matrix is allocated.
+ *
+ * @param data The text to parse.
+ * @param size The length of the text.
+ * @param g The graph to be filled.
+ * @param undirected Adds every edge in both directions if true.
+ * @param threads The number of threads to split the text between.
+ * @param maxVertexNum The largest number of vertices accepted.
+ */
+void GraphParser::parseEdgeList(const char *data, size_t size, Graph &g, bool undirected, int threads, int maxVertexNum) {
+    EdgeListState state;
+    state.maxVertex = -1;
+    state.maxVertexNum = maxVertexNum;
+    state.line = 1;
+    parseEdgeListBlock(state, data, data + size, threads);
+    finishEdgeList(state, g, undirected);
+}
+
+/**
+ * @brief Streams an adjacency matrix file into the graph, chunk by chunk.
+ *
+ * @param path The path of the text file.
+ * @param g The graph to be filled.
+ * @param threads The number of threads to split every chunk between.
+ */
+void GraphParser::loadMatrixFile(const std::string &path, Graph &g, int threads) {
+    MatrixState state = {g, -1, 0, 1};
+    streamFile(path, CHUNK_SIZE, [&](const char *begin, const char *end) {
+        parseMatrixBlock(state, begin, end, threads);
+    }, growBuffer);
+    finishMatrix(state);
+}
+
+/**
+ * @brief Streams an edge list file into the graph, chunk by chunk.
+ *
+ * @param path The path of the text file.
+ * @param g The graph to be filled.
+ * @param undirected Adds every edge in both directions if true.
+ * @param threads The number of threads to split every chunk between.
+ * @param maxVertexNum The largest number of vertices accepted.
+ */
+void GraphParser::loadEdgeListFile(const std::string &path, Graph &g, bool undirected, int threads, int maxVertexNum) {
+    EdgeListState state;
+    state.maxVertex = -1;
+    state.maxVertexNum = maxVertexNum;
+    state.line = 1;
+    streamFile(path, CHUNK_SIZE, [&](const char *begin, const char *end) {
+        parseEdgeListBlock(state, begin, end, threads);
+    }, growBuffer);
+    finishEdgeList(state, g, undirected);
+}
+
+/**
+ * @brief Streams an edge list file to a callback, chunk by chunk, without building a graph.
+ *
+ * Only the edges of one chunk are held at a time, so the memory used does not grow with the file; it stays under
+ * streamEdgeListBytes(chunkBytes). No matrix is built, so any id below INT_MAX is accepted.
+ *
+ * @param path The path of the text file.
+ * @param edge Called with every edge in the order of the file; the weight is 1 when the line has none.
+ * @param threads The number of threads to split every chunk between.
+ * @param chunkBytes The size of the read buffer; a line that does not fit in it is rejected.
+ */
+void GraphParser::streamEdgeListFile(const std::string &path, const std::function<void(int u, int v, int weight)> &edge, int threads,
+                                     size_t chunkBytes) {
+    EdgeListState state;
+    state.maxVertex = -1;
+    state.maxVertexNum = INT_MAX;
+    state.line = 1;
+    streamFile(path, chunkBytes, [&](const char *begin, const char *end) {
+        vector<vector<Edge>> edges = parseEdgeListPieces(state, begin, end, threads);
+        for (const vector<Edge> &piece : edges) {
+            for (const Edge &e : piece) {
+                edge(e.u, e.v, e.weight);
+            }
+        }
+    }, [&]() {
+        throw ParseError("Invalid edge: The line is longer than the chunk of " + to_string(chunkBytes) + " bytes.", state.line, 1);
+    });
+}
+
+/**
+ * @brief Bounds the memory streamEdgeListFile holds at a time: the chunk and the edges parsed from it.
+ *
+ * Every edge takes at least four bytes of text ("0 1" and a line break), and its vector may hold twice the edges.
+ *
+ * @param chunkBytes The size of the read buffer.
+ * @return The largest number of bytes the buffer and the edge vectors take.
+ */
+size_t GraphParser::streamEdgeListBytes(size_t chunkBytes) {
+    return chunkBytes + 2 * (chunkBytes / 4 + 1) * sizeof(Edge);
+}
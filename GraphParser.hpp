@@ -0,0 +1,44 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "Graph.hpp"
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace GraphParser{
+    /**
+     * @brief Thrown for malformed input, carrying the 1-based line and column of the problem.
+     */
+    class ParseError : public std::invalid_argument{
+    private:
+        long line;
+        long column;
+
+    public:
+        ParseError(const std::string &message, long line, long column);
+
+        long getLine() const{
+            return line;
+        }
+
+        long getColumn() const{
+            return column;
+        }
+    };
+
+    // The default bound on the vertices of an edge list, whose dense matrix takes 4 GiB of int weights
+    const int MAX_VERTEX_NUM = 1 << 15;
+
+    // The read buffer of the file loaders
+    const size_t CHUNK_SIZE = 8 << 20;
+
+    void parseMatrix(const char *data, size_t size, Graph &g, int threads = 1);
+    void parseEdgeList(const char *data, size_t size, Graph &g, bool undirected = false, int threads = 1, int maxVertexNum = MAX_VERTEX_NUM);
+    void loadMatrixFile(const std::string &path, Graph &g, int threads = 1);
+    void loadEdgeListFile(const std::string &path, Graph &g, bool undirected = false, int threads = 1, int maxVertexNum = MAX_VERTEX_NUM);
+    void streamEdgeListFile(const std::string &path, const std::function<void(int u, int v, int weight)> &edge, int threads = 1,
+                            size_t chunkBytes = CHUNK_SIZE);
+    size_t streamEdgeListBytes(size_t chunkBytes);
+}
@@ -0,0 +1,350 @@
+//mail: guyes134@gmail.com
+
+#include "GraphReorder.hpp"
+#include "Algorithms.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+namespace {
+    // The neighbours of every vertex with edge directions ignored, in increasing order
+    vector<vector<int>> symmetricNeighbours(const Graph &g) {
+        int n = g.getVertexNum();
+        const vector<vector<int>> &matrix = g.getAdjacencyMatrix();
+        vector<vector<int>> neighbours(n);
+        for (int u = 0; u < n; ++u) {
+            const vector<int> &row = matrix[u];
+            for (int v = 0; v < n; ++v) {
+                if (u != v && row[v] != 0) {
+                    neighbours[u].push_back(v);
+                    neighbours[v].push_back(u);
+                }
+            }
+        }
+        for (vector<int> &list : neighbours) {
+            sort(list.begin(), list.end());
+            list.erase(unique(list.begin(), list.end()), list.end());
+        }
+        return neighbours;
+    }
+
+    /**
+     * @brief Appends the vertices reachable from start to order in BFS order.
+     *
+     * @param byDegree Visit the neighbours of a vertex by increasing degree instead of increasing id.
+     * @param levels Set to the number of BFS levels.
+     * @return size_t The position in order where the last level starts.
+     */
+    size_t bfs(const vector<vector<int>> &neighbours, int start, bool byDegree, vector<char> &visited, vector<int> &order, int &levels) {
+        size_t levelBegin = order.size();
+        size_t levelEnd = levelBegin + 1;
+        size_t lastLevel = levelBegin;
+        levels = 1;
+        order.push_back(start);
+        visited[start] = true;
+        vector<int> next;
+        for (size_t head = levelBegin; head < order.size(); ++head) {
+            if (head == levelEnd) {
+                lastLevel = head;
+                levelEnd = order.size();
+                levels++;
+            }
+            next.clear();
+            for (int v : neighbours[order[head]]) {
+                if (!visited[v]) {
+                    visited[v] = true;
+                    next.push_back(v);
+                }
+            }
+            if (byDegree) {
+                stable_sort(next.begin(), next.end(), [&neighbours](int a, int b) {
+                    return neighbours[a].size() < neighbours[b].size();
+                });
+            }
+            order.insert(order.end(), next.begin(), next.end());
+        }
+        return lastLevel;
+    }
+
+    /**
+     * @brief Finds a vertex of the component of start that lies far from the rest (George and Liu), a good
+     * first vertex for Cuthill-McKee: BFS again from a lowest-degree vertex of the last level while that adds levels.
+     */
+    int pseudoPeripheral(const vector<vector<int>> &neighbours, int start) {
+        vector<char> visited(neighbours.size(), false);
+        vector<int> order;
+        int eccentricity = 0;
+        while (true) {
+            for (int v : order) {
+                visited[v] = false;
+            }
+            order.clear();
+            int levels = 0;
+            size_t lastLevel = bfs(neighbours, start, false, visited, order, levels);
+            if (levels <= eccentricity) {
+                return start;
+            }
+            eccentricity = levels;
+            int candidate = order[lastLevel];
+            for (size_t i = lastLevel; i < order.size(); ++i) {
+                if (neighbours[order[i]].size() < neighbours[candidate].size()) {
+                    candidate = order[i];
+                }
+            }
+            if (candidate == start) {
+                return start;
+            }
+            start = candidate;
+        }
+    }
+}
+
+/**
+ * @brief Computes a vertex order for the graph.
+ *
+ * @param g The graph to be ordered.
+ * @param method The ordering to compute.
+ * @return std::vector<int> newToOld: the original id of every position.
+ */
+std::vector<int> GraphReorder::order(const Graph &g, Method method) {
+    TRACE_SPAN("GraphReorder::order");
+    int n = g.getVertexNum();
+    vector<vector<int>> neighbours = symmetricNeighbours(g);
+    vector<int> newToOld;
+    newToOld.reserve(n);
+
+    if (method == DEGREE_SORT) {
+        for (int v = 0; v < n; ++v) {
+            newToOld.push_back(v);
+        }
+        stable_sort(newToOld.begin(), newToOld.end(), [&neighbours](int a, int b) {
+            return neighbours[a].size() > neighbours[b].size();
+        });
+        return newToOld;
+    }
+
+    vector<char> visited(n, false);
+    int levels = 0;
+    for (int v = 0; v < n; ++v) {
+        if (visited[v]) {
+            continue;
+        }
+        if (method == REVERSE_CUTHILL_MCKEE) {
+            bfs(neighbours, pseudoPeripheral(neighbours, v), true, visited, newToOld, levels);
+        } else {
+            bfs(neighbours, v, false, visited, newToOld, levels);
+        }
+    }
+    if (method == REVERSE_CUTHILL_MCKEE) {
+        reverse(newToOld.begin(), newToOld.end());
+    }
+    return newToOld;
+}
+
+/**
+ * @brief Builds the graph with its vertices renumbered: vertex i of out is vertex newToOld[i] of g.
+ *
+ * @param g The graph to be renumbered.
+ * @param newToOld A permutation of the vertices of g.
+ * @param out The renumbered graph.
+ */
+void GraphReorder::permute(const Graph &g, const std::vector<int> &newToOld, Graph &out) {
+    TRACE_SPAN("GraphReorder::permute");
+    int n = g.getVertexNum();
+    if (static_cast<int>(newToOld.size()) != n) {
+        throw invalid_argument("Invalid order: The order does not have one entry per vertex.");
+    }
+    vector<int> oldToNew(n, -1);
+    for (int i = 0; i < n; ++i) {
+        if (newToOld[i] < 0 || newToOld[i] >= n || oldToNew[newToOld[i]] != -1) {
+            throw invalid_argument("Invalid order: The order is not a permutation of the vertices.");
+        }
+        oldToNew[newToOld[i]] = i;
+    }
+
+    const vector<vector<int>> &matrix = g.getAdjacencyMatrix();
+    out.reset(n);
+    for (int i = 0; i < n; ++i) {
+        const vector<int> &row = matrix[newToOld[i]];
+        for (int v = 0; v < n; ++v) {
+            if (row[v] != 0) {
+                out.setEdge(i, oldToNew[v], row[v]);
+            }
+        }
+    }
+    out.updateProperties();
+}
+
+/**
+ * @brief Measures how far apart the endpoints of the edges are in id order.
+ *
+ * @param g The graph to be measured.
+ * @return Locality The bandwidth and the average gap of the edges.
+ */
+GraphReorder::Locality GraphReorder::locality(const Graph &g) {
+    Locality result;
+    const vector<vector<int>> &matrix = g.getAdjacencyMatrix();
+    long long edges = 0;
+    long long gapSum = 0;
+    for (int u = 0; u < g.getVertexNum(); ++u) {
+        for (int v = 0; v < g.getVertexNum(); ++v) {
+            if (matrix[u][v] != 0) {
+                long long gap = abs(u - v);
+                result.bandwidth = max(result.bandwidth, gap);
+                gapSum += gap;
+                edges++;
+            }
+        }
+    }
+    result.averageGap = edges > 0 ? static_cast<double>(gapSum) / static_cast<double>(edges) : 0;
+    return result;
+}
+
+const char *GraphReorder::methodName(Method method) {
+    switch (method) {
+        case REVERSE_CUTHILL_MCKEE:
+            return "RCM";
+        case DEGREE_SORT:
+            return "degree";
+        default:
+            return "BFS";
+    }
+}
+
+/**
+ * @brief Default constructor for an empty reordered graph.
+ */
+ReorderedGraph::ReorderedGraph() {}
+
+/**
+ * @brief Constructor that stores g in the order computed by method.
+ *
+ * @param g The graph, in original ids.
+ * @param method The ordering to use.
+ */
+ReorderedGraph::ReorderedGraph(const Graph &g, GraphReorder::Method method) {
+    reorder(g, method);
+}
+
+/**
+ * @brief Loads a graph from the given adjacency matrix and stores it reordered.
+ *
+ * @param matrix The adjacency matrix, in original ids.
+ * @param method The ordering to use.
+ */
+void ReorderedGraph::loadGraph(const std::vector<std::vector<int>> &matrix, GraphReorder::Method method) {
+    Graph g;
+    g.loadGraph(matrix);
+    reorder(g, method);
+}
+
+/**
+ * @brief Loads a graph from the given adjacency matrix, taking over its storage, and stores it reordered.
+ *
+ * @param matrix The adjacency matrix, in original ids; left empty unless it is invalid.
+ * @param method The ordering to use.
+ */
+void ReorderedGraph::loadGraph(std::vector<std::vector<int>> &&matrix, GraphReorder::Method method) {
+    Graph g;
+    g.loadGraph(std::move(matrix));
+    reorder(g, method);
+}
+
+/**
+ * @brief Stores g in the order computed by method and measures the locality before and after.
+ *
+ * @param g The graph, in original ids.
+ * @param method The ordering to use.
+ */
+void ReorderedGraph::reorder(const Graph &g, GraphReorder::Method method) {
+    newToOld = GraphReorder::order(g, method);
+    oldToNew.assign(newToOld.size(), 0);
+    for (size_t i = 0; i < newToOld.size(); ++i) {
+        oldToNew[newToOld[i]] = static_cast<int>(i);
+    }
+    GraphReorder::permute(g, newToOld, graph);
+    before = GraphReorder::locality(g);
+    after = GraphReorder::locality(graph);
+}
+
+/**
+ * @brief Appends the original ids of stored vertices to out, separated by separator.
+ *
+ * @param vertices The vertices, in stored ids.
+ * @param reversed Appends them from the last to the first.
+ */
+void ReorderedGraph::appendOriginal(std::string &out, const std::vector<int> &vertices, bool reversed, const char *separator) const {
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        if (i > 0) {
+            out += separator;
+        }
+        out += to_string(newToOld[vertices[reversed ? vertices.size() - 1 - i : i]]);
+    }
+}
+
+int ReorderedGraph::isConnected() const {
+    return Algorithms::isConnected(graph);
+}
+
+/**
+ * @brief Finds the shortest path like Algorithms::shortestPath, with start, end and the path in original ids.
+ */
+std::string ReorderedGraph::shortestPath(int start, int end) const {
+    if (start < 0 || end < 0 || start >= graph.getVertexNum() || end >= graph.getVertexNum()) {
+        return "-1";
+    }
+    AlgorithmWorkspace ws;
+    const string &result = Algorithms::shortestPath(graph, oldToNew[start], oldToNew[end], ws);
+    if (result == "-1" || result == "Negative cycle detected") {
+        return result;
+    }
+    string path;
+    appendOriginal(path, ws.path, true, "->");
+    return path;
+}
+
+/**
+ * @brief Detects a cycle like Algorithms::isContainsCycle, with the cycle in original ids.
+ */
+std::string ReorderedGraph::isContainsCycle() const {
+    AlgorithmWorkspace ws;
+    if (Algorithms::isContainsCycle(graph, ws) == "0") {
+        return "0";
+    }
+    string result = "The cycle is: ";
+    appendOriginal(result, ws.path, true, "->");
+    return result;
+}
+
+/**
+ * @brief Checks bipartiteness like Algorithms::isBipartite, with the two sets in original ids.
+ */
+std::string ReorderedGraph::isBipartite() const {
+    AlgorithmWorkspace ws;
+    if (Algorithms::isBipartite(graph, ws) == "0") {
+        return "0";
+    }
+    string result = "The graph is bipartite: A={";
+    appendOriginal(result, ws.setA, false, ", ");
+    result += "}, B={";
+    appendOriginal(result, ws.setB, false, ", ");
+    result += "}";
+    return result;
+}
+
+/**
+ * @brief Finds a negative cycle like Algorithms::negativeCycle, with the cycle in original ids.
+ */
+std::string ReorderedGraph::negativeCycle() const {
+    vector<int> cycle;
+    if (!Algorithms::negativeCycle(graph, cycle)) {
+        return "0";
+    }
+    string result = "The negative weight cycle is: ";
+    appendOriginal(result, cycle, false, "->");
+    return result;
+}
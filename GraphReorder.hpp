@@ -0,0 +1,89 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "Graph.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * Vertex reorderings that put neighbours at nearby ids, so traversals touch fewer cache lines (and the gaps a
+ * CompressedGraph stores get shorter). An order is given as newToOld: newToOld[i] is the original id of vertex i.
+ * Directed edges are treated as undirected when ordering.
+ *
+ * - REVERSE_CUTHILL_MCKEE: BFS from a pseudo-peripheral vertex of every component, neighbours by increasing degree,
+ *   then reversed. Minimizes the bandwidth of the matrix.
+ * - DEGREE_SORT: decreasing degree, so the hubs most traversals touch share a few cache lines.
+ * - BFS_ORDER: plain BFS from the smallest id of every component, neighbours by increasing id.
+ */
+namespace GraphReorder{
+    enum Method {
+        REVERSE_CUTHILL_MCKEE,
+        DEGREE_SORT,
+        BFS_ORDER
+    };
+
+    // How far apart the endpoints of the edges are in id order
+    struct Locality {
+        long long bandwidth = 0; // The largest |u - v| of an edge
+        double averageGap = 0;   // The average |u - v| of an edge
+    };
+
+    std::vector<int> order(const Graph &g, Method method);
+    void permute(const Graph &g, const std::vector<int> &newToOld, Graph &out);
+    Locality locality(const Graph &g);
+    const char *methodName(Method method);
+}
+
+/**
+ * A graph stored in a locality-improving order that is queried in the original ids.
+ *
+ * The query methods translate their arguments to the stored ids and the vertices in their results back, so they
+ * answer like the Algorithms functions on the original graph. Among several equally good answers (two shortest paths
+ * of the same length, the order of a bipartite set) the reordered graph may pick another one.
+ */
+class ReorderedGraph{
+private:
+    Graph graph;
+    std::vector<int> newToOld;
+    std::vector<int> oldToNew;
+    GraphReorder::Locality before;
+    GraphReorder::Locality after;
+
+    void appendOriginal(std::string &out, const std::vector<int> &vertices, bool reversed, const char *separator) const;
+
+public:
+    //methods
+    void loadGraph(const std::vector<std::vector<int>> &matrix, GraphReorder::Method method);
+    void loadGraph(std::vector<std::vector<int>> &&matrix, GraphReorder::Method method);
+    void reorder(const Graph &g, GraphReorder::Method method);
+    int isConnected() const;
+    std::string shortestPath(int start, int end) const;
+    std::string isContainsCycle() const;
+    std::string isBipartite() const;
+    std::string negativeCycle() const;
+
+    //constructors
+    ReorderedGraph();
+    ReorderedGraph(const Graph &g, GraphReorder::Method method);
+
+    const Graph &getGraph() const{
+        return graph;
+    }
+
+    int toNew(int v) const{
+        return oldToNew[v];
+    }
+
+    int toOld(int v) const{
+        return newToOld[v];
+    }
+
+    const GraphReorder::Locality &getLocalityBefore() const{
+        return before;
+    }
+
+    const GraphReorder::Locality &getLocalityAfter() const{
+        return after;
+    }
+};
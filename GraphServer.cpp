@@ -0,0 +1,351 @@
+//mail: guyes134@gmail.com
+
+#include "GraphServer.hpp"
+#include "GraphParser.hpp"
+#include "Algorithms.hpp"
+#include "Trace.hpp"
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    const size_t READ_SIZE = 1 << 16;
+    const int GRAIN = 16; // Requests per chunk; a batch of at most one chunk is answered on the connection thread
+
+    bool startsWithWord(const string &request, const char *word) {
+        size_t n = strlen(word);
+        return request.compare(0, n, word) == 0 && (request.size() == n || request[n] == ' ');
+    }
+
+    // reload and quit change the state of the server or connection, so a batch is split around them
+    bool isBarrier(const string &request) {
+        return startsWithWord(request, "reload") || startsWithWord(request, "quit");
+    }
+
+    /**
+     * @brief Parses a vertex of the request starting at *p and advances p past it. The vertex must be followed by a
+     * space or the end of the request.
+     */
+    int parseVertex(const char *&p, int vertexNum) {
+        char *end = nullptr;
+        errno = 0;
+        long v = strtol(p, &end, 10);
+        if (end == p || (*end != ' ' && *end != '\0')) {
+            throw invalid_argument("Invalid request: Expected a vertex number.");
+        }
+        if (errno != 0 || v < 0 || v >= vertexNum) {
+            throw invalid_argument("Invalid vertex: The vertex does not exist.");
+        }
+        p = end;
+        return static_cast<int>(v);
+    }
+
+    // Throws if anything but spaces is left in the request
+    void expectEnd(const char *p) {
+        while (*p == ' ') {
+            ++p;
+        }
+        if (*p != '\0') {
+            throw invalid_argument("Invalid request: Unexpected input after the vertices.");
+        }
+    }
+
+    bool writeAll(int fd, const string &data) {
+        size_t written = 0;
+        while (written < data.size()) {
+            ssize_t n = write(fd, data.data() + written, data.size() - written);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            written += static_cast<size_t>(n);
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Constructor that loads the adjacency matrix file and starts one worker per hardware thread.
+ *
+ * @param path The adjacency matrix file.
+ */
+GraphServer::GraphServer(const std::string &path) : GraphServer(path, Options()) {}
+
+/**
+ * @brief Constructor that loads the graph file and starts the worker pool.
+ *
+ * @param path The graph file, an adjacency matrix or, with options.edgeList, an edge list.
+ * @param serverOptions The worker count, the file format and the batch size.
+ */
+GraphServer::GraphServer(const std::string &path, const Options &serverOptions) : graphPath(path), options(serverOptions), pool(serverOptions.threads) {
+    reload(path);
+}
+
+/**
+ * @brief Parses the graph file and publishes it as the new version of the graph.
+ *
+ * @param path The graph file to load.
+ */
+void GraphServer::reload(const std::string &path) {
+    TRACE_SPAN("GraphServer::reload");
+    Graph g;
+    if (options.edgeList) {
+        GraphParser::loadEdgeListFile(path, g, options.undirected);
+    } else {
+        GraphParser::loadMatrixFile(path, g);
+    }
+    store.publish(std::move(g));
+}
+
+/**
+ * @brief Resolves the file of a "reload file" request inside Options::reloadDir.
+ *
+ * @param file The file named by the request.
+ * @return std::string The path of the file inside the reload directory.
+ */
+std::string GraphServer::reloadPath(const std::string &file) const {
+    if (options.reloadDir.empty()) {
+        throw invalid_argument("Invalid request: Reloading another file is disabled.");
+    }
+    if (file.empty() || file == "." || file == ".." || file.find('/') != string::npos) {
+        throw invalid_argument("Invalid request: The file must be a name inside the reload directory.");
+    }
+    return options.reloadDir + "/" + file;
+}
+
+/**
+ * @brief Answers a single query request on the given graph.
+ *
+ * @param g The snapshot the query runs on.
+ * @param request The request line, without the newline.
+ * @param ws The workspace of the lane running the query.
+ * @param response Set to the response line, without the newline.
+ */
+void GraphServer::answer(const Graph &g, const std::string &request, AlgorithmWorkspace &ws, std::string &response) {
+    try {
+        if (startsWithWord(request, "path")) {
+            const char *p = request.c_str() + 4;
+            int start = parseVertex(p, g.getVertexNum());
+            int end = parseVertex(p, g.getVertexNum());
+            expectEnd(p);
+            response = Algorithms::shortestPath(g, start, end, ws);
+        } else if (request == "connected") {
+            response.assign(1, Algorithms::isConnected(g) ? '1' : '0');
+        } else if (request == "cycle") {
+            response = Algorithms::isContainsCycle(g, ws);
+        } else if (request == "bipartite") {
+            response = Algorithms::isBipartite(g, ws);
+        } else if (request == "negcycle") {
+            response = Algorithms::negativeCycle(g);
+        } else {
+            response = "error: Invalid request: unknown command";
+        }
+    } catch (const exception &e) {
+        response = "error: ";
+        response += e.what();
+    }
+}
+
+/**
+ * @brief Answers the pending requests of a connection and appends the responses to its output, in order.
+ *
+ * The queries between two barriers (reload, quit) run on one snapshot, spread over the pool in chunks.
+ *
+ * @param connection The connection; its first requestNum requests are answered.
+ */
+void GraphServer::answerBatch(Connection &connection, size_t requestNum) {
+    TRACE_SPAN("GraphServer::answerBatch");
+    if (connection.responses.size() < requestNum) {
+        connection.responses.resize(requestNum);
+    }
+    size_t i = 0;
+    while (i < requestNum && !connection.closed) {
+        size_t j = i;
+        while (j < requestNum && !isBarrier(connection.requests[j])) {
+            ++j;
+        }
+
+        if (j > i) {
+            GraphStore::Snapshot g = store.snapshot();
+            pool.parallelFor(static_cast<int>(i), static_cast<int>(j), GRAIN, [this, &g, &connection](int lane, int begin, int end) {
+                for (int k = begin; k < end; ++k) {
+                    answer(*g, connection.requests[k], connection.workspaces[lane], connection.responses[k]);
+                }
+            });
+            for (size_t k = i; k < j; ++k) {
+                connection.output += connection.responses[k];
+                connection.output += '\n';
+            }
+        }
+
+        if (j < requestNum) {
+            const std::string &request = connection.requests[j];
+            if (startsWithWord(request, "quit")) {
+                connection.closed = true;
+            } else {
+                try {
+                    reload(request.size() > 7 ? reloadPath(request.substr(7)) : graphPath);
+                    GraphStore::Snapshot g = store.snapshot();
+                    connection.output += "ok " + to_string(g->getVertexNum()) + " " + to_string(g->getEdgesNum()) + "\n";
+                } catch (const exception &e) {
+                    connection.output += "error: ";
+                    connection.output += e.what();
+                    connection.output += '\n';
+                }
+            }
+        }
+        i = j + 1;
+    }
+}
+
+/**
+ * @brief Splits the complete lines of the connection input into batches and answers them.
+ *
+ * @param connection The connection.
+ * @param atEnd The input ended, so a last line without a newline is a request too.
+ */
+void GraphServer::drain(Connection &connection, bool atEnd) {
+    size_t pos = 0;
+    while (!connection.closed) {
+        size_t requestNum = 0;
+        bool tooLong = false;
+        while (requestNum < options.maxBatch) {
+            size_t newline = connection.input.find('\n', pos);
+            if (newline == string::npos) {
+                if (connection.input.size() - pos > options.maxLineLength) {
+                    tooLong = true;
+                    break;
+                }
+                if (!atEnd || pos >= connection.input.size()) {
+                    break;
+                }
+                newline = connection.input.size();
+            }
+            size_t length = newline - pos;
+            if (length > 0 && connection.input[pos + length - 1] == '\r') {
+                length--;
+            }
+            if (length > options.maxLineLength) {
+                tooLong = true;
+                break;
+            }
+            if (length > 0) {
+                if (requestNum == connection.requests.size()) {
+                    connection.requests.emplace_back();
+                }
+                connection.requests[requestNum++].assign(connection.input, pos, length);
+            }
+            pos = min(newline + 1, connection.input.size());
+        }
+        if (requestNum > 0) {
+            answerBatch(connection, requestNum);
+        }
+        if (tooLong && !connection.closed) {
+            connection.output += "error: Invalid request: The line is longer than " + to_string(options.maxLineLength) + " bytes.\n";
+            connection.closed = true;
+        }
+        if (requestNum == 0) {
+            break;
+        }
+    }
+    connection.input.erase(0, pos);
+}
+
+/**
+ * @brief Answers a block of request lines and returns the response lines, as one connection would.
+ *
+ * @param requests The request lines.
+ * @return std::string The response lines.
+ */
+std::string GraphServer::handle(const std::string &requests) {
+    Connection connection;
+    connection.workspaces.resize(pool.concurrency(0));
+    connection.input = requests;
+    drain(connection, true);
+    return connection.output;
+}
+
+/**
+ * @brief Answers the requests read from inFd on outFd until the input ends or a quit request.
+ *
+ * Every read is answered as one batch, so pipelined requests share a write of the responses.
+ *
+ * @param inFd The descriptor the requests are read from.
+ * @param outFd The descriptor the responses are written to.
+ */
+void GraphServer::serve(int inFd, int outFd) {
+    Connection connection;
+    connection.workspaces.resize(pool.concurrency(0));
+    std::vector<char> buffer(READ_SIZE);
+    while (!connection.closed) {
+        ssize_t n = read(inFd, buffer.data(), buffer.size());
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            drain(connection, true);
+            writeAll(outFd, connection.output);
+            return;
+        }
+        connection.input.append(buffer.data(), static_cast<size_t>(n));
+        drain(connection, false);
+        if (!writeAll(outFd, connection.output)) {
+            return;
+        }
+        connection.output.clear();
+    }
+}
+
+/**
+ * @brief Listens on a Unix socket and serves every client on its own connection thread, until the process ends.
+ *
+ * The queries of all the connections share the worker pool.
+ *
+ * @param socketPath The path of the socket; an existing file there is replaced.
+ */
+void GraphServer::serveUnixSocket(const std::string &socketPath) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        throw invalid_argument("Invalid socket path: " + socketPath);
+    }
+    memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+
+    signal(SIGPIPE, SIG_IGN); // A client that disconnects early must not end the server
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        throw runtime_error("Cannot create socket: " + socketPath);
+    }
+    unlink(socketPath.c_str());
+    if (bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || listen(listener, 64) < 0) {
+        close(listener);
+        throw runtime_error("Cannot listen on socket: " + socketPath);
+    }
+
+    while (true) {
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            close(listener);
+            throw runtime_error("Cannot accept on socket: " + socketPath);
+        }
+        thread([this, client]() {
+            serve(client, client);
+            close(client);
+        }).detach();
+    }
+}
@@ -0,0 +1,77 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "GraphStore.hpp"
+#include "ThreadPool.hpp"
+#include "AlgorithmWorkspace.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * A long-running query server: loads a graph file once and answers requests on a file descriptor pair
+ * (stdin/stdout) or on a local Unix socket, one request per line and one response line per request:
+ *
+ *   connected       -> 1 or 0
+ *   path s t        -> the shortest path, e.g. 0->2->3, or -1
+ *   cycle           -> the cycle, or 0
+ *   bipartite       -> the two sets, or 0
+ *   negcycle        -> the negative cycle, or 0
+ *   reload [file]   -> ok <vertices> <edges>, reloading the startup file if none is given
+ *   quit            -> closes the connection
+ *
+ * Failed requests answer "error: <reason>". "reload file" is refused unless Options::reloadDir is set, and then only
+ * names a file directly inside that directory. A line longer than Options::maxLineLength is answered with an error
+ * and closes the connection, so a client cannot make the server buffer an unbounded line. Clients may pipeline: every request already received is answered as
+ * one batch, spread over the worker pool, and the responses are written back in request order with one write.
+ * A reload is a barrier: the requests before it see the old graph and the requests after it the new one.
+ * Queries read an immutable GraphStore snapshot, so connections keep answering while another one reloads.
+ */
+class GraphServer{
+public:
+    struct Options {
+        int threads = 0;             // Workers of the query pool, 0 for one per hardware thread
+        bool edgeList = false;       // The graph files are edge lists rather than adjacency matrices
+        bool undirected = false;     // Edge lists describe undirected graphs
+        size_t maxBatch = 4096;      // The most requests answered in one batch
+        size_t maxLineLength = 4096; // The longest request line accepted
+        std::string reloadDir;       // The directory "reload file" may load from, empty to only reload the startup file
+    };
+
+private:
+    struct Connection {
+        std::string input;
+        std::string output;
+        std::vector<std::string> requests;
+        std::vector<std::string> responses;
+        std::vector<AlgorithmWorkspace> workspaces;
+        bool closed = false;
+    };
+
+    GraphStore store;
+    std::string graphPath;
+    Options options;
+    ThreadPool pool;
+
+    void reload(const std::string &path);
+    std::string reloadPath(const std::string &file) const;
+    void answer(const Graph &g, const std::string &request, AlgorithmWorkspace &ws, std::string &response);
+    void answerBatch(Connection &connection, size_t requestNum);
+    void drain(Connection &connection, bool atEnd);
+
+public:
+    //methods
+    std::string handle(const std::string &requests);
+    void serve(int inFd, int outFd);
+    void serveUnixSocket(const std::string &socketPath);
+
+    //constructors
+    explicit GraphServer(const std::string &path);
+    GraphServer(const std::string &path, const Options &serverOptions);
+    GraphServer(const GraphServer &) = delete;
+    GraphServer &operator=(const GraphServer &) = delete;
+
+    GraphStore::Snapshot snapshot() const{
+        return store.snapshot();
+    }
+};
@@ -0,0 +1,141 @@
+//mail: guyes134@gmail.com
+
+#include "GraphStore.hpp"
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+/**
+ * @brief Constructor that starts with an empty graph as version 1.
+ */
+template <typename Weight>
+BasicGraphStore<Weight>::BasicGraphStore() : current(make_shared<const BasicGraph<Weight>>()), version(1) {}
+
+/**
+ * @brief Constructor that starts with the given graph as version 1.
+ *
+ * @param graph The first version of the graph.
+ */
+template <typename Weight>
+BasicGraphStore<Weight>::BasicGraphStore(BasicGraph<Weight> graph) : current(make_shared<const BasicGraph<Weight>>(std::move(graph))), version(1) {}
+
+/**
+ * @brief Returns a handle to the current version. The graph it points to is never modified.
+ *
+ * @return Snapshot The current version, kept alive for as long as the handle exists.
+ */
+template <typename Weight>
+typename BasicGraphStore<Weight>::Snapshot BasicGraphStore<Weight>::snapshot() const {
+    lock_guard<mutex> lock(publishMutex);
+    return current;
+}
+
+/**
+ * @brief Returns a handle to the current version together with its version number.
+ *
+ * @param snapshotVersion Set to the version number of the returned snapshot.
+ * @return Snapshot The current version.
+ */
+template <typename Weight>
+typename BasicGraphStore<Weight>::Snapshot BasicGraphStore<Weight>::snapshot(uint64_t &snapshotVersion) const {
+    lock_guard<mutex> lock(publishMutex);
+    snapshotVersion = version.load(memory_order_relaxed);
+    return current;
+}
+
+/**
+ * @brief Makes next the current version. The previous version lives on until its last handle is dropped.
+ *
+ * @param next The new version.
+ */
+template <typename Weight>
+void BasicGraphStore<Weight>::publishSnapshot(Snapshot next) {
+    {
+        lock_guard<mutex> lock(publishMutex);
+        current.swap(next);
+        version.store(version.load(memory_order_relaxed) + 1, memory_order_release);
+    }
+    // next now holds the previous version; if no reader has it, it is freed here, outside the lock
+}
+
+/**
+ * @brief Publishes the given graph as the new version.
+ *
+ * @param graph The new version of the graph.
+ */
+template <typename Weight>
+void BasicGraphStore<Weight>::publish(BasicGraph<Weight> graph) {
+    lock_guard<mutex> lock(writerMutex);
+    publishSnapshot(make_shared<const BasicGraph<Weight>>(std::move(graph)));
+}
+
+/**
+ * @brief Loads a new graph from the given adjacency matrix and publishes it.
+ *
+ * Throws like Graph::loadGraph if the matrix is invalid, in which case the current version is kept.
+ *
+ * @param matrix The adjacency matrix representing the graph.
+ */
+template <typename Weight>
+void BasicGraphStore<Weight>::loadGraph(const vector<vector<Weight>> &matrix) {
+    shared_ptr<BasicGraph<Weight>> next = make_shared<BasicGraph<Weight>>();
+    next->loadGraph(matrix);
+    lock_guard<mutex> lock(writerMutex);
+    publishSnapshot(next);
+}
+
+/**
+ * @brief Loads a new graph from the given adjacency matrix, taking over its storage, and publishes it.
+ *
+ * @param matrix The adjacency matrix representing the graph; left empty unless it is invalid.
+ */
+template <typename Weight>
+void BasicGraphStore<Weight>::loadGraph(vector<vector<Weight>> &&matrix) {
+    shared_ptr<BasicGraph<Weight>> next = make_shared<BasicGraph<Weight>>();
+    next->loadGraph(std::move(matrix));
+    lock_guard<mutex> lock(writerMutex);
+    publishSnapshot(next);
+}
+
+/**
+ * @brief Publishes a copy of the current version with the edge u->v set to weight (0 removes it).
+ *
+ * Every call copies the matrix; use update to apply several changes as one version.
+ *
+ * @param u The source vertex.
+ * @param v The destination vertex.
+ * @param weight The new weight of the edge.
+ */
+template <typename Weight>
+void BasicGraphStore<Weight>::setEdge(int u, int v, Weight weight) {
+    update([u, v, weight](BasicGraph<Weight> &g) {
+        if (u < 0 || v < 0 || u >= g.getVertexNum() || v >= g.getVertexNum()) {
+            throw invalid_argument("Invalid edge: The vertex does not exist.");
+        }
+        g.setEdge(u, v, weight);
+    });
+}
+
+/**
+ * @brief Applies mutate to a copy of the current version and publishes it.
+ *
+ * Writers are serialized, so no update is lost; readers keep querying the previous version meanwhile.
+ * If mutate throws, nothing is published.
+ *
+ * @param mutate The changes to make, e.g. several setEdge calls.
+ */
+template <typename Weight>
+void BasicGraphStore<Weight>::update(const function<void(BasicGraph<Weight> &)> &mutate) {
+    lock_guard<mutex> lock(writerMutex);
+    shared_ptr<BasicGraph<Weight>> next = make_shared<BasicGraph<Weight>>(*snapshot());
+    mutate(*next); // setEdge drops the properties it changes; they are recomputed on first read
+    publishSnapshot(next);
+}
+
+template class BasicGraphStore<int8_t>;
+template class BasicGraphStore<int16_t>;
+template class BasicGraphStore<int>;
+template class BasicGraphStore<int64_t>;
+template class BasicGraphStore<float>;
+template class BasicGraphStore<double>;
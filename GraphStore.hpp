@@ -0,0 +1,76 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "Graph.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+ * Holds the current version of a graph as an immutable snapshot, for query threads that run during reloads.
+ *
+ * Readers take a refcounted handle (snapshot) and query it without any lock; the graph behind a handle never
+ * changes. loadGraph, setEdge and update build a new version off to the side and publish it atomically, so
+ * readers see either the old or the new graph, never a half-written one. An old version is freed when the last
+ * handle to it is dropped. Writers are serialized with each other but never wait for readers.
+ */
+template <typename Weight>
+class BasicGraphStore{
+public:
+    typedef std::shared_ptr<const BasicGraph<Weight>> Snapshot;
+
+    /**
+     * A per-thread reader that keeps the snapshot it last saw. While nothing was published it only reads the
+     * version counter, so concurrent readers do not write to any shared cache line.
+     * It keeps its snapshot alive until the next get(), which is when an old version can be freed.
+     */
+    class Reader{
+    private:
+        const BasicGraphStore *store;
+        uint64_t version;
+        Snapshot cached;
+
+    public:
+        explicit Reader(const BasicGraphStore &graphStore) : store(&graphStore), version(0){}
+
+        const BasicGraph<Weight> &get(){
+            if (!cached || store->version.load(std::memory_order_acquire) != version) {
+                cached = store->snapshot(version);
+            }
+            return *cached;
+        }
+    };
+
+private:
+    Snapshot current;
+    std::atomic<uint64_t> version;
+    mutable std::mutex publishMutex; // Guards current; held only to copy or swap the pointer
+    std::mutex writerMutex;          // Serializes writers while they build the next version
+
+    Snapshot snapshot(uint64_t &snapshotVersion) const;
+    void publishSnapshot(Snapshot next);
+
+public:
+    //methods
+    Snapshot snapshot() const;
+    void publish(BasicGraph<Weight> graph);
+    void loadGraph(const std::vector<std::vector<Weight>> &matrix);
+    void loadGraph(std::vector<std::vector<Weight>> &&matrix);
+    void setEdge(int u, int v, Weight weight);
+    void update(const std::function<void(BasicGraph<Weight> &)> &mutate);
+
+    //constructors
+    BasicGraphStore();
+    explicit BasicGraphStore(BasicGraph<Weight> graph);
+    BasicGraphStore(const BasicGraphStore &) = delete;
+    BasicGraphStore &operator=(const BasicGraphStore &) = delete;
+
+    uint64_t getVersion() const{
+        return version.load(std::memory_order_acquire);
+    }
+};
+
+typedef BasicGraphStore<int> GraphStore;
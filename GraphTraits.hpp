@@ -0,0 +1,23 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+/**
+ * Compile-time tags describing the kind of a graph. The Algorithms entry points read the graph properties once
+ * and pick the kernel specialized for the matching GraphKind, so the kernels themselves contain no property checks.
+ */
+struct Directed {};
+struct Undirected {};
+
+struct Weighted {};
+struct Unweighted {};
+
+struct NonNegative {};
+struct Signed {};
+
+template <typename Direction, typename Weighting, typename Sign>
+struct GraphKind {
+    typedef Direction DirectionTag;
+    typedef Weighting WeightingTag;
+    typedef Sign SignTag;
+};
@@ -0,0 +1,117 @@
+//mail: guyes134@gmail.com
+
+#include "GraphView.hpp"
+#include "Trace.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * @brief Constructor for a view of the whole graph; the filters are added with the keep methods.
+ *
+ * @param g The graph to be viewed. It must outlive the view.
+ */
+template <typename Weight>
+BasicGraphView<Weight>::BasicGraphView(const BasicGraph<Weight> &g)
+    : graph(&g), hasVertexMask(false), hasRange(false), minWeight(0), maxWeight(0), edgesNum(UNKNOWN), isDirected(UNKNOWN), isWeighted(UNKNOWN), hasNegWeight(UNKNOWN) {}
+
+/**
+ * @brief Copy constructor; the copy views the same graph with the same filters.
+ */
+template <typename Weight>
+BasicGraphView<Weight>::BasicGraphView(const BasicGraphView &view)
+    : graph(view.graph), hasVertexMask(view.hasVertexMask), vertices(view.vertices), viewIds(view.viewIds), hasRange(view.hasRange), minWeight(view.minWeight),
+      maxWeight(view.maxWeight), predicate(view.predicate), edgesNum(UNKNOWN), isDirected(UNKNOWN), isWeighted(UNKNOWN), hasNegWeight(UNKNOWN) {}
+
+/**
+ * @brief Restricts the view to the subgraph induced by the vertices of the mask, renumbered in increasing order.
+ *
+ * @param mask mask[v] is true if original vertex v is kept; it has one entry per vertex of the graph.
+ */
+template <typename Weight>
+void BasicGraphView<Weight>::keepVertices(const std::vector<bool> &mask) {
+    if (static_cast<int>(mask.size()) != graph->getVertexNum()) {
+        throw invalid_argument("Invalid mask: The mask does not have one entry per vertex.");
+    }
+    vector<int> kept;
+    viewIds.assign(mask.size(), -1);
+    for (size_t v = 0; v < mask.size(); ++v) {
+        if (mask[v]) {
+            viewIds[v] = static_cast<int>(kept.size());
+            kept.push_back(static_cast<int>(v));
+        }
+    }
+    vertices.swap(kept);
+    hasVertexMask = true; // Even if nothing is kept: an all-false mask gives an empty view
+    forgetProperties();
+}
+
+/**
+ * @brief Keeps only the edges whose weight lies in [minimum, maximum].
+ *
+ * @param minimum The smallest weight kept.
+ * @param maximum The largest weight kept.
+ */
+template <typename Weight>
+void BasicGraphView<Weight>::keepWeights(Weight minimum, Weight maximum) {
+    hasRange = true;
+    minWeight = minimum;
+    maxWeight = maximum;
+    forgetProperties();
+}
+
+/**
+ * @brief Keeps only the edges for which the predicate returns true.
+ *
+ * @param edgePredicate Called with the original ids of the endpoints and the weight of an edge.
+ */
+template <typename Weight>
+void BasicGraphView<Weight>::keepEdges(const EdgePredicate &edgePredicate) {
+    predicate = edgePredicate;
+    forgetProperties();
+}
+
+template <typename Weight>
+void BasicGraphView<Weight>::forgetProperties() {
+    edgesNum.store(UNKNOWN, memory_order_relaxed);
+}
+
+/**
+ * @brief Determines in one scan of the filtered matrix the number of edges and whether the view is directed,
+ * weighted, or has negative weights. edgesNum is published last, so a reader seeing it sees the others too.
+ */
+template <typename Weight>
+void BasicGraphView<Weight>::computeProperties() const {
+    TRACE_SPAN("GraphView::computeProperties");
+    int V = getVertexNum();
+    Matrix matrix = getAdjacencyMatrix();
+    int entries = 0;
+    bool directed = false;
+    bool weighted = false;
+    bool negative = false;
+    for (int u = 0; u < V; ++u) {
+        Row row = matrix[u];
+        for (int v = 0; v < V; ++v) {
+            Weight weight = row[v];
+            if (!directed && v > u && weight != matrix[v][u]) {
+                directed = true;
+            }
+            if (weight != 0) {
+                entries++;
+                weighted = weighted || weight != 1;
+                negative = negative || weight < 0;
+            }
+        }
+    }
+    isDirected.store(directed, memory_order_relaxed);
+    isWeighted.store(weighted, memory_order_relaxed);
+    hasNegWeight.store(negative, memory_order_relaxed);
+    edgesNum.store(directed ? entries : entries / 2, memory_order_release);
+}
+
+template class BasicGraphView<int8_t>;
+template class BasicGraphView<int16_t>;
+template class BasicGraphView<int>;
+template class BasicGraphView<int64_t>;
+template class BasicGraphView<float>;
+template class BasicGraphView<double>;
@@ -0,0 +1,152 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "Graph.hpp"
+#include <atomic>
+#include <functional>
+#include <vector>
+
+/**
+ * A filtered view of a graph, accepted by every Algorithms function in place of the graph itself.
+ *
+ * Nothing is copied: the view reads the matrix of the graph and drops the filtered edges as the algorithms scan it.
+ * - keepVertices: the subgraph induced by a vertex mask. The kept vertices are numbered 0..k-1 in increasing order
+ *   of their original ids; toOriginal and toView translate, and vertex ids in results are view ids.
+ * - keepWeights: only the edges whose weight lies in [minWeight, maxWeight].
+ * - keepEdges: only the edges for which a predicate, given original ids, returns true.
+ *
+ * The properties (edge count, direction, weights, negative weights) are those of the filtered graph, computed on
+ * first use like the ones of BasicGraph; an asymmetric predicate makes the view of an undirected graph directed.
+ * The graph must outlive the view and must not change while the view is used.
+ */
+template <typename Weight>
+class BasicGraphView{
+public:
+    typedef std::function<bool(int u, int v, Weight weight)> EdgePredicate;
+
+    // A row of the filtered matrix: row[v] is the weight of the edge to view vertex v, 0 if there is none
+    class Row{
+    private:
+        const BasicGraphView *view;
+        const std::vector<Weight> *row;
+        int u;
+
+    public:
+        Row(const BasicGraphView *graphView, int vertex) : view(graphView), u(graphView->toOriginal(vertex)) {
+            row = &graphView->graph->getAdjacencyMatrix()[u];
+        }
+
+        Weight operator[](int v) const{
+            int original = view->toOriginal(v);
+            return view->filter(u, original, (*row)[original]);
+        }
+    };
+
+    // The filtered adjacency matrix, indexed like the one of BasicGraph
+    class Matrix{
+    private:
+        const BasicGraphView *view;
+
+    public:
+        explicit Matrix(const BasicGraphView *graphView) : view(graphView) {}
+
+        Row operator[](int u) const{
+            return Row(view, u);
+        }
+
+        size_t size() const{
+            return static_cast<size_t>(view->getVertexNum());
+        }
+    };
+
+private:
+    static const int UNKNOWN = -1;
+
+    const BasicGraph<Weight> *graph;
+    bool hasVertexMask;        // False while every vertex is kept under its own id
+    std::vector<int> vertices; // The original id of every view vertex, used only with a mask
+    std::vector<int> viewIds;  // The view id of every original vertex, -1 if it is not kept
+    bool hasRange;
+    Weight minWeight;
+    Weight maxWeight;
+    EdgePredicate predicate;
+    mutable std::atomic<int> edgesNum;
+    mutable std::atomic<signed char> isDirected;
+    mutable std::atomic<signed char> isWeighted;
+    mutable std::atomic<signed char> hasNegWeight;
+
+    void forgetProperties();
+    void computeProperties() const;
+
+public:
+    //methods
+    void keepVertices(const std::vector<bool> &mask);
+    void keepWeights(Weight minimum, Weight maximum);
+    void keepEdges(const EdgePredicate &edgePredicate);
+
+    //constructors
+    explicit BasicGraphView(const BasicGraph<Weight> &g);
+    BasicGraphView(const BasicGraphView &view);
+    BasicGraphView &operator=(const BasicGraphView &) = delete;
+
+    /**
+     * @brief Returns the weight of the edge u->v (original ids) if it passes the filters, 0 otherwise.
+     */
+    Weight filter(int u, int v, Weight weight) const{
+        if (weight == 0 || (hasRange && (weight < minWeight || weight > maxWeight)) || (predicate && !predicate(u, v, weight))) {
+            return 0;
+        }
+        return weight;
+    }
+
+    int toOriginal(int v) const{
+        return hasVertexMask ? vertices[v] : v;
+    }
+
+    int toView(int v) const{
+        return hasVertexMask ? viewIds[v] : v;
+    }
+
+    const BasicGraph<Weight> &getGraph() const{
+        return *graph;
+    }
+
+    int getVertexNum() const{
+        return hasVertexMask ? static_cast<int>(vertices.size()) : graph->getVertexNum();
+    }
+
+    Matrix getAdjacencyMatrix() const{
+        return Matrix(this);
+    }
+
+    int getEdgesNum() const{
+        if (edgesNum.load(std::memory_order_acquire) == UNKNOWN) {
+            computeProperties();
+        }
+        return edgesNum.load(std::memory_order_relaxed);
+    }
+
+    bool getIsDirected() const{
+        if (edgesNum.load(std::memory_order_acquire) == UNKNOWN) {
+            computeProperties();
+        }
+        return isDirected.load(std::memory_order_relaxed) != 0;
+    }
+
+    bool getIsWeighted() const{
+        if (edgesNum.load(std::memory_order_acquire) == UNKNOWN) {
+            computeProperties();
+        }
+        return isWeighted.load(std::memory_order_relaxed) != 0;
+    }
+
+    bool getHasNegEdges() const{
+        if (edgesNum.load(std::memory_order_acquire) == UNKNOWN) {
+            computeProperties();
+        }
+        return hasNegWeight.load(std::memory_order_relaxed) != 0;
+    }
+};
+
+typedef BasicGraphView<int> GraphView;
@@ -0,0 +1,527 @@
+//mail: guyes134@gmail.com
+
+#include "PartitionedGraph.hpp"
+#include "GraphParser.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <dirent.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    enum Command : int32_t {
+        LOAD = 1,          // vertexNum, begin, end, then for every owned vertex its degree and out-neighbours
+        START_FORWARD = 2, // Reset the search state for a BFS along the edges
+        START_REVERSE = 3, // Reset the search state for a BFS against the edges
+        ROUND = 4,         // The frontier in queue order: the owned part going forward, all of it in reverse
+        QUIT = 5,
+        LOADED = 6         // Worker to coordinator: its part of the graph file is loaded
+    };
+
+    // The vertex range of a worker and the out-neighbours of its vertices
+    struct Part {
+        int vertexNum = 0;
+        int begin = 0;
+        std::vector<std::vector<int>> adjacency;
+    };
+
+    // A message is its length in 32-bit words followed by the words
+    long long sendMessage(int fd, const vector<int32_t> &words) {
+        uint32_t length = static_cast<uint32_t>(words.size());
+        const char *parts[] = {reinterpret_cast<const char *>(&length), reinterpret_cast<const char *>(words.data())};
+        size_t sizes[] = {sizeof(length), words.size() * sizeof(int32_t)};
+        for (int k = 0; k < 2; ++k) {
+            size_t done = 0;
+            while (done < sizes[k]) {
+                ssize_t n = send(fd, parts[k] + done, sizes[k] - done, MSG_NOSIGNAL); // A dead worker must not raise SIGPIPE
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    throw runtime_error("Partitioned graph: A worker connection failed.");
+                }
+                done += static_cast<size_t>(n);
+            }
+        }
+        return static_cast<long long>(sizes[0] + sizes[1]);
+    }
+
+    // The number of threads of this process, 0 if /proc cannot tell
+    int threadCount() {
+        DIR *dir = opendir("/proc/self/task");
+        if (dir == nullptr) {
+            return 0;
+        }
+        int count = 0;
+        while (dirent *entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') {
+                count++;
+            }
+        }
+        closedir(dir);
+        return count;
+    }
+
+    bool readAll(int fd, char *data, size_t size) {
+        size_t done = 0;
+        while (done < size) {
+            ssize_t n = read(fd, data + done, size - done);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            done += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    long long receiveMessage(int fd, vector<int32_t> &words) {
+        uint32_t length = 0;
+        if (!readAll(fd, reinterpret_cast<char *>(&length), sizeof(length))) {
+            throw runtime_error("Partitioned graph: A worker connection failed.");
+        }
+        words.resize(length);
+        if (!readAll(fd, reinterpret_cast<char *>(words.data()), length * sizeof(int32_t))) {
+            throw runtime_error("Partitioned graph: A worker connection failed.");
+        }
+        return static_cast<long long>(sizeof(length) + length * sizeof(int32_t));
+    }
+
+    /**
+     * @brief Reads the out-edges of the range [part.begin, end) from an edge-list file, one chunk at a time, so the
+     * worker never holds more than its own lists. Edges of weight 0 are skipped.
+     */
+    void loadPart(const string &path, bool undirected, int end, Part &part) {
+        part.adjacency.assign(end - part.begin, vector<int>());
+        GraphParser::streamEdgeListFile(path, [&part, undirected, end](int u, int v, int weight) {
+            if (weight == 0) {
+                return;
+            }
+            if (u >= part.begin && u < end) {
+                part.adjacency[u - part.begin].push_back(v);
+            }
+            if (undirected && v >= part.begin && v < end) {
+                part.adjacency[v - part.begin].push_back(u);
+            }
+        });
+        for (vector<int> &neighbours : part.adjacency) { // A repeated line is one edge, as in the matrix
+            sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        }
+    }
+
+    /**
+     * @brief The loop of a worker process: holds the out-edges of its range and answers search rounds.
+     */
+    void workerMain(int fd, Part &part) {
+        int &begin = part.begin;
+        vector<vector<int>> &adjacency = part.adjacency;
+        vector<char> seen;       // Vertices known to be visited
+        vector<char> inFrontier; // Membership of the current frontier, for reverse rounds
+        bool reverse = false;
+        vector<int32_t> message;
+        vector<int32_t> reply;
+
+        while (true) {
+            receiveMessage(fd, message);
+            int32_t command = message[0];
+            if (command == LOAD) {
+                part.vertexNum = message[1];
+                begin = message[2];
+                int end = message[3];
+                adjacency.assign(end - begin, vector<int>());
+                size_t pos = 4;
+                for (int u = begin; u < end; ++u) {
+                    int degree = message[pos++];
+                    adjacency[u - begin].assign(message.begin() + pos, message.begin() + pos + degree);
+                    pos += degree;
+                }
+                vector<int32_t>().swap(message);
+            } else if (command == START_FORWARD || command == START_REVERSE) {
+                reverse = command == START_REVERSE;
+                seen.assign(part.vertexNum, false);
+                inFrontier.resize(part.vertexNum, false);
+            } else if (command == ROUND) {
+                reply.clear();
+                for (size_t i = 1; i < message.size(); ++i) {
+                    seen[message[i]] = true;
+                }
+                if (!reverse) {
+                    // Expand the owned frontier vertices in queue order, so the first discoverer of a vertex is kept.
+                    // Vertices visited through other workers are not known here; the coordinator drops them.
+                    for (size_t i = 1; i < message.size(); ++i) {
+                        int u = message[i];
+                        if (u < begin || u >= begin + static_cast<int>(adjacency.size())) {
+                            continue;
+                        }
+                        for (int v : adjacency[u - begin]) {
+                            if (!seen[v]) {
+                                seen[v] = true;
+                                reply.push_back(v);
+                                reply.push_back(u);
+                            }
+                        }
+                    }
+                } else {
+                    for (size_t i = 1; i < message.size(); ++i) {
+                        inFrontier[message[i]] = true;
+                    }
+                    for (int u = begin; u < begin + static_cast<int>(adjacency.size()); ++u) {
+                        if (seen[u]) {
+                            continue;
+                        }
+                        for (int v : adjacency[u - begin]) {
+                            if (inFrontier[v]) {
+                                seen[u] = true;
+                                reply.push_back(u);
+                                reply.push_back(v);
+                                break;
+                            }
+                        }
+                    }
+                    for (size_t i = 1; i < message.size(); ++i) {
+                        inFrontier[message[i]] = false;
+                    }
+                }
+                sendMessage(fd, reply);
+            } else {
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Forks one worker per vertex range. A worker given an edge-list file loads its range from it and reports
+ * LOADED; otherwise it waits for a LOAD message.
+ *
+ * The workers are forked without exec and go on running C++ code, which is only safe while the process has a
+ * single thread: a lock held by another thread at the fork (in malloc, in a stream) would stay locked forever in
+ * the child. This therefore refuses to run once another thread exists.
+ *
+ * @param parts The number of worker processes (at most one per vertex, at least one).
+ * @param edgeListPath The edge-list file the workers load their ranges from, empty to wait for LOAD.
+ * @param undirected The edges of the file go both ways.
+ */
+void PartitionedGraph::startWorkers(int parts, const std::string &edgeListPath, bool undirected) {
+    if (parts < 1) {
+        throw invalid_argument("Invalid partition: The number of parts must be positive.");
+    }
+    if (threadCount() > 1) {
+        throw runtime_error("Partitioned graph: The workers must be started before any other thread.");
+    }
+    parts = max(1, min(parts, vertexNum));
+
+    for (int p = 0; p < parts; ++p) {
+        int begin = static_cast<int>(static_cast<long long>(vertexNum) * p / parts);
+        int end = static_cast<int>(static_cast<long long>(vertexNum) * (p + 1) / parts);
+        int sockets[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) < 0) {
+            throw runtime_error("Partitioned graph: Cannot create a socket pair.");
+        }
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(sockets[0]);
+            close(sockets[1]);
+            throw runtime_error("Partitioned graph: Cannot start a worker process.");
+        }
+        if (pid == 0) {
+            close(sockets[0]);
+            for (const Worker &other : workers) {
+                close(other.fd);
+            }
+            int status = 0;
+            try {
+                Part part;
+                part.vertexNum = vertexNum;
+                part.begin = begin;
+                if (!edgeListPath.empty()) {
+                    loadPart(edgeListPath, undirected, end, part);
+                    sendMessage(sockets[1], vector<int32_t>(1, LOADED));
+                }
+                workerMain(sockets[1], part);
+            } catch (...) {
+                status = 1;
+            }
+            _exit(status);
+        }
+        close(sockets[1]);
+        Worker worker = {pid, sockets[0], begin, end};
+        workers.push_back(worker);
+    }
+}
+
+/**
+ * @brief Constructor that starts the worker processes and sends each one the out-edges of its vertex range.
+ *
+ * The coordinator holds the whole graph here; for graphs that do not fit in one process, use the edge-list
+ * constructor.
+ *
+ * @param g The graph to be partitioned.
+ * @param parts The number of worker processes (at most one per vertex, at least one).
+ */
+PartitionedGraph::PartitionedGraph(const Graph &g, int parts) : vertexNum(g.getVertexNum()), isDirected(g.getIsDirected()), isWeighted(g.getIsWeighted()) {
+    const vector<vector<int>> &matrix = g.getAdjacencyMatrix();
+    try {
+        startWorkers(parts, string(), false);
+        for (const Worker &worker : workers) {
+            vector<int32_t> message = {LOAD, vertexNum, worker.begin, worker.end};
+            for (int u = worker.begin; u < worker.end; ++u) {
+                size_t degreePos = message.size();
+                message.push_back(0);
+                for (int v = 0; v < vertexNum; ++v) {
+                    if (matrix[u][v] != 0) {
+                        message.push_back(v);
+                    }
+                }
+                message[degreePos] = static_cast<int32_t>(message.size() - degreePos - 1);
+            }
+            sendMessage(worker.fd, message);
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+/**
+ * @brief Constructor that partitions an edge-list file without loading it in any single process.
+ *
+ * The coordinator streams the file once to find the number of vertices (the largest id plus one) and whether it
+ * is weighted, keeping no edge. Every worker then streams the file itself and keeps only the out-edges of its
+ * range, so no process holds more than its share. Edges of weight 0 are skipped. Without undirected the graph is
+ * treated as directed, and isConnected checks strong connectivity, which gives the same answer for symmetric files.
+ *
+ * @param edgeListPath The edge list, one "u v [w]" edge per line.
+ * @param undirected Every edge goes both ways.
+ * @param parts The number of worker processes (at most one per vertex, at least one).
+ */
+PartitionedGraph::PartitionedGraph(const std::string &edgeListPath, bool undirected, int parts) : vertexNum(0), isDirected(!undirected), isWeighted(false) {
+    int maxVertex = -1;
+    GraphParser::streamEdgeListFile(edgeListPath, [this, &maxVertex](int u, int v, int weight) {
+        maxVertex = max(maxVertex, max(u, v));
+        if (weight != 0 && weight != 1) {
+            isWeighted = true;
+        }
+    });
+    vertexNum = maxVertex + 1;
+
+    try {
+        startWorkers(parts, edgeListPath, undirected);
+        vector<int32_t> reply;
+        for (const Worker &worker : workers) {
+            try {
+                receiveMessage(worker.fd, reply);
+            } catch (const runtime_error &) {
+                reply.clear();
+            }
+            if (reply.size() != 1 || reply[0] != LOADED) {
+                throw runtime_error("Partitioned graph: A worker could not load its part of " + edgeListPath + ".");
+            }
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+/**
+ * @brief Destructor that stops the worker processes.
+ */
+PartitionedGraph::~PartitionedGraph() {
+    stop();
+}
+
+void PartitionedGraph::stop() {
+    for (const Worker &worker : workers) {
+        try {
+            sendMessage(worker.fd, vector<int32_t>(1, QUIT));
+        } catch (...) {
+        }
+        close(worker.fd);
+        waitpid(worker.pid, nullptr, 0);
+    }
+    workers.clear();
+}
+
+/**
+ * @brief Returns the index of the worker whose range holds v.
+ */
+size_t PartitionedGraph::owner(int v) const {
+    return upper_bound(workers.begin(), workers.end(), v, [](int vertex, const Worker &worker) {
+        return vertex < worker.begin;
+    }) - workers.begin() - 1;
+}
+
+/**
+ * @brief Runs a distributed BFS and records the traffic of every round.
+ *
+ * @param start The source vertex.
+ * @param reverse Search against the edge directions.
+ * @param target Stop after the round that reaches target (-1 to search everything).
+ * @param parent Set to the BFS parent of every vertex, -1 for the source and the unreached vertices.
+ * @return int The number of vertices reached.
+ */
+int PartitionedGraph::search(int start, bool reverse, int target, std::vector<int> &parent) {
+    TRACE_SPAN("PartitionedGraph::search");
+    rounds.clear();
+    parent.assign(vertexNum, -1);
+    vector<int> level(vertexNum, -1);
+    vector<int> position(vertexNum, 0); // The place of a frontier vertex in the queue of its level
+    vector<int> frontier(1, start);
+    vector<int> next;
+    vector<vector<int32_t>> messages(workers.size());
+    vector<int32_t> reply;
+    level[start] = 0;
+    int reached = 1;
+
+    for (const Worker &worker : workers) {
+        sendMessage(worker.fd, vector<int32_t>(1, reverse ? START_REVERSE : START_FORWARD));
+    }
+    for (int depth = 1; !frontier.empty() && (target < 0 || level[target] < 0); ++depth) {
+        RoundStats stats = {static_cast<int>(frontier.size()), 0, 0};
+        // Going forward only the owner of a vertex expands it; in reverse every worker tests its vertices against all
+        for (vector<int32_t> &message : messages) {
+            message.assign(1, ROUND);
+            if (reverse) {
+                message.insert(message.end(), frontier.begin(), frontier.end());
+            }
+        }
+        if (!reverse) {
+            for (int v : frontier) {
+                messages[owner(v)].push_back(v);
+            }
+        }
+        for (size_t w = 0; w < workers.size(); ++w) {
+            if (messages[w].size() > 1) {
+                stats.bytesSent += sendMessage(workers[w].fd, messages[w]);
+            }
+        }
+        for (size_t i = 0; i < frontier.size(); ++i) {
+            position[frontier[i]] = static_cast<int>(i);
+        }
+
+        // A vertex found by several workers keeps the parent that comes first in the queue, as in a sequential BFS.
+        // Going forward a worker may report a vertex another worker reached earlier; it keeps its first level.
+        next.clear();
+        for (size_t w = 0; w < workers.size(); ++w) {
+            if (messages[w].size() <= 1) {
+                continue;
+            }
+            stats.bytesReceived += receiveMessage(workers[w].fd, reply);
+            for (size_t i = 0; i + 1 < reply.size(); i += 2) {
+                int v = reply[i];
+                int u = reply[i + 1];
+                if (level[v] < 0) {
+                    level[v] = depth;
+                    parent[v] = u;
+                    next.push_back(v);
+                } else if (level[v] == depth && position[u] < position[parent[v]]) {
+                    parent[v] = u;
+                }
+            }
+        }
+        // The sequential queue holds the new vertices by the position of their parent, then by id
+        sort(next.begin(), next.end(), [&position, &parent](int a, int b) {
+            return position[parent[a]] != position[parent[b]] ? position[parent[a]] < position[parent[b]] : a < b;
+        });
+        reached += static_cast<int>(next.size());
+        rounds.push_back(stats);
+        frontier.swap(next);
+    }
+    return reached;
+}
+
+/**
+ * @brief Checks if the graph is connected like Algorithms::isConnected: every vertex is reached from vertex 0,
+ * and for a directed graph vertex 0 is also reached from every vertex (strong connectivity).
+ *
+ * @return int Returns 1 if the graph is connected, 0 otherwise.
+ */
+int PartitionedGraph::isConnected() {
+    TRACE_SPAN("PartitionedGraph::isConnected");
+    if (vertexNum == 0) {
+        return 0;
+    }
+    vector<int> parent;
+    vector<RoundStats> forwardRounds;
+    bool connected = search(0, false, -1, parent) == vertexNum;
+    if (connected && isDirected) {
+        forwardRounds.swap(rounds);
+        connected = search(0, true, -1, parent) == vertexNum;
+        rounds.insert(rounds.begin(), forwardRounds.begin(), forwardRounds.end());
+    }
+    return connected ? 1 : 0;
+}
+
+/**
+ * @brief Finds the shortest path of an unweighted graph like Algorithms::shortestPath.
+ *
+ * @param start The starting vertex.
+ * @param end The ending vertex.
+ * @return std::string The path in the format "0->1->2", or "-1" if there is none.
+ */
+std::string PartitionedGraph::shortestPath(int start, int end) {
+    TRACE_SPAN("PartitionedGraph::shortestPath");
+    if (isWeighted) {
+        throw invalid_argument("Invalid graph: The partitioned shortest path needs an unweighted graph.");
+    }
+    if (start < 0 || end < 0) {
+        throw invalid_argument("Invalid vertex: The vertex does not exist.");
+    }
+    rounds.clear();
+    if (start >= vertexNum || end >= vertexNum) {
+        return "-1";
+    }
+    if (start == end) {
+        return to_string(start);
+    }
+    vector<int> parent;
+    search(start, false, end, parent);
+    if (parent[end] == -1) {
+        return "-1";
+    }
+
+    vector<int> path;
+    for (int v = end; v != -1; v = parent[v]) {
+        path.push_back(v);
+    }
+    string result;
+    for (size_t i = path.size(); i-- > 0;) {
+        result += to_string(path[i]);
+        if (i > 0) {
+            result += "->";
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the bytes the coordinator sent to the workers during the last query.
+ */
+long long PartitionedGraph::getBytesSent() const {
+    long long total = 0;
+    for (const RoundStats &stats : rounds) {
+        total += stats.bytesSent;
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the bytes the workers sent to the coordinator during the last query.
+ */
+long long PartitionedGraph::getBytesReceived() const {
+    long long total = 0;
+    for (const RoundStats &stats : rounds) {
+        total += stats.bytesReceived;
+    }
+    return total;
+}
@@ -0,0 +1,80 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "Graph.hpp"
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+/**
+ * A graph split by vertex ranges across local worker processes, a stand-in for a cluster.
+ *
+ * Worker i is a forked process that holds the out-edges of its range [begin, end) only. Built from a Graph, the
+ * coordinator sends them over a Unix-domain socket pair; built from an edge-list file, every worker streams the file
+ * and keeps its own range, so no process ever holds the whole graph. Queries run a level-synchronous BFS: every round
+ * the coordinator sends each worker the frontier vertices it owns and the worker expands them (for the reverse search
+ * of a directed graph, every worker gets the whole frontier and looks for its own unvisited vertices with an edge
+ * into it); the workers answer the (vertex, parent) pairs they discovered. The coordinator keeps only O(V) state and
+ * orders every new frontier like the queue of the single-process BFS, so isConnected and shortestPath return exactly
+ * what the Algorithms functions return.
+ *
+ * The bytes sent and received in every round of the last query are kept for sizing real deployments.
+ * The workers are forked without exec, so a PartitionedGraph must be created while the process has a single thread;
+ * the constructor throws otherwise.
+ */
+class PartitionedGraph{
+public:
+    struct RoundStats {
+        int frontierSize;
+        long long bytesSent;     // Coordinator to workers
+        long long bytesReceived; // Workers to coordinator
+    };
+
+private:
+    struct Worker {
+        pid_t pid;
+        int fd;
+        int begin;
+        int end;
+    };
+
+    int vertexNum;
+    bool isDirected;
+    bool isWeighted;
+    std::vector<Worker> workers;
+    std::vector<RoundStats> rounds;
+
+    void startWorkers(int parts, const std::string &edgeListPath, bool undirected);
+    size_t owner(int v) const;
+    int search(int start, bool reverse, int target, std::vector<int> &parent);
+    void stop();
+
+public:
+    //methods
+    int isConnected();
+    std::string shortestPath(int start, int end);
+
+    //constructors
+    PartitionedGraph(const Graph &g, int parts);
+    PartitionedGraph(const std::string &edgeListPath, bool undirected, int parts);
+    PartitionedGraph(const PartitionedGraph &) = delete;
+    PartitionedGraph &operator=(const PartitionedGraph &) = delete;
+
+    ~PartitionedGraph();
+
+    int getPartNum() const{
+        return static_cast<int>(workers.size());
+    }
+
+    int getVertexNum() const{
+        return vertexNum;
+    }
+
+    const std::vector<RoundStats> &getRounds() const{
+        return rounds;
+    }
+
+    long long getBytesSent() const;
+    long long getBytesReceived() const;
+};
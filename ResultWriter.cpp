@@ -0,0 +1,319 @@
+//mail: guyes134@gmail.com
+
+#include "ResultWriter.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    const size_t MIN_BUFFER_SIZE = 64; // Room for the longest number, so a number is never split across flushes
+}
+
+/**
+ * @brief Constructor for a writer to a file descriptor.
+ *
+ * @param outFd The descriptor to write to; it is not closed by the writer.
+ * @param outEncoding The encoding of the records.
+ * @param bufferSize The size of the buffer filled before every write.
+ */
+ResultWriter::ResultWriter(int outFd, Encoding outEncoding, size_t bufferSize)
+    : fd(outFd), target(nullptr), encoding(outEncoding), buffer(max(bufferSize, MIN_BUFFER_SIZE)), used(0) {}
+
+/**
+ * @brief Constructor for a writer appending to a caller string.
+ *
+ * @param out The string the output is appended to, on every flush.
+ * @param outEncoding The encoding of the records.
+ * @param bufferSize The size of the buffer filled before every append.
+ */
+ResultWriter::ResultWriter(std::string &out, Encoding outEncoding, size_t bufferSize)
+    : fd(-1), target(&out), encoding(outEncoding), buffer(max(bufferSize, MIN_BUFFER_SIZE)), used(0) {}
+
+/**
+ * @brief Destructor; flushes what is left in the buffer, ignoring write errors.
+ */
+ResultWriter::~ResultWriter() {
+    try {
+        flush();
+    } catch (const exception &) {
+    }
+}
+
+/**
+ * @brief Hands the buffered output to the sink.
+ */
+void ResultWriter::flush() {
+    if (used == 0) {
+        return;
+    }
+    if (target != nullptr) {
+        target->append(buffer.data(), used);
+        used = 0;
+        return;
+    }
+    size_t written = 0;
+    while (written < used) {
+        ssize_t n = write(fd, buffer.data() + written, used - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            used = 0;
+            throw runtime_error("Cannot write results: " + string(strerror(errno)));
+        }
+        written += static_cast<size_t>(n);
+    }
+    used = 0;
+}
+
+void ResultWriter::put(char c) {
+    if (used == buffer.size()) {
+        flush();
+    }
+    buffer[used++] = c;
+}
+
+void ResultWriter::put(const char *text) {
+    putBytes(text, strlen(text));
+}
+
+void ResultWriter::putBytes(const void *data, size_t size) {
+    const char *bytes = static_cast<const char *>(data);
+    while (size > 0) {
+        if (used == buffer.size()) {
+            flush();
+        }
+        size_t n = min(size, buffer.size() - used);
+        memcpy(buffer.data() + used, bytes, n);
+        used += n;
+        bytes += n;
+        size -= n;
+    }
+}
+
+/**
+ * @brief Appends the decimal form of value straight into the buffer, without going through a stream.
+ */
+void ResultWriter::putInt(long long value) {
+    if (buffer.size() - used < 24) {
+        flush();
+    }
+    char digits[24];
+    int n = 0;
+    unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+    do {
+        digits[n++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) {
+        buffer[used++] = '-';
+    }
+    while (n > 0) {
+        buffer[used++] = digits[--n];
+    }
+}
+
+/**
+ * @brief Appends the shortest decimal form of value that reads back as the same Real, so no precision is lost.
+ *
+ * JSON has no infinities or NaN, so in JSON_LINES a non-finite value is written as null; the other encodings keep
+ * the inf and nan of printf.
+ */
+template <typename Real>
+void ResultWriter::putReal(Real value) {
+    if (encoding == JSON_LINES && !std::isfinite(value)) {
+        put("null");
+        return;
+    }
+    if (buffer.size() - used < 32) {
+        flush();
+    }
+    char *out = buffer.data() + used;
+    int n = 0;
+    for (int precision = numeric_limits<Real>::digits10; precision <= numeric_limits<Real>::max_digits10; ++precision) {
+        n = snprintf(out, 32, "%.*g", precision, static_cast<double>(value));
+        if (static_cast<Real>(strtod(out, nullptr)) == value) {
+            break;
+        }
+    }
+    used += static_cast<size_t>(max(n, 0));
+}
+
+void ResultWriter::putSequence(const std::vector<int> &vertices, const char *separator) {
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        if (i > 0) {
+            put(separator);
+        }
+        putInt(vertices[i]);
+    }
+}
+
+void ResultWriter::putArray(const std::vector<int> &vertices) {
+    put('[');
+    putSequence(vertices, ",");
+    put(']');
+}
+
+void ResultWriter::putBinaryArray(const std::vector<int> &vertices) {
+    uint32_t n = static_cast<uint32_t>(vertices.size());
+    putBytes(&n, sizeof(n));
+    for (int v : vertices) {
+        int32_t value = v;
+        putBytes(&value, sizeof(value));
+    }
+}
+
+template <typename Weight>
+void ResultWriter::putWeight(Weight weight) {
+    if (std::is_floating_point<Weight>::value) {
+        putReal(weight);
+    } else {
+        putInt(static_cast<long long>(weight));
+    }
+}
+
+/**
+ * @brief Writes the adjacency matrix of the graph.
+ *
+ * @param g The graph to be written.
+ */
+template <typename Weight>
+void ResultWriter::writeMatrix(const BasicGraph<Weight> &g) {
+    TRACE_SPAN("ResultWriter::writeMatrix");
+    const std::vector<std::vector<Weight>> &matrix = g.getAdjacencyMatrix();
+    int V = g.getVertexNum();
+    if (encoding == BINARY) {
+        put(static_cast<char>(MATRIX));
+        uint32_t n = static_cast<uint32_t>(V);
+        putBytes(&n, sizeof(n));
+        put(static_cast<char>(sizeof(Weight)));
+        put(static_cast<char>(std::is_floating_point<Weight>::value ? 1 : 0));
+        for (int u = 0; u < V; ++u) {
+            putBytes(matrix[u].data(), matrix[u].size() * sizeof(Weight));
+        }
+        return;
+    }
+
+    if (encoding == JSON_LINES) {
+        put("{\"matrix\":[");
+    }
+    for (int u = 0; u < V; ++u) {
+        if (encoding == JSON_LINES) {
+            put(u > 0 ? ",[" : "[");
+        }
+        for (int v = 0; v < V; ++v) {
+            if (encoding == JSON_LINES && v > 0) {
+                put(',');
+            }
+            putWeight(matrix[u][v]);
+            if (encoding == TEXT) {
+                put(' ');
+            }
+        }
+        put(encoding == TEXT ? '\n' : ']');
+    }
+    if (encoding == JSON_LINES) {
+        put("]}\n");
+    }
+}
+
+/**
+ * @brief Writes a path, given as its vertices from the start to the end.
+ *
+ * @param vertices The vertices of the path; empty if there is no path.
+ */
+void ResultWriter::writePath(const std::vector<int> &vertices) {
+    switch (encoding) {
+        case TEXT:
+            if (vertices.empty()) {
+                put("-1");
+            } else {
+                putSequence(vertices, "->");
+            }
+            put('\n');
+            break;
+        case JSON_LINES:
+            put("{\"path\":");
+            if (vertices.empty()) {
+                put("null");
+            } else {
+                putArray(vertices);
+            }
+            put("}\n");
+            break;
+        default:
+            put(static_cast<char>(PATH));
+            putBinaryArray(vertices);
+            break;
+    }
+}
+
+/**
+ * @brief Writes a cycle, given as its vertices with the first one repeated at the end.
+ *
+ * @param vertices The vertices of the cycle.
+ */
+void ResultWriter::writeCycle(const std::vector<int> &vertices) {
+    switch (encoding) {
+        case TEXT:
+            putSequence(vertices, "->");
+            put('\n');
+            break;
+        case JSON_LINES:
+            put("{\"cycle\":");
+            putArray(vertices);
+            put("}\n");
+            break;
+        default:
+            put(static_cast<char>(CYCLE));
+            putBinaryArray(vertices);
+            break;
+    }
+}
+
+/**
+ * @brief Writes the two sets of a bipartition.
+ *
+ * @param setA The vertices of set A.
+ * @param setB The vertices of set B.
+ */
+void ResultWriter::writePartition(const std::vector<int> &setA, const std::vector<int> &setB) {
+    switch (encoding) {
+        case TEXT:
+            put("A={");
+            putSequence(setA, ", ");
+            put("}, B={");
+            putSequence(setB, ", ");
+            put("}\n");
+            break;
+        case JSON_LINES:
+            put("{\"A\":");
+            putArray(setA);
+            put(",\"B\":");
+            putArray(setB);
+            put("}\n");
+            break;
+        default:
+            put(static_cast<char>(PARTITION));
+            putBinaryArray(setA);
+            putBinaryArray(setB);
+            break;
+    }
+}
+
+template void ResultWriter::writeMatrix(const BasicGraph<int8_t> &);
+template void ResultWriter::writeMatrix(const BasicGraph<int16_t> &);
+template void ResultWriter::writeMatrix(const BasicGraph<int> &);
+template void ResultWriter::writeMatrix(const BasicGraph<int64_t> &);
+template void ResultWriter::writeMatrix(const BasicGraph<float> &);
+template void ResultWriter::writeMatrix(const BasicGraph<double> &);
@@ -0,0 +1,84 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include "Graph.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Buffered output of matrices and query results, for dumps too large to go through iostreams.
+ *
+ * Records are encoded into a fixed buffer that is handed to the sink only when it fills up and on flush, so there is
+ * no flush per row and no allocation per record. Integers are formatted by hand. The sink is a file descriptor or a
+ * caller string the output is appended to.
+ *
+ * Floating-point weights are written in the shortest form that reads back exactly; JSON_LINES writes null for
+ * infinities and NaN, which JSON cannot represent.
+ *
+ * Encodings, one record per write call:
+ * - TEXT: the formats printed by this project: matrix rows of space-terminated cells, "0->1->2" for paths and
+ *   cycles (-1 for no path), "A={0, 2}, B={1, 3}" for partitions, each followed by a newline.
+ * - JSON_LINES: one JSON object per line: {"matrix":[[0,1],[1,0]]}, {"path":[0,1,2]} ({"path":null} for no path),
+ *   {"cycle":[0,1,2,0]}, {"A":[0,2],"B":[1,3]}.
+ * - BINARY: native byte order, a uint8 record kind (RecordKind) followed by
+ *     matrix:    uint32 V | uint8 weight size | uint8 1 for floating point weights | V * V weights (row major)
+ *     path:      uint32 n | int32 vertices[n] (n = 0 for no path)
+ *     cycle:     uint32 n | int32 vertices[n]
+ *     partition: uint32 |A| | int32 A[|A|] | uint32 |B| | int32 B[|B|]
+ */
+class ResultWriter{
+public:
+    enum Encoding {
+        TEXT,
+        JSON_LINES,
+        BINARY
+    };
+
+    enum RecordKind {
+        MATRIX = 1,
+        PATH = 2,
+        CYCLE = 3,
+        PARTITION = 4
+    };
+
+private:
+    int fd;              // -1 when writing to target
+    std::string *target;
+    Encoding encoding;
+    std::vector<char> buffer;
+    size_t used;
+
+    void put(char c);
+    void put(const char *text);
+    void putBytes(const void *data, size_t size);
+    void putInt(long long value);
+    template <typename Real> void putReal(Real value);
+    void putSequence(const std::vector<int> &vertices, const char *separator);
+    void putArray(const std::vector<int> &vertices);
+    void putBinaryArray(const std::vector<int> &vertices);
+    template <typename Weight> void putWeight(Weight weight);
+
+public:
+    static const size_t DEFAULT_BUFFER_SIZE = 1 << 16;
+
+    //methods
+    template <typename Weight> void writeMatrix(const BasicGraph<Weight> &g);
+    void writePath(const std::vector<int> &vertices);
+    void writeCycle(const std::vector<int> &vertices);
+    void writePartition(const std::vector<int> &setA, const std::vector<int> &setB);
+    void flush();
+
+    //constructors
+    ResultWriter(int outFd, Encoding outEncoding, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ResultWriter(std::string &out, Encoding outEncoding, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ResultWriter(const ResultWriter &) = delete;
+    ResultWriter &operator=(const ResultWriter &) = delete;
+
+    ~ResultWriter();
+
+    Encoding getEncoding() const{
+        return encoding;
+    }
+};
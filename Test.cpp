@@ -1,368 +1,2276 @@
-//mail: guyes134@gmail.com
-
-#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
-
-#include <doctest/doctest.h>
-#include "Algorithms.hpp"
-#include "Graph.hpp"
-
-using namespace std;
-
-TEST_CASE("Graph constructor and properties") {
-    SUBCASE("directed graph") {
-        std::vector<std::vector<int>> matrix = {
-                {0, 1, 0},
-                {1, 0, 1},
-                {0, 1, 0}
-        };
-        Graph g(matrix, false, false, false, 3, 3);
-        CHECK(g.isDirectedGraph() == false);
-        CHECK(g.getVertexNum() == 3);
-        CHECK(g.getEdgesNum() == 3);
-        CHECK(g.isSquare(matrix) == true);
-        CHECK(g.hasNegativeWeights() == false);
-        CHECK(g.isDirectedGraph() == false);
-    }
-
-    SUBCASE("undirected graph") {
-        std::vector<std::vector<int>> directedMatrix = {
-                {0, 1, 0},
-                {0, 0, 1},
-                {1, 0, 0}
-        };
-        Graph g2(directedMatrix, true, false, false, 3, 3);
-        CHECK(g2.isDirectedGraph() == true);
-        CHECK(g2.getVertexNum() == 3);
-        CHECK(g2.getEdgesNum() == 3);
-        CHECK(g2.isSquare(directedMatrix) == true);
-        CHECK(g2.hasNegativeWeights() == false);
-        CHECK(g2.isDirectedGraph() == true);
-    }
-}
-
-// Test loadGraph method
-TEST_CASE("Graph loadGraph method") {
-    Graph g;
-    SUBCASE("Empty graph") {
-        vector<vector<int>> emptyGraph = {};
-        g.loadGraph(emptyGraph);
-        CHECK(Algorithms::isConnected(g) == 0);
-    }
-    SUBCASE("Single vertex graph") {
-        vector<vector<int>> singleVertexGraph = {{0}};
-        g.loadGraph(singleVertexGraph);
-        CHECK(Algorithms::isConnected(g) == 1);
-    }
-    SUBCASE("Disconnected graph") {
-        vector<vector<int>> disconnectedGraph = {
-                {0, 1, 0, 0},
-                {1, 0, 0, 0},
-                {0, 0, 0, 1},
-                {0, 0, 1, 0}
-        };
-        g.loadGraph(disconnectedGraph);
-        CHECK(Algorithms::isConnected(g) == 0);
-    }
-    SUBCASE("directed graph") {
-        vector<std::vector<int>> matrix = {
-                {0, 1, 0, 0},
-                {1, 0, 1, 0},
-                {0, 1, 0, 1},
-                {0, 0, 1, 0}
-        };
-        g.loadGraph(matrix);
-        CHECK(g.getVertexNum() == 4);
-        CHECK(g.getEdgesNum() == 3);
-        CHECK(g.isDirectedGraph() == false);
-        CHECK(g.isSquare(matrix) == true);
-        CHECK(g.getIsWeighted() == false);
-        CHECK(g.hasNegativeWeights() == false);
-    }
-
-    SUBCASE("undirected graph"){
-        std::vector<std::vector<int>> largeMatrix = {
-                {0, 1, 0, 0, 0, 0, 1, 0, 0, 0},
-                {1, 0, 1, 0, 0, 0, 0, 1, 0, 0},
-                {0, 1, 0, 1, 0, 0, 0, 0, 1, 0},
-                {0, 0, 1, 0, 1, 0, 0, 0, 0, 1},
-                {0, 0, 0, 1, 0, 1, 0, 0, 0, 0},
-                {0, 0, 0, 0, 1, 0, 1, 0, 0, 0},
-                {1, 0, 0, 0, 0, 1, 0, 1, 0, 0},
-                {0, 1, 0, 0, 0, 0, 1, 0, 1, 0},
-                {0, 0, 1, 0, 0, 0, 0, 1, 0, 1},
-                {0, 0, 0, 1, 0, 0, 0, 0, 1, 0}
-        };
-
-        g.loadGraph(largeMatrix);
-        CHECK(g.isDirectedGraph() == false);
-        CHECK(g.isSquare(largeMatrix) == true);
-        CHECK(g.getEdgesNum() == 13);
-        CHECK(g.hasNegativeWeights() == false);
-
-    }
-}
-
-// Test the printGraph method
-TEST_CASE("Graph printGraph method") {
-    vector<vector<int>> matrix = {
-            {0, 1, 0},
-            {1, 0, 1},
-            {0, 1, 0}
-    };
-    Graph g(matrix, false, false, false, 3, 3);
-    g.printGraph();
-}
-
-// Test the shortestPath method
-TEST_CASE("shortestPath method") {
-    Graph g;
-    SUBCASE("directed graph") {
-        std::vector<std::vector<int>> matrix = {
-                {0, 1, 0, 0, 0, 0},
-                {1, 0, 1, 0, 0, 0},
-                {0, 1, 0, 1, 0, 0},
-                {0, 0, 1, 0, 1, 0},
-                {0, 0, 0, 1, 0, 1},
-                {0, 0, 0, 0, 1, 0}
-        };
-        g.loadGraph(matrix);
-        CHECK(Algorithms::shortestPath(g, 0, 5) == "0->1->2->3->4->5");
-    }
-
-    SUBCASE("unweighted undirected graph") {
-        std::vector<std::vector<int>> matrix = {
-                {0, 1, 0, 0, 0, 0, 1, 0, 0, 0},
-                {1, 0, 1, 0, 0, 0, 0, 1, 0, 0},
-                {0, 1, 0, 1, 0, 0, 0, 0, 1, 0},
-                {0, 0, 1, 0, 1, 0, 0, 0, 0, 1},
-                {0, 0, 0, 1, 0, 1, 0, 0, 0, 0},
-                {0, 0, 0, 0, 1, 0, 1, 0, 0, 0},
-                {1, 0, 0, 0, 0, 1, 0, 1, 0, 0},
-                {0, 1, 0, 0, 0, 0, 1, 0, 1, 0},
-                {0, 0, 1, 0, 0, 0, 0, 1, 0, 1},
-                {0, 0, 0, 1, 0, 0, 0, 0, 1, 0}
-        };
-        g.loadGraph(matrix);
-        CHECK(Algorithms::shortestPath(g, 0, 9) == "0->1->2->3->9");
-    }
-
-    SUBCASE("weighted undirected graph") {
-        std::vector<std::vector<int>> matrix = {
-                {0, 2, 0, 0, 0, 0, 1, 0, 0, 0},
-                {2, 0, 3, 0, 0, 0, 0, 1, 0, 0},
-                {0, 3, 0, 1, 0, 0, 0, 0, 2, 0},
-                {0, 0, 1, 0, 4, 0, 0, 0, 0, 1},
-                {0, 0, 0, 4, 0, 1, 0, 0, 0, 0},
-                {0, 0, 0, 0, 1, 0, 2, 0, 0, 0},
-                {1, 0, 0, 0, 0, 2, 0, 1, 0, 0},
-                {0, 1, 0, 0, 0, 0, 1, 0, 3, 0},
-                {0, 0, 2, 0, 0, 0, 0, 3, 0, 1},
-                {0, 0, 0, 1, 0, 0, 0, 0, 1, 0}
-        };
-        g.loadGraph(matrix);
-        CHECK(Algorithms::shortestPath(g, 0, 9) == "0->6->7->8->9");
-    }
-    SUBCASE("Directed graph with no path") {
-        vector<vector<int>> directedGraphNoPath = {
-                {0, 1, 0, 0},
-                {0, 0, 1, 0},
-                {0, 0, 0, 0},
-                {0, 0, 0, 0}
-        };
-        g.loadGraph(directedGraphNoPath);
-        CHECK(Algorithms::shortestPath(g, 0, 3) == "-1");
-    }
-    SUBCASE("Single node graph") {
-        vector<vector<int>> singleNodeGraph = {
-                {0}
-        };
-        g.loadGraph(singleNodeGraph);
-        CHECK(Algorithms::shortestPath(g, 0, 0) == "0");
-    }
-    SUBCASE("Graph with multiple shortest paths") {
-        vector<vector<int>> multiplePathsGraph = {
-                {0, 1, 1, 0},
-                {1, 0, 0, 1},
-                {1, 0, 0, 1},
-                {0, 1, 1, 0}
-        };
-        g.loadGraph(multiplePathsGraph);
-        string result = Algorithms::shortestPath(g, 0, 3);
-        bool ans = (result == "0->1->3" || "0->2->3");
-        CHECK(ans);
-    }
-    SUBCASE("Very short path") {
-        vector<vector<int>> largeGraph = {
-                {0, 1, 0, 0, 0, 0, 0, 0, 1},
-                {1, 0, 1, 0, 0, 0, 0, 1, 0},
-                {0, 1, 0, 1, 0, 0, 1, 0, 0},
-                {0, 0, 1, 0, 1, 1, 0, 0, 0},
-                {0, 0, 0, 1, 0, 1, 0, 0, 0},
-                {0, 0, 0, 1, 1, 0, 1, 0, 0},
-                {0, 0, 1, 0, 0, 1, 0, 1, 0},
-                {0, 1, 0, 0, 0, 0, 1, 0, 1},
-                {1, 0, 0, 0, 0, 0, 0, 1, 0}
-        };
-        g.loadGraph(largeGraph);
-        CHECK(Algorithms::shortestPath(g, 0, 8) == "0->8");
-    }
-}
-
-
-// Test the isContainsCycle method
-TEST_CASE("isContainsCycle method") {
-    Graph g;
-    SUBCASE("Empty graph") {
-        vector<vector<int>> emptyGraph = {};
-        g.loadGraph(emptyGraph);
-        CHECK(Algorithms::isContainsCycle(g) == "0");
-    }
-    SUBCASE("Single vertex graph"){
-        vector<vector<int>> singleVertexGraph = {{0}};
-        g.loadGraph(singleVertexGraph);
-        CHECK(Algorithms::isContainsCycle(g) == "0");
-    }
-    SUBCASE("matrix without cycle") {
-        std::vector<std::vector<int>> matrix = {
-                {0, 1, 0, 0},
-                {1, 0, 1, 0},
-                {0, 1, 0, 1},
-                {0, 0, 1, 0}
-        };
-        g.loadGraph(matrix);
-        CHECK(Algorithms::isContainsCycle(g) == "0");
-
-        std::vector<std::vector<int>> largeMatrix = {
-                {0, 1, 0, 0, 0, 0, 0, 0, 0, 0},
-                {1, 0, 1, 0, 0, 0, 0, 0, 0, 0},
-                {0, 1, 0, 1, 0, 0, 0, 0, 0, 0},
-                {0, 0, 1, 0, 1, 0, 0, 0, 0, 0},
-                {0, 0, 0, 1, 0, 1, 0, 0, 0, 0},
-                {0, 0, 0, 0, 1, 0, 1, 0, 0, 0},
-                {0, 0, 0, 0, 0, 1, 0, 1, 0, 0},
-                {0, 0, 0, 0, 0, 0, 1, 0, 1, 0},
-                {0, 0, 0, 0, 0, 0, 0, 1, 0, 1},
-                {0, 0, 0, 0, 0, 0, 0, 0, 1, 0}
-        };
-        g.loadGraph(largeMatrix);
-        CHECK(Algorithms::isContainsCycle(g) == "0");
-    }
-
-    SUBCASE("matrix with cycle") {
-        std::vector<std::vector<int>> matrix2 = {
-                {0, 1, 0, 1},
-                {1, 0, 1, 0},
-                {0, 1, 0, 1},
-                {1, 0, 1, 0}
-        };
-        g.loadGraph(matrix2);
-        CHECK(Algorithms::isContainsCycle(g) == "The cycle is: 3->0->1->2->3");
-
-        std::vector<std::vector<int>> largeMatrixWithCycle = {
-                {0, 1, 0, 0, 0, 0, 0, 0, 0, 1},
-                {1, 0, 1, 0, 0, 0, 0, 0, 0, 0},
-                {0, 1, 0, 1, 0, 0, 0, 0, 0, 0},
-                {0, 0, 1, 0, 1, 0, 0, 0, 0, 0},
-                {0, 0, 0, 1, 0, 1, 0, 0, 0, 0},
-                {0, 0, 0, 0, 1, 0, 1, 0, 0, 0},
-                {0, 0, 0, 0, 0, 1, 0, 1, 0, 0},
-                {0, 0, 0, 0, 0, 0, 1, 0, 1, 0},
-                {0, 0, 0, 0, 0, 0, 0, 1, 0, 1},
-                {1, 0, 0, 0, 0, 0, 0, 0, 1, 0}
-        };
-        Graph g4(largeMatrixWithCycle, false, false, false, 10, 10);
-        CHECK(Algorithms::isContainsCycle(g4) != "0");
-    }
-}
-
-// Test the isBipartite method
-TEST_CASE("isBipartite method") {
-    SUBCASE("is bipartite") {
-        vector<vector<int>> matrix = {
-                {0, 1, 0, 0},
-                {1, 0, 1, 0},
-                {0, 1, 0, 1},
-                {0, 0, 1, 0}
-        };
-        Graph g(matrix, false, false, false, 4, 4);
-        CHECK(Algorithms::isBipartite(g) == "The graph is bipartite: A={0, 2}, B={1, 3}");
-    }
-
-    SUBCASE("is'nt bipartite") {
-        std::vector<std::vector<int>> matrix2 = {
-                {0, 1, 1, 0},
-                {1, 0, 1, 0},
-                {1, 1, 0, 1},
-                {0, 0, 1, 0}
-        };
-        Graph g2(matrix2, false, false, false, 4, 5);
-        CHECK(Algorithms::isBipartite(g2) == "0");
-
-        std::vector<std::vector<int>> largeMatrix = {
-                {0, 1, 0, 0, 0, 0, 1, 0, 0, 0},
-                {1, 0, 1, 0, 0, 0, 0, 1, 0, 0},
-                {0, 1, 0, 1, 0, 0, 0, 0, 1, 0},
-                {0, 0, 1, 0, 1, 0, 0, 0, 0, 1},
-                {0, 0, 0, 1, 0, 1, 0, 0, 0, 0},
-                {0, 0, 0, 0, 1, 0, 1, 0, 0, 0},
-                {1, 0, 0, 0, 0, 1, 0, 1, 0, 0},
-                {0, 1, 0, 0, 0, 0, 1, 0, 1, 0},
-                {0, 0, 1, 0, 0, 0, 0, 1, 0, 1},
-                {0, 0, 0, 1, 0, 0, 0, 0, 1, 0}
-        };
-        Graph g3(largeMatrix, false, false, false, 10, 14);
-        CHECK(Algorithms::isBipartite(g3) == "0");
-    }
-}
-
-// Test the negativeCycle method
-TEST_CASE("negativeCycle method") {
-    SUBCASE("graph without negative cycle") {
-        std::vector<std::vector<int>> matrix = {
-                {0,  -1, 0,  0},
-                {-1, 0,  -1, 0},
-                {0,  -1, 0,  -1},
-                {0,  0,  -1, 0}
-        };
-        Graph g(matrix, true, true, true, 4, 4);
-        CHECK(Algorithms::negativeCycle(g) == "0");
-
-        std::vector<std::vector<int>> matrix2 = {
-                {0, 1, 0, 0},
-                {1, 0, 1, 0},
-                {0, 1, 0, 1},
-                {0, 0, 1, 0}
-        };
-        g.loadGraph(matrix2);
-        CHECK(Algorithms::negativeCycle(g) == "0");
-
-        vector<vector<int>> matrix3 = {
-                {0,    -1,   1000},
-                {-1,   0,    1000},
-                {1000, 1000, 0}
-        };
-        g.loadGraph(matrix3);
-        CHECK(Algorithms::negativeCycle(g) == "0");
-
-        vector<vector<int>> matrix4 = {
-                {0, 1, 0,  8},
-                {1, 0, 8,  8},
-                {8, 3, 0,  -1},
-                {0, 8, -1, 0}
-        };
-        g.loadGraph(matrix4);
-        CHECK(Algorithms::negativeCycle(g) == "0");
-    }
-
-    SUBCASE("graph with negative cycle") {
-        Graph g;
-        vector<vector<int>> matrix1 = {
-                {0,  -1, 7,  8},
-                {10, 0,  -1, 6},
-                {9,  9,  0,  -1},
-                {-1, 7,  8,  0}
-        };
-        g.loadGraph(matrix1);
-        CHECK(Algorithms::negativeCycle(g) == "The negative weight cycle is: 1->2->3->0->1");
-    }
-}
+//mail: guyes134@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include "Algorithms.hpp"
+#include "Graph.hpp"
+#include "GraphView.hpp"
+#include "GraphFile.hpp"
+#include "GraphParser.hpp"
+#include "GraphGenerator.hpp"
+#include "AlgoStats.hpp"
+#include "Trace.hpp"
+#include "GraphStore.hpp"
+#include "ThreadPool.hpp"
+#include "GraphServer.hpp"
+#include "GraphReorder.hpp"
+#include "PartitionedGraph.hpp"
+#include "ResultWriter.hpp"
+#include "DynamicSSSP.hpp"
+#include "ExternalGraph.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <atomic>
+
+using namespace std;
+
+TEST_CASE("Graph constructor and properties") {
+    SUBCASE("directed graph") {
+        std::vector<std::vector<int>> matrix = {
+                {0, 1, 0},
+                {1, 0, 1},
+                {0, 1, 0}
+        };
+        Graph g(matrix, false, false, false, 3, 3);
+        CHECK(g.isDirectedGraph() == false);
+        CHECK(g.getVertexNum() == 3);
+        CHECK(g.getEdgesNum() == 3);
+        CHECK(g.isSquare(matrix) == true);
+        CHECK(g.hasNegativeWeights() == false);
+        CHECK(g.isDirectedGraph() == false);
+    }
+
+    SUBCASE("undirected graph") {
+        std::vector<std::vector<int>> directedMatrix = {
+                {0, 1, 0},
+                {0, 0, 1},
+                {1, 0, 0}
+        };
+        Graph g2(directedMatrix, true, false, false, 3, 3);
+        CHECK(g2.isDirectedGraph() == true);
+        CHECK(g2.getVertexNum() == 3);
+        CHECK(g2.getEdgesNum() == 3);
+        CHECK(g2.isSquare(directedMatrix) == true);
+        CHECK(g2.hasNegativeWeights() == false);
+        CHECK(g2.isDirectedGraph() == true);
+    }
+}
+
+// Test loadGraph method
+TEST_CASE("Graph loadGraph method") {
+    Graph g;
+    SUBCASE("Empty graph") {
+        vector<vector<int>> emptyGraph = {};
+        g.loadGraph(emptyGraph);
+        CHECK(Algorithms::isConnected(g) == 0);
+    }
+    SUBCASE("Single vertex graph") {
+        vector<vector<int>> singleVertexGraph = {{0}};
+        g.loadGraph(singleVertexGraph);
+        CHECK(Algorithms::isConnected(g) == 1);
+    }
+    SUBCASE("Disconnected graph") {
+        vector<vector<int>> disconnectedGraph = {
+                {0, 1, 0, 0},
+                {1, 0, 0, 0},
+                {0, 0, 0, 1},
+                {0, 0, 1, 0}
+        };
+        g.loadGraph(disconnectedGraph);
+        CHECK(Algorithms::isConnected(g) == 0);
+    }
+    SUBCASE("directed graph") {
+        vector<std::vector<int>> matrix = {
+                {0, 1, 0, 0},
+                {1, 0, 1, 0},
+                {0, 1, 0, 1},
+                {0, 0, 1, 0}
+        };
+        g.loadGraph(matrix);
+        CHECK(g.getVertexNum() == 4);
+        CHECK(g.getEdgesNum() == 3);
+        CHECK(g.isDirectedGraph() == false);
+        CHECK(g.isSquare(matrix) == true);
+        CHECK(g.getIsWeighted() == false);
+        CHECK(g.hasNegativeWeights() == false);
+    }
+
+    SUBCASE("undirected graph"){
+        std::vector<std::vector<int>> largeMatrix = {
+                {0, 1, 0, 0, 0, 0, 1, 0, 0, 0},
+                {1, 0, 1, 0, 0, 0, 0, 1, 0, 0},
+                {0, 1, 0, 1, 0, 0, 0, 0, 1, 0},
+                {0, 0, 1, 0, 1, 0, 0, 0, 0, 1},
+                {0, 0, 0, 1, 0, 1, 0, 0, 0, 0},
+                {0, 0, 0, 0, 1, 0, 1, 0, 0, 0},
+                {1, 0, 0, 0, 0, 1, 0, 1, 0, 0},
+                {0, 1, 0, 0, 0, 0, 1, 0, 1, 0},
+                {0, 0, 1, 0, 0, 0, 0, 1, 0, 1},
+                {0, 0, 0, 1, 0, 0, 0, 0, 1, 0}
+        };
+
+        g.loadGraph(largeMatrix);
+        CHECK(g.isDirectedGraph() == false);
+        CHECK(g.isSquare(largeMatrix) == true);
+        CHECK(g.getEdgesNum() == 13);
+        CHECK(g.hasNegativeWeights() == false);
+
+    }
+
+    SUBCASE("moved matrix and lazy properties") {
+        vector<vector<int>> matrix = {
+                {0, 2, 0},
+                {2, 0, 1},
+                {0, 1, 0}
+        };
+        const int *row = matrix[1].data();
+        g.loadGraph(std::move(matrix));
+        CHECK(matrix.empty());
+        CHECK(g.getAdjacencyMatrix()[1].data() == row); // The storage was handed over, not copied
+        CHECK(g.getEdgesNum() == 2);
+        CHECK(g.getIsWeighted() == true);
+        CHECK(g.getIsDirected() == false);
+
+        g.setEdge(0, 1, -3); // Every property is recomputed after a change
+        CHECK(g.getIsDirected() == true);
+        CHECK(g.getHasNegEdges() == true);
+        CHECK(g.getEdgesNum() == 4);
+
+        Graph copy(g);
+        Graph moved(std::move(g));
+        CHECK(moved.getAdjacencyMatrix()[1].data() == row);
+        CHECK(moved.getEdgesNum() == 4);
+        CHECK(copy.getAdjacencyMatrix() == moved.getAdjacencyMatrix());
+        CHECK(g.getVertexNum() == 0);
+        CHECK(g.getEdgesNum() == 0);
+
+        vector<vector<int>> notSquare = {{0, 1}};
+        CHECK_THROWS_AS(g.loadGraph(std::move(notSquare)), std::invalid_argument);
+        CHECK(notSquare.size() == 1);
+    }
+}
+
+// Test the printGraph method
+TEST_CASE("Graph printGraph method") {
+    vector<vector<int>> matrix = {
+            {0, 1, 0},
+            {1, 0, 1},
+            {0, 1, 0}
+    };
+    Graph g(matrix, false, false, false, 3, 3);
+    g.printGraph();
+}
+
+// Test the shortestPath method
+TEST_CASE("shortestPath method") {
+    Graph g;
+    SUBCASE("directed graph") {
+        std::vector<std::vector<int>> matrix = {
+                {0, 1, 0, 0, 0, 0},
+                {1, 0, 1, 0, 0, 0},
+                {0, 1, 0, 1, 0, 0},
+                {0, 0, 1, 0, 1, 0},
+                {0, 0, 0, 1, 0, 1},
+                {0, 0, 0, 0, 1, 0}
+        };
+        g.loadGraph(matrix);
+        CHECK(Algorithms::shortestPath(g, 0, 5) == "0->1->2->3->4->5");
+    }
+
+    SUBCASE("unweighted undirected graph") {
+        std::vector<std::vector<int>> matrix = {
+                {0, 1, 0, 0, 0, 0, 1, 0, 0, 0},
+                {1, 0, 1, 0, 0, 0, 0, 1, 0, 0},
+                {0, 1, 0, 1, 0, 0, 0, 0, 1, 0},
+                {0, 0, 1, 0, 1, 0, 0, 0, 0, 1},
+                {0, 0, 0, 1, 0, 1, 0, 0, 0, 0},
+                {0, 0, 0, 0, 1, 0, 1, 0, 0, 0},
+                {1, 0, 0, 0, 0, 1, 0, 1, 0, 0},
+                {0, 1, 0, 0, 0, 0, 1, 0, 1, 0},
+                {0, 0, 1, 0, 0, 0, 0, 1, 0, 1},
+                {0, 0, 0, 1, 0, 0, 0, 0, 1, 0}
+        };
+        g.loadGraph(matrix);
+        CHECK(Algorithms::shortestPath(g, 0, 9) == "0->1->2->3->9");
+    }
+
+    SUBCASE("weighted undirected graph") {
+        std::vector<std::vector<int>> matrix = {
+                {0, 2, 0, 0, 0, 0, 1, 0, 0, 0},
+                {2, 0, 3, 0, 0, 0, 0, 1, 0, 0},
+                {0, 3, 0, 1, 0, 0, 0, 0, 2, 0},
+                {0, 0, 1, 0, 4, 0, 0, 0, 0, 1},
+                {0, 0, 0, 4, 0, 1, 0, 0, 0, 0},
+                {0, 0, 0, 0, 1, 0, 2, 0, 0, 0},
+                {1, 0, 0, 0, 0, 2, 0, 1, 0, 0},
+                {0, 1, 0, 0, 0, 0, 1, 0, 3, 0},
+                {0, 0, 2, 0, 0, 0, 0, 3, 0, 1},
+                {0, 0, 0, 1, 0, 0, 0, 0, 1, 0}
+        };
+        g.loadGraph(matrix);
+        CHECK(Algorithms::shortestPath(g, 0, 9) == "0->6->7->8->9");
+    }
+    SUBCASE("Directed graph with no path") {
+        vector<vector<int>> directedGraphNoPath = {
+                {0, 1, 0, 0},
+                {0, 0, 1, 0},
+                {0, 0, 0, 0},
+                {0, 0, 0, 0}
+        };
+        g.loadGraph(directedGraphNoPath);
+        CHECK(Algorithms::shortestPath(g, 0, 3) == "-1");
+    }
+    SUBCASE("Single node graph") {
+        vector<vector<int>> singleNodeGraph = {
+                {0}
+        };
+        g.loadGraph(singleNodeGraph);
+        CHECK(Algorithms::shortestPath(g, 0, 0) == "0");
+    }
+    SUBCASE("Graph with multiple shortest paths") {
+        vector<vector<int>> multiplePathsGraph = {
+                {0, 1, 1, 0},
+                {1, 0, 0, 1},
+                {1, 0, 0, 1},
+                {0, 1, 1, 0}
+        };
+        g.loadGraph(multiplePathsGraph);
+        string result = Algorithms::shortestPath(g, 0, 3);
+        bool ans = (result == "0->1->3" || "0->2->3");
+        CHECK(ans);
+    }
+    SUBCASE("Very short path") {
+        vector<vector<int>> largeGraph = {
+                {0, 1, 0, 0, 0, 0, 0, 0, 1},
+                {1, 0, 1, 0, 0, 0, 0, 1, 0},
+                {0, 1, 0, 1, 0, 0, 1, 0, 0},
+                {0, 0, 1, 0, 1, 1, 0, 0, 0},
+                {0, 0, 0, 1, 0, 1, 0, 0, 0},
+                {0, 0, 0, 1, 1, 0, 1, 0, 0},
+                {0, 0, 1, 0, 0, 1, 0, 1, 0},
+                {0, 1, 0, 0, 0, 0, 1, 0, 1},
+                {1, 0, 0, 0, 0, 0, 0, 1, 0}
+        };
+        g.loadGraph(largeGraph);
+        CHECK(Algorithms::shortestPath(g, 0, 8) == "0->8");
+    }
+}
+
+
+// Test the isContainsCycle method
+TEST_CASE("isContainsCycle method") {
+    Graph g;
+    SUBCASE("Empty graph") {
+        vector<vector<int>> emptyGraph = {};
+        g.loadGraph(emptyGraph);
+        CHECK(Algorithms::isContainsCycle(g) == "0");
+    }
+    SUBCASE("Single vertex graph"){
+        vector<vector<int>> singleVertexGraph = {{0}};
+        g.loadGraph(singleVertexGraph);
+        CHECK(Algorithms::isContainsCycle(g) == "0");
+    }
+    SUBCASE("matrix without cycle") {
+        std::vector<std::vector<int>> matrix = {
+                {0, 1, 0, 0},
+                {1, 0, 1, 0},
+                {0, 1, 0, 1},
+                {0, 0, 1, 0}
+        };
+        g.loadGraph(matrix);
+        CHECK(Algorithms::isContainsCycle(g) == "0");
+
+        std::vector<std::vector<int>> largeMatrix = {
+                {0, 1, 0, 0, 0, 0, 0, 0, 0, 0},
+                {1, 0, 1, 0, 0, 0, 0, 0, 0, 0},
+                {0, 1, 0, 1, 0, 0, 0, 0, 0, 0},
+                {0, 0, 1, 0, 1, 0, 0, 0, 0, 0},
+                {0, 0, 0, 1, 0, 1, 0, 0, 0, 0},
+                {0, 0, 0, 0, 1, 0, 1, 0, 0, 0},
+                {0, 0, 0, 0, 0, 1, 0, 1, 0, 0},
+                {0, 0, 0, 0, 0, 0, 1, 0, 1, 0},
+                {0, 0, 0, 0, 0, 0, 0, 1, 0, 1},
+                {0, 0, 0, 0, 0, 0, 0, 0, 1, 0}
+        };
+        g.loadGraph(largeMatrix);
+        CHECK(Algorithms::isContainsCycle(g) == "0");
+    }
+
+    SUBCASE("matrix with cycle") {
+        std::vector<std::vector<int>> matrix2 = {
+                {0, 1, 0, 1},
+                {1, 0, 1, 0},
+                {0, 1, 0, 1},
+                {1, 0, 1, 0}
+        };
+        g.loadGraph(matrix2);
+        CHECK(Algorithms::isContainsCycle(g) == "The cycle is: 3->0->1->2->3");
+
+        std::vector<std::vector<int>> largeMatrixWithCycle = {
+                {0, 1, 0, 0, 0, 0, 0, 0, 0, 1},
+                {1, 0, 1, 0, 0, 0, 0, 0, 0, 0},
+                {0, 1, 0, 1, 0, 0, 0, 0, 0, 0},
+                {0, 0, 1, 0, 1, 0, 0, 0, 0, 0},
+                {0, 0, 0, 1, 0, 1, 0, 0, 0, 0},
+                {0, 0, 0, 0, 1, 0, 1, 0, 0, 0},
+                {0, 0, 0, 0, 0, 1, 0, 1, 0, 0},
+                {0, 0, 0, 0, 0, 0, 1, 0, 1, 0},
+                {0, 0, 0, 0, 0, 0, 0, 1, 0, 1},
+                {1, 0, 0, 0, 0, 0, 0, 0, 1, 0}
+        };
+        Graph g4(largeMatrixWithCycle, false, false, false, 10, 10);
+        CHECK(Algorithms::isContainsCycle(g4) != "0");
+    }
+}
+
+// Test the isBipartite method
+TEST_CASE("isBipartite method") {
+    SUBCASE("is bipartite") {
+        vector<vector<int>> matrix = {
+                {0, 1, 0, 0},
+                {1, 0, 1, 0},
+                {0, 1, 0, 1},
+                {0, 0, 1, 0}
+        };
+        Graph g(matrix, false, false, false, 4, 4);
+        CHECK(Algorithms::isBipartite(g) == "The graph is bipartite: A={0, 2}, B={1, 3}");
+    }
+
+    SUBCASE("is'nt bipartite") {
+        std::vector<std::vector<int>> matrix2 = {
+                {0, 1, 1, 0},
+                {1, 0, 1, 0},
+                {1, 1, 0, 1},
+                {0, 0, 1, 0}
+        };
+        Graph g2(matrix2, false, false, false, 4, 5);
+        CHECK(Algorithms::isBipartite(g2) == "0");
+
+        std::vector<std::vector<int>> largeMatrix = {
+                {0, 1, 0, 0, 0, 0, 1, 0, 0, 0},
+                {1, 0, 1, 0, 0, 0, 0, 1, 0, 0},
+                {0, 1, 0, 1, 0, 0, 0, 0, 1, 0},
+                {0, 0, 1, 0, 1, 0, 0, 0, 0, 1},
+                {0, 0, 0, 1, 0, 1, 0, 0, 0, 0},
+                {0, 0, 0, 0, 1, 0, 1, 0, 0, 0},
+                {1, 0, 0, 0, 0, 1, 0, 1, 0, 0},
+                {0, 1, 0, 0, 0, 0, 1, 0, 1, 0},
+                {0, 0, 1, 0, 0, 0, 0, 1, 0, 1},
+                {0, 0, 0, 1, 0, 0, 0, 0, 1, 0}
+        };
+        Graph g3(largeMatrix, false, false, false, 10, 14);
+        CHECK(Algorithms::isBipartite(g3) == "0");
+    }
+}
+
+// Test the maximumMatching method
+TEST_CASE("maximumMatching method") {
+    SUBCASE("small graphs") {
+        vector<vector<int>> matrix = {
+                {0, 1, 0, 0},
+                {1, 0, 1, 0},
+                {0, 1, 0, 1},
+                {0, 0, 1, 0}
+        };
+        Graph g(matrix, false, false, false, 4, 3);
+        vector<pair<int, int>> matching;
+        vector<int> cover;
+        CHECK(Algorithms::maximumMatching(g, matching, cover) == true);
+        CHECK(matching == vector<pair<int, int>>{{0, 1}, {2, 3}});
+        CHECK(cover.size() == 2);
+
+        // A star matches one leaf and is covered by its center
+        vector<vector<int>> star = {
+                {0, 1, 1, 1},
+                {1, 0, 0, 0},
+                {1, 0, 0, 0},
+                {1, 0, 0, 0}
+        };
+        Graph s(star, false, false, false, 4, 3);
+        CHECK(Algorithms::maximumMatching(s, matching, cover) == true);
+        CHECK(matching.size() == 1);
+        CHECK(cover == vector<int>{0});
+
+        std::vector<std::vector<int>> triangle = {
+                {0, 1, 1},
+                {1, 0, 1},
+                {1, 1, 0}
+        };
+        Graph t(triangle, false, false, false, 3, 3);
+        CHECK(Algorithms::maximumMatching(t, matching, cover) == false);
+        CHECK(matching.empty());
+        CHECK(cover.empty());
+    }
+
+    SUBCASE("random bipartite graphs") {
+        GraphGenerator::Options options;
+        for (uint64_t seed = 1; seed <= 20; ++seed) {
+            options.seed = seed;
+            Graph g;
+            GraphGenerator::bipartite(g, 12, 15, 0.15, options);
+            const vector<vector<int>> &m = g.getAdjacencyMatrix();
+            vector<pair<int, int>> matching;
+            vector<int> cover;
+            REQUIRE(Algorithms::maximumMatching(g, matching, cover) == true);
+
+            // Simple augmenting paths from every left vertex give the maximum matching size
+            vector<int> matchOf(27, -1);
+            std::function<bool(int, vector<char> &)> augment = [&](int u, vector<char> &seen) {
+                for (int v = 12; v < 27; ++v) {
+                    if (m[u][v] != 0 && !seen[v]) {
+                        seen[v] = true;
+                        if (matchOf[v] == -1 || augment(matchOf[v], seen)) {
+                            matchOf[v] = u;
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            };
+            size_t expected = 0;
+            for (int u = 0; u < 12; ++u) {
+                vector<char> seen(27, false);
+                expected += augment(u, seen) ? 1 : 0;
+            }
+            CHECK(matching.size() == expected);
+            CHECK(cover.size() == expected);
+
+            vector<char> used(27, false);
+            vector<char> covered(27, false);
+            for (const pair<int, int> &edge : matching) {
+                CHECK(m[edge.first][edge.second] != 0);
+                CHECK(!used[edge.first]);
+                CHECK(!used[edge.second]);
+                used[edge.first] = used[edge.second] = true;
+            }
+            for (int v : cover) {
+                covered[v] = true;
+            }
+            bool coversEdges = true;
+            for (int u = 0; u < 27; ++u) {
+                for (int v = 0; v < 27; ++v) {
+                    if (m[u][v] != 0 && !covered[u] && !covered[v]) {
+                        coversEdges = false;
+                    }
+                }
+            }
+            CHECK(coversEdges);
+        }
+    }
+}
+
+// Test the minimumSpanningForest method
+TEST_CASE("minimumSpanningForest method") {
+    SUBCASE("small graphs") {
+        vector<vector<int>> matrix = {
+                {0, 4, 1, 0, 0},
+                {4, 0, 2, 5, 0},
+                {1, 2, 0, 8, 0},
+                {0, 5, 8, 0, 0},
+                {0, 0, 0, 0, 0}
+        };
+        Graph g;
+        g.loadGraph(matrix);
+        CHECK(g.getIsWeighted() == true);
+        CHECK(g.getHasNegEdges() == false);
+        vector<pair<int, int>> edges;
+        long long total = -1;
+        CHECK(Algorithms::PrimMSF(g, edges, total) == true);
+        CHECK(edges == vector<pair<int, int>>{{0, 2}, {1, 2}, {1, 3}});
+        CHECK(total == 8);
+        CHECK(Algorithms::BoruvkaMSF(g, edges, total) == true);
+        CHECK(edges == vector<pair<int, int>>{{0, 2}, {1, 2}, {1, 3}});
+        CHECK(total == 8);
+        CHECK(Algorithms::isConnected(g) == 0);
+
+        vector<vector<int>> directed = {
+                {0, 1},
+                {0, 0}
+        };
+        Graph d(directed, true, false, false, 2, 1);
+        CHECK(Algorithms::minimumSpanningForest(d, edges, total) == false);
+        CHECK(edges.empty());
+    }
+
+    SUBCASE("engines agree") {
+        ThreadPool pool(4);
+        GraphGenerator::Options options;
+        options.minWeight = -5;
+        options.maxWeight = 5;
+        for (uint64_t seed = 1; seed <= 10; ++seed) {
+            options.seed = seed;
+            Graph g;
+            GraphGenerator::erdosRenyi(g, 120, seed % 2 == 0 ? 0.01 : 0.2, options);
+            vector<pair<int, int>> prim;
+            vector<pair<int, int>> boruvka;
+            vector<pair<int, int>> automatic;
+            long long primTotal = 0;
+            long long boruvkaTotal = 0;
+            long long automaticTotal = 0;
+            CHECK(Algorithms::PrimMSF(g, prim, primTotal) == true);
+            CHECK(Algorithms::BoruvkaMSF(g, boruvka, boruvkaTotal, ExecutionContext(&pool)) == true);
+            CHECK(Algorithms::minimumSpanningForest(g, automatic, automaticTotal, ExecutionContext(&pool)) == true);
+            CHECK(prim == boruvka);
+            CHECK(prim == automatic);
+            CHECK(primTotal == boruvkaTotal);
+            CHECK(primTotal == automaticTotal);
+
+            int componentNum = 0;
+            Algorithms::stronglyConnectedComponents(g, componentNum);
+            CHECK(static_cast<int>(prim.size()) == 120 - componentNum);
+            CHECK((prim.size() == 119) == (Algorithms::isConnected(g) == 1));
+        }
+    }
+}
+
+// Test the negativeCycle method
+TEST_CASE("negativeCycle method") {
+    SUBCASE("graph without negative cycle") {
+        std::vector<std::vector<int>> matrix = {
+                {0,  -1, 0,  0},
+                {-1, 0,  -1, 0},
+                {0,  -1, 0,  -1},
+                {0,  0,  -1, 0}
+        };
+        Graph g(matrix, true, true, true, 4, 4);
+        CHECK(Algorithms::negativeCycle(g) == "0");
+
+        std::vector<std::vector<int>> matrix2 = {
+                {0, 1, 0, 0},
+                {1, 0, 1, 0},
+                {0, 1, 0, 1},
+                {0, 0, 1, 0}
+        };
+        g.loadGraph(matrix2);
+        CHECK(Algorithms::negativeCycle(g) == "0");
+
+        vector<vector<int>> matrix3 = {
+                {0,    -1,   1000},
+                {-1,   0,    1000},
+                {1000, 1000, 0}
+        };
+        g.loadGraph(matrix3);
+        CHECK(Algorithms::negativeCycle(g) == "0");
+
+        vector<vector<int>> matrix4 = {
+                {0, 1, 0,  8},
+                {1, 0, 8,  8},
+                {8, 3, 0,  -1},
+                {0, 8, -1, 0}
+        };
+        g.loadGraph(matrix4);
+        CHECK(Algorithms::negativeCycle(g) == "0");
+    }
+
+    SUBCASE("graph with negative cycle") {
+        Graph g;
+        vector<vector<int>> matrix1 = {
+                {0,  -1, 7,  8},
+                {10, 0,  -1, 6},
+                {9,  9,  0,  -1},
+                {-1, 7,  8,  0}
+        };
+        g.loadGraph(matrix1);
+        CHECK(Algorithms::negativeCycle(g) == "The negative weight cycle is: 1->2->3->0->1");
+    }
+}
+
+// Test the stronglyConnectedComponents method
+TEST_CASE("stronglyConnectedComponents method") {
+    Graph g;
+    vector<vector<int>> matrix = {
+            {0, 1, 0, 0, 0},
+            {0, 0, 1, 0, 0},
+            {1, 0, 0, 1, 0},
+            {0, 0, 0, 0, 1},
+            {0, 0, 0, 1, 0}
+    };
+    g.loadGraph(matrix);
+
+    SUBCASE("components and condensation") {
+        int componentNum = 0;
+        vector<int> components = Algorithms::stronglyConnectedComponents(g, componentNum);
+        CHECK(componentNum == 2);
+        CHECK(components[0] == components[1]);
+        CHECK(components[1] == components[2]);
+        CHECK(components[3] == components[4]);
+        CHECK(components[0] != components[3]);
+
+        Graph dag = Algorithms::condensationGraph(g, components, componentNum);
+        CHECK(dag.getVertexNum() == 2);
+        CHECK(dag.getEdgesNum() == 1);
+        CHECK(dag.getAdjacencyMatrix()[components[0]][components[3]] == 1);
+        CHECK(Algorithms::isContainsCycle(dag) == "0");
+    }
+
+    SUBCASE("directed graph is not strongly connected") {
+        CHECK(Algorithms::isConnected(g) == 0);
+        CHECK(Algorithms::isContainsCycle(g) == "The cycle is: 2->0->1->2");
+    }
+
+    SUBCASE("directed acyclic graph with a cross edge") {
+        vector<vector<int>> dagMatrix = {
+                {0, 1, 1},
+                {0, 0, 1},
+                {0, 0, 0}
+        };
+        g.loadGraph(dagMatrix);
+        CHECK(Algorithms::isContainsCycle(g) == "0");
+        CHECK(Algorithms::negativeCycle(g) == "0");
+    }
+}
+
+// Test the DAG shortest and longest path methods
+TEST_CASE("DAG path methods") {
+    Graph g;
+    vector<vector<int>> matrix = {
+            {0, 5, 2, 0, 0},
+            {0, 0, 0, -4, 0},
+            {0, 0, 0, 3, 6},
+            {0, 0, 0, 0, 2},
+            {0, 0, 0, 0, 0}
+    };
+    g.loadGraph(matrix);
+
+    SUBCASE("topological order") {
+        vector<int> order;
+        CHECK(Algorithms::topologicalSort(g, order) == true);
+        CHECK(order == vector<int>({0, 1, 2, 3, 4}));
+    }
+
+    SUBCASE("shortest path with negative weights") {
+        CHECK(Algorithms::shortestPath(g, 0, 4) == "0->1->3->4");
+        CHECK(Algorithms::DAGShortestPath(g, 0, 4) == "0->1->3->4");
+        CHECK(Algorithms::DAGShortestPath(g, 4, 0) == "-1");
+    }
+
+    SUBCASE("longest path") {
+        CHECK(Algorithms::DAGLongestPath(g, 0, 4) == "0->2->4");
+    }
+
+    SUBCASE("graph with a cycle") {
+        vector<vector<int>> cyclic = {
+                {0, 1, 0},
+                {0, 0, 1},
+                {1, 0, 0}
+        };
+        g.loadGraph(cyclic);
+        vector<int> order;
+        CHECK(Algorithms::topologicalSort(g, order) == false);
+        CHECK(Algorithms::DAGShortestPath(g, 0, 2) == "-1");
+    }
+}
+
+// Test the binary graph file format
+TEST_CASE("MappedGraph save and open") {
+    vector<vector<int>> matrix = {
+            {0,   300, 0,  0},
+            {0,   0,   -2, 0},
+            {0,   0,   0,  7},
+            {1,   0,   0,  0}
+    };
+    Graph g;
+    g.loadGraph(matrix);
+    const char *path = "test_graph.bin";
+
+    SUBCASE("CSR layout") {
+        MappedGraph::save(g, path);
+        MappedGraph mapped(path);
+        CHECK(mapped.isDense() == false);
+        CHECK(mapped.getVertexNum() == 4);
+        CHECK(mapped.getEdgesNum() == 4);
+        CHECK(mapped.getWeightWidth() == 2);
+        CHECK(mapped.getIsDirected() == true);
+        CHECK(mapped.getHasNegEdges() == true);
+        CHECK(mapped.getDegree(1) == 1);
+        CHECK(mapped.getNeighbour(1, 0) == 2);
+        CHECK(mapped.getNeighbourWeight(1, 0) == -2);
+        CHECK(mapped.getWeight(0, 1) == 300);
+        CHECK(mapped.getWeight(0, 2) == 0);
+        CHECK(mapped.toGraph().getAdjacencyMatrix() == matrix);
+    }
+
+    SUBCASE("dense layout") {
+        MappedGraph::save(g, path, true);
+        MappedGraph mapped(path);
+        CHECK(mapped.isDense() == true);
+        CHECK(mapped.getWeight(2, 3) == 7);
+        Graph loaded = mapped.toGraph();
+        CHECK(loaded.getEdgesNum() == 4);
+        CHECK(Algorithms::shortestPath(loaded, 0, 3) == Algorithms::shortestPath(g, 0, 3));
+    }
+
+    SUBCASE("invalid file") {
+        FILE *f = fopen(path, "w");
+        fputs("not a graph file at all, just some text", f);
+        fclose(f);
+        CHECK_THROWS_AS(MappedGraph mapped(path), std::invalid_argument);
+    }
+
+    SUBCASE("corrupt files") {
+        // Saves g again and overwrites 8 bytes at the given position
+        auto corrupt = [&](size_t at, uint64_t value, bool dense) {
+            MappedGraph::save(g, path, dense);
+            FILE *f = fopen(path, "r+b");
+            fseek(f, static_cast<long>(at), SEEK_SET);
+            fwrite(&value, sizeof(value), 1, f);
+            fclose(f);
+        };
+        const size_t offsetsAt = (sizeof(GraphFileHeader) + 7) & ~static_cast<size_t>(7);
+        const size_t targetsAt = offsetsAt + 5 * sizeof(uint64_t);
+
+        corrupt(offsetof(GraphFileHeader, vertexNum), ~0ull, false); // More vertices than an int, and (V + 1) * 8 would wrap around to 0
+        CHECK_THROWS_AS(MappedGraph mapped(path), std::invalid_argument);
+        corrupt(offsetof(GraphFileHeader, entryNum), 1ull << 62, false); // entries * 4 wraps around to 0
+        CHECK_THROWS_AS(MappedGraph mapped(path), std::invalid_argument);
+        corrupt(offsetof(GraphFileHeader, entryNum), 15, true);
+        CHECK_THROWS_AS(MappedGraph mapped(path), std::invalid_argument);
+        corrupt(offsetsAt, 1, false);
+        CHECK_THROWS_AS(MappedGraph mapped(path), std::invalid_argument);
+        corrupt(offsetsAt + 1 * sizeof(uint64_t), 3, false); // 0, 3, 2, ...
+        CHECK_THROWS_AS(MappedGraph mapped(path), std::invalid_argument);
+        corrupt(offsetsAt + 4 * sizeof(uint64_t), 3, false);
+        CHECK_THROWS_AS(MappedGraph mapped(path), std::invalid_argument);
+        corrupt(targetsAt, 4 | (2ull << 32), false); // The targets of vertices 0 and 1 become 4 and 2
+        CHECK_THROWS_AS(MappedGraph mapped(path), std::invalid_argument);
+
+        corrupt(targetsAt, 1 | (2ull << 32), false); // Unchanged
+        MappedGraph mapped(path);
+        CHECK(mapped.toGraph().getAdjacencyMatrix() == matrix);
+    }
+    remove(path);
+}
+
+// Test the streaming text parser
+TEST_CASE("GraphParser methods") {
+    Graph g;
+    SUBCASE("whitespace and CSV matrix") {
+        string text = "0 1 0\n1 0 2\n\n0, 2, 0\r\n";
+        GraphParser::parseMatrix(text.data(), text.size(), g);
+        CHECK(g.getVertexNum() == 3);
+        CHECK(g.getEdgesNum() == 2);
+        CHECK(g.getIsWeighted() == true);
+        CHECK(g.getAdjacencyMatrix() == vector<vector<int>>({{0, 1, 0}, {1, 0, 2}, {0, 2, 0}}));
+    }
+
+    SUBCASE("edge list") {
+        string text = "# source target weight\n0 1 -3\n1 2\n2,0,4\n";
+        GraphParser::parseEdgeList(text.data(), text.size(), g);
+        CHECK(g.getVertexNum() == 3);
+        CHECK(g.getIsDirected() == true);
+        CHECK(g.getHasNegEdges() == true);
+        CHECK(g.getAdjacencyMatrix() == vector<vector<int>>({{0, -3, 0}, {0, 0, 1}, {4, 0, 0}}));
+
+        GraphParser::parseEdgeList(text.data(), text.size(), g, true);
+        CHECK(g.getIsDirected() == false);
+        CHECK(g.getEdgesNum() == 3);
+    }
+
+    SUBCASE("multi-threaded split gives the same graph") {
+        string matrixText, edgeText;
+        for (int i = 0; i < 200; ++i) {
+            for (int j = 0; j < 200; ++j) {
+                matrixText += (j == (i + 1) % 200 ? "7 " : "0 ");
+            }
+            matrixText += "\n";
+            edgeText += to_string(i) + " " + to_string((i * 7 + 3) % 200) + " " + to_string(i - 100) + "\n";
+        }
+        Graph single;
+        GraphParser::parseMatrix(matrixText.data(), matrixText.size(), single);
+        GraphParser::parseMatrix(matrixText.data(), matrixText.size(), g, 4);
+        CHECK(g.getAdjacencyMatrix() == single.getAdjacencyMatrix());
+        CHECK(Algorithms::isConnected(g) == 1);
+
+        GraphParser::parseEdgeList(edgeText.data(), edgeText.size(), single);
+        GraphParser::parseEdgeList(edgeText.data(), edgeText.size(), g, false, 3);
+        CHECK(g.getAdjacencyMatrix() == single.getAdjacencyMatrix());
+    }
+
+    SUBCASE("malformed input position") {
+        string text = "0 1 0\n1 0 1\n0 x 0\n";
+        try {
+            GraphParser::parseMatrix(text.data(), text.size(), g, 2);
+            CHECK(false);
+        } catch (const GraphParser::ParseError &e) {
+            CHECK(e.getLine() == 3);
+            CHECK(e.getColumn() == 3);
+        }
+        string notSquare = "0 1\n1 0\n1 1\n";
+        CHECK_THROWS_AS(GraphParser::parseMatrix(notSquare.data(), notSquare.size(), g), std::invalid_argument);
+    }
+
+    SUBCASE("vertex ids above the limit") {
+        string text = "0 1\n1 2147483647\n";
+        try {
+            GraphParser::parseEdgeList(text.data(), text.size(), g, false, 2);
+            CHECK(false);
+        } catch (const GraphParser::ParseError &e) {
+            CHECK(e.getLine() == 2);
+            CHECK(e.getColumn() == 3);
+        }
+        string small = "# ids up to 9\n9 0\n10 0\n";
+        try {
+            GraphParser::parseEdgeList(small.data(), small.size(), g, false, 1, 10);
+            CHECK(false);
+        } catch (const GraphParser::ParseError &e) {
+            CHECK(e.getLine() == 3);
+            CHECK(e.getColumn() == 1);
+        }
+        GraphParser::parseEdgeList(small.data(), small.size() - 5, g, false, 1, 10);
+        CHECK(g.getVertexNum() == 10);
+    }
+
+    SUBCASE("streamed files") {
+        const char *path = "test_graph.txt";
+        FILE *f = fopen(path, "w");
+        fputs("0 4 0\n4 0 1\n0 1 0", f);
+        fclose(f);
+        GraphParser::loadMatrixFile(path, g);
+        CHECK(Algorithms::shortestPath(g, 0, 2) == "0->1->2");
+
+        f = fopen(path, "w");
+        fputs("0 1\n1 2\n", f);
+        fclose(f);
+        GraphParser::loadEdgeListFile(path, g, true);
+        CHECK(g.getEdgesNum() == 2);
+
+        f = fopen(path, "w");
+        for (int i = 0; i < 50; ++i) {
+            fprintf(f, "%d %d %d\n", i, i + 1, i % 7);
+        }
+        fclose(f);
+        std::vector<int> sums(2, 0);
+        for (size_t chunk : {size_t(16), GraphParser::CHUNK_SIZE}) { // Lines cut by every chunk boundary and none
+            GraphParser::streamEdgeListFile(path, [&sums, chunk](int u, int v, int weight) {
+                sums[chunk == 16] += u * 100 + v * 10 + weight;
+            }, 1, chunk);
+        }
+        CHECK(sums[0] == sums[1]);
+        CHECK(GraphParser::streamEdgeListBytes(16) >= 16 + 5 * 3 * sizeof(int));
+        try {
+            GraphParser::streamEdgeListFile(path, [](int, int, int) {}, 1, 7); // "10 11 3" and its line break do not fit
+            CHECK(false);
+        } catch (const GraphParser::ParseError &e) {
+            CHECK(e.getLine() == 11);
+        }
+        remove(path);
+    }
+}
+
+// Test the compressed adjacency representation
+TEST_CASE("CompressedGraph methods") {
+    Graph g;
+    SUBCASE("neighbour iteration and weights") {
+        vector<vector<int>> matrix = {
+                {0,   0, 300, 1},
+                {0,   0, 0,   0},
+                {-7,  0, 0,   2},
+                {0,   5, 0,   0}
+        };
+        g.loadGraph(matrix);
+        CompressedGraph cg(g);
+        CHECK(cg.getWeightWidth() == 2);
+        CHECK(cg.getDegree(0) == 2);
+        CHECK(cg.getDegree(1) == 0);
+
+        vector<int> neighbours, weights;
+        for (CompressedGraph::NeighbourIterator it = cg.neighbours(2); it.valid(); it.next()) {
+            neighbours.push_back(it.vertex());
+            weights.push_back(it.weight());
+        }
+        CHECK(neighbours == vector<int>({0, 3}));
+        CHECK(weights == vector<int>({-7, 2}));
+        CHECK(Algorithms::shortestPath(cg, 2, 1) == "2->0->3->1");
+        CHECK(Algorithms::shortestPath(cg, 1, 0) == "-1");
+    }
+
+    SUBCASE("same paths as the matrix and a smaller footprint") {
+        int n = 300;
+        vector<vector<int>> ring(n, vector<int>(n, 0));
+        for (int i = 0; i < n; ++i) {
+            ring[i][(i + 1) % n] = ring[(i + 1) % n][i] = 1;
+            ring[i][(i + 10) % n] = ring[(i + 10) % n][i] = 1;
+        }
+        g.loadGraph(ring);
+        CompressedGraph cg(g);
+        CHECK(cg.getWeightWidth() == 0);
+        CHECK(cg.compressionRatio() > 3.0);
+        CHECK(Algorithms::shortestPath(cg, 0, 155) == Algorithms::shortestPath(g, 0, 155));
+
+        ring[0][1] = ring[1][0] = 4;
+        g.loadGraph(ring);
+        cg.compress(g);
+        CHECK(cg.getWeightWidth() == 1);
+        CHECK(Algorithms::shortestPath(cg, 0, 1) == Algorithms::shortestPath(g, 0, 1));
+    }
+
+    SUBCASE("built from a mapped file or a sorted edge stream") {
+        GraphGenerator::Options options;
+        options.seed = 3;
+        options.directed = true;
+        options.minWeight = -200;
+        options.maxWeight = 200;
+        GraphGenerator::erdosRenyi(g, 90, 0.05, options);
+        CompressedGraph fromMatrix(g);
+        auto sameAs = [&fromMatrix](const CompressedGraph &other) {
+            CHECK(other.getVertexNum() == fromMatrix.getVertexNum());
+            CHECK(other.getEdgesNum() == fromMatrix.getEdgesNum());
+            CHECK(other.getIsDirected() == fromMatrix.getIsDirected());
+            CHECK(other.getHasNegEdges() == fromMatrix.getHasNegEdges());
+            CHECK(other.getWeightWidth() == fromMatrix.getWeightWidth());
+            CHECK(other.memoryBytes() == fromMatrix.memoryBytes());
+            for (int v = 0; v < fromMatrix.getVertexNum(); ++v) {
+                CompressedGraph::NeighbourIterator a = fromMatrix.neighbours(v), b = other.neighbours(v);
+                for (; a.valid() && b.valid(); a.next(), b.next()) {
+                    CHECK(a.vertex() == b.vertex());
+                    CHECK(a.weight() == b.weight());
+                }
+                CHECK(a.valid() == b.valid());
+            }
+        };
+
+        const char *path = "test_compressed.graph";
+        for (bool dense : {false, true}) {
+            MappedGraph::save(g, path, dense);
+            MappedGraph mapped(path);
+            sameAs(CompressedGraph(mapped));
+        }
+        remove(path);
+
+        const char *edgesPath = "test_compressed_edges.txt";
+        FILE *f = fopen(edgesPath, "w");
+        for (int u = 0; u < 90; ++u) {
+            for (int v = 0; v < 90; ++v) {
+                if (g.getAdjacencyMatrix()[u][v] != 0) {
+                    fprintf(f, "%d %d %d\n", u, v, g.getAdjacencyMatrix()[u][v]);
+                }
+            }
+        }
+        fclose(f);
+        CompressedGraph streamed;
+        streamed.compressSortedEdges(90, true, [edgesPath](const CompressedGraph::EdgeVisitor &visit) {
+            GraphParser::streamEdgeListFile(edgesPath, visit);
+        });
+        sameAs(streamed);
+        remove(edgesPath);
+
+        CHECK_THROWS_AS(streamed.compressSortedEdges(-1, true, [](const CompressedGraph::EdgeVisitor &visit) {
+            visit(0, 2, 1);
+            visit(0, 1, 1);
+        }), std::invalid_argument);
+        streamed.compressSortedEdges(-1, false, [](const CompressedGraph::EdgeVisitor &visit) {
+            visit(0, 3, 1);
+            visit(3, 0, 1);
+        });
+        CHECK(streamed.getVertexNum() == 4);
+        CHECK(streamed.getEdgesNum() == 1);
+        CHECK(streamed.getDegree(1) == 0);
+        CHECK(Algorithms::shortestPath(streamed, 3, 0) == "3->0");
+    }
+}
+
+// Test graphs with other weight types and overflow-safe distances
+TEST_CASE("Weight types and distance overflow") {
+    SUBCASE("int weights whose sums overflow int") {
+        vector<vector<int>> matrix = {
+                {0,          2000000000, 2100000000},
+                {2000000000, 0,          2000000000},
+                {2100000000, 2000000000, 0}
+        };
+        Graph g;
+        g.loadGraph(matrix);
+        CHECK(Algorithms::shortestPath(g, 0, 2) == "0->2");
+        CHECK(Algorithms::BellmanFordShortestPath(g, 0, 2) == "0->2");
+
+        vector<vector<int>> dag = {
+                {0, 2000000000, 2100000000},
+                {0, 0,          2000000000},
+                {0, 0,          0}
+        };
+        g.loadGraph(dag);
+        CHECK(Algorithms::shortestPath(g, 0, 2) == "0->2");
+        CHECK(Algorithms::DAGLongestPath(g, 0, 2) == "0->1->2");
+    }
+
+    SUBCASE("int8_t weights") {
+        BasicGraph<int8_t> g;
+        g.loadGraph({{0, 100, 0, 127},
+                     {100, 0, 100, 0},
+                     {0, 100, 0, 100},
+                     {127, 0, 100, 0}});
+        CHECK(g.getIsWeighted() == true);
+        CHECK(Algorithms::shortestPath(g, 0, 2) == "0->1->2");
+        CHECK(Algorithms::isConnected(g) == 1);
+        CHECK(Algorithms::isBipartite(g) == "The graph is bipartite: A={0, 2}, B={1, 3}");
+    }
+
+    SUBCASE("double weights") {
+        BasicGraph<double> g;
+        g.loadGraph({{0, 0.5, 2.0},
+                     {0, 0, 0.75},
+                     {-0.25, 0, 0}});
+        CHECK(g.getHasNegEdges() == true);
+        CHECK(Algorithms::shortestPath(g, 0, 2) == "0->1->2");
+        CHECK(Algorithms::negativeCycle(g) == "0");
+    }
+
+    SUBCASE("Saturated distances are still paths") {
+        const int64_t big = numeric_limits<int64_t>::max();
+        BasicGraph<int64_t> g;
+        g.loadGraph({{0, big, 0},
+                     {0, 0, big},
+                     {0, 0, 0}});
+        CHECK(Algorithms::shortestPath(g, 0, 2) == "0->1->2");
+        CHECK(Algorithms::DijkstraShortestPath(g, 0, 2) == "0->1->2");
+        CHECK(Algorithms::BellmanFordShortestPath(g, 0, 2) == "0->1->2");
+        CHECK(Algorithms::DAGShortestPath(g, 0, 2) == "0->1->2");
+        CHECK(addDistance(big, big) < infiniteDistance<long long>());
+        CHECK(addDistance(numeric_limits<double>::max(), numeric_limits<double>::max()) < infiniteDistance<double>());
+
+        BasicDynamicSSSP<int64_t> sssp(g, 0);
+        CHECK(sssp.getDistance(2) != infiniteDistance<long long>());
+        CHECK(sssp.shortestPath(2) == "0->1->2");
+    }
+
+    SUBCASE("Other distance types") {
+        Graph g;
+        g.loadGraph({{0, 2000000000, 0},
+                     {0, 0, 2000000000},
+                     {0, 0, 0}});
+        CHECK(Algorithms::shortestPath<int, int64_t>(g, 0, 2) == "0->1->2");
+        CHECK(Algorithms::shortestPath<int, int>(g, 0, 2) == "0->1->2");
+        CHECK(Algorithms::DijkstraShortestPath<int, double>(g, 0, 2) == "0->1->2");
+        CHECK(Algorithms::BellmanFordShortestPath<int, int>(g, 0, 2) == "0->1->2");
+        CHECK(Algorithms::DAGLongestPath<int, int64_t>(g, 0, 2) == "0->1->2");
+
+        AlgorithmWorkspace ws;
+        CHECK(Algorithms::shortestPath<int, int>(g, 0, 2, ws) == "0->1->2");
+        CHECK(Algorithms::shortestPath<int, int64_t>(g, 2, 0, ws) == "-1");
+    }
+}
+
+// Test the kernels selected by the graph kind
+TEST_CASE("GraphKind kernels") {
+    Graph g;
+    SUBCASE("undirected graph with a reachable negative edge") {
+        vector<vector<int>> matrix = {
+                {0, 2, 0, 0},
+                {2, 0, -1, 0},
+                {0, -1, 0, 0},
+                {0, 0, 0, 0}
+        };
+        g.loadGraph(matrix);
+        CHECK(Algorithms::shortestPath(g, 0, 2) == Algorithms::BellmanFordShortestPath(g, 0, 2));
+        CHECK(Algorithms::shortestPath(g, 0, 2) == "Negative cycle detected");
+        CHECK(Algorithms::shortestPath(g, 3, 3) == "3");
+    }
+
+    SUBCASE("undirected forest and a cycle in a later component") {
+        vector<vector<int>> matrix = {
+                {0, 1, 1, 0, 0, 0},
+                {1, 0, 0, 0, 0, 0},
+                {1, 0, 0, 0, 0, 0},
+                {0, 0, 0, 0, 1, 1},
+                {0, 0, 0, 1, 0, 1},
+                {0, 0, 0, 1, 1, 0}
+        };
+        g.loadGraph(matrix);
+        CHECK(Algorithms::isContainsCycle(g) == "The cycle is: 5->3->4->5");
+
+        matrix[4][5] = matrix[5][4] = 0;
+        g.loadGraph(matrix);
+        CHECK(Algorithms::isContainsCycle(g) == "0");
+    }
+
+    SUBCASE("every kind agrees with its reference engine") {
+        GraphGenerator::Options options;
+        for (uint64_t seed = 1; seed <= 24; ++seed) {
+            options.seed = seed;
+            options.directed = seed % 2 == 0;
+            options.minWeight = seed % 3 == 2 ? -2 : 1;
+            options.maxWeight = seed % 3 == 0 ? 1 : 9;
+            GraphGenerator::erdosRenyi(g, 30, 0.08, options);
+            for (int start = 0; start < 30; start += 7) {
+                for (int end = 0; end < 30; end += 3) {
+                    std::string path = Algorithms::shortestPath(g, start, end);
+                    std::vector<int> order;
+                    if (!g.getIsWeighted()) {
+                        CHECK(path == Algorithms::BFSShortestPath(g, start, end));
+                    }
+                    else if (g.getIsDirected() && Algorithms::topologicalSort(g, order)) {
+                        CHECK(path == Algorithms::DAGShortestPath(g, start, end));
+                    }
+                    else if (!g.getHasNegEdges()) {
+                        CHECK(path == Algorithms::DijkstraShortestPath(g, start, end));
+                    }
+                    else if (g.getIsDirected()) {
+                        CHECK(path == Algorithms::BellmanFordShortestPath(g, start, end));
+                    }
+                    else {
+                        std::string reference = Algorithms::BellmanFordShortestPath(g, start, end);
+                        CHECK(path == (reference == "Negative cycle detected" ? reference : Algorithms::DijkstraShortestPath(g, start, end)));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Test the overloads reusing an AlgorithmWorkspace
+TEST_CASE("AlgorithmWorkspace methods") {
+    AlgorithmWorkspace ws;
+    SUBCASE("queries on different graphs give the same results as without a workspace") {
+        Graph weighted;
+        weighted.loadGraph({{0, 4, 1, 0},
+                            {4, 0, 2, 5},
+                            {1, 2, 0, 8},
+                            {0, 5, 8, 0}});
+        Graph unweighted;
+        unweighted.loadGraph({{0, 1, 0},
+                              {1, 0, 1},
+                              {0, 1, 0}});
+        Graph negative;
+        negative.loadGraph({{0, 4, 0},
+                            {0, 0, -2},
+                            {0, 0, 0}});
+
+        CHECK(Algorithms::shortestPath(weighted, 0, 3, ws) == Algorithms::shortestPath(weighted, 0, 3));
+        CHECK(Algorithms::shortestPath(unweighted, 0, 2, ws) == "0->1->2");
+        CHECK(Algorithms::shortestPath(weighted, 3, 0, ws) == "3->1->2->0");
+        CHECK(Algorithms::BellmanFordShortestPath(negative, 0, 2, ws) == "0->1->2");
+        CHECK(Algorithms::DijkstraShortestPath(weighted, 2, 3, ws) == Algorithms::DijkstraShortestPath(weighted, 2, 3));
+        CHECK(Algorithms::BFSShortestPath(negative, 2, 0, ws) == "-1");
+        CHECK(Algorithms::isBipartite(unweighted, ws) == Algorithms::isBipartite(unweighted));
+        CHECK(Algorithms::isBipartite(weighted, ws) == "0");
+        CHECK(Algorithms::isContainsCycle(weighted, ws) == Algorithms::isContainsCycle(weighted));
+        CHECK(Algorithms::isContainsCycle(unweighted, ws) == "0");
+    }
+
+    SUBCASE("stamped arrays reset without clearing") {
+        StampedArray<int> values;
+        values.reset(4, -1);
+        values.set(2, 7);
+        CHECK(values.get(2) == 7);
+        CHECK(values.get(0) == -1);
+        values.reset(4, 0);
+        CHECK(values.get(2) == 0);
+        values.reset(8, 5);
+        CHECK(values.get(7) == 5);
+    }
+}
+
+// Test the seeded graph generators
+TEST_CASE("GraphGenerator methods") {
+    GraphGenerator::Options options;
+    options.seed = 42;
+    options.minWeight = 1;
+    options.maxWeight = 9;
+
+    SUBCASE("the same seed gives the same graph for any number of threads") {
+        Graph single, parallel;
+        GraphGenerator::erdosRenyi(single, 200, 0.05, options);
+        options.threads = 4;
+        GraphGenerator::erdosRenyi(parallel, 200, 0.05, options);
+        CHECK(single.getAdjacencyMatrix() == parallel.getAdjacencyMatrix());
+        CHECK(single.getEdgesNum() > 0);
+        CHECK(single.getIsDirected() == false);
+
+        GraphGenerator::rmat(single, 8, 2000, 0.57, 0.19, 0.19, options);
+        options.threads = 1;
+        GraphGenerator::rmat(parallel, 8, 2000, 0.57, 0.19, 0.19, options);
+        CHECK(single.getAdjacencyMatrix() == parallel.getAdjacencyMatrix());
+        CHECK(single.getVertexNum() == 256);
+    }
+
+    SUBCASE("G(n, m) has exactly m edges") {
+        Graph g;
+        GraphGenerator::erdosRenyiEdges(g, 30, 100, options);
+        CHECK(g.getEdgesNum() == 100);
+        GraphGenerator::erdosRenyiEdges(g, 30, 400, options);
+        CHECK(g.getEdgesNum() == 400);
+        options.directed = true;
+        GraphGenerator::erdosRenyiEdges(g, 10, 90, options);
+        CHECK(g.getEdgesNum() == 90);
+        CHECK_THROWS_AS(GraphGenerator::erdosRenyiEdges(g, 10, 91, options), std::invalid_argument);
+        CHECK_THROWS_AS(GraphGenerator::erdosRenyi(g, GraphParser::MAX_VERTEX_NUM + 1, 0.0, options), std::invalid_argument);
+        CHECK_THROWS_AS(GraphGenerator::grid(g, 1 << 8, (1 << 7) + 1, 1.0, options), std::invalid_argument);
+        CHECK_THROWS_AS(GraphGenerator::rmat(g, 16, 10, 0.57, 0.19, 0.19, options), std::invalid_argument);
+        CHECK(g.getVertexNum() == 10); // Rejected before the graph is reset
+    }
+
+    SUBCASE("structured families") {
+        Graph g;
+        GraphGenerator::grid(g, 4, 5, 1.0, options);
+        CHECK(g.getEdgesNum() == 4 * 4 + 3 * 5);
+        CHECK(Algorithms::isBipartite(g) != "0");
+
+        GraphGenerator::randomDAG(g, 50, 0.2, options);
+        vector<int> order;
+        CHECK(g.getIsDirected() == true);
+        CHECK(Algorithms::topologicalSort(g, order) == true);
+
+        GraphGenerator::bipartite(g, 6, 7, 0.5, options);
+        CHECK(Algorithms::isBipartite(g) != "0");
+        CHECK(g.getAdjacencyMatrix()[0][1] == 0);
+
+        GraphGenerator::plantedNegativeCycle(g, 20, 0.1, 5, options);
+        CHECK(g.getHasNegEdges() == true);
+        CHECK(Algorithms::negativeCycle(g) != "0");
+        CHECK_THROWS_AS(GraphGenerator::plantedNegativeCycle(g, 20, 0.1, 2, options), std::invalid_argument);
+    }
+}
+
+// Test the per-call statistics (only collected in builds with GRAPH_STATS)
+TEST_CASE("AlgoStats collection") {
+    Graph g;
+    g.loadGraph({{0, 4, 1, 0},
+                 {4, 0, 2, 5},
+                 {1, 2, 0, 8},
+                 {0, 5, 8, 0}});
+    AlgoStats stats;
+    {
+        AlgoStatsScope scope(stats);
+        CHECK(Algorithms::shortestPath(g, 0, 3) == "0->2->1->3");
+    }
+#ifdef GRAPH_STATS
+    CHECK(std::string(stats.engine) == "Dijkstra");
+    CHECK(stats.calls == 1);
+    CHECK(stats.settledVertices == 4);
+    CHECK(stats.edgesScanned == 5); // Edges into settled vertices are skipped and the search stops once 3 is settled
+    CHECK(stats.heapPushes == stats.settledVertices + stats.stalePops + 1); // (9, 3) is left in the heap
+    CHECK(stats.allocations > 0);
+
+    SUBCASE("nested calls and scopes") {
+        stats.reset();
+        AlgoStats inner;
+        {
+            AlgoStatsScope outer(stats);
+            Algorithms::isConnected(g);
+            {
+                AlgoStatsScope nested(inner);
+                Algorithms::negativeCycle(g);
+            }
+            Algorithms::isContainsCycle(g);
+        }
+        CHECK(stats.calls == 2);
+        CHECK(std::string(stats.engine) == "DFS");
+        CHECK(stats.maxDFSDepth >= 3);
+        CHECK(inner.calls == 1);
+        Algorithms::isBipartite(g);
+        CHECK(stats.calls == 2);
+    }
+#else
+    CHECK(stats.calls == 0);
+    CHECK(stats.settledVertices == 0);
+#endif
+    CHECK(stats.toJSON().find("\"engine\"") != std::string::npos);
+}
+
+TEST_CASE("GraphView filters") {
+    // The graph a view describes, built as a separate matrix
+    auto materialize = [](const GraphView &view) {
+        int n = view.getVertexNum();
+        vector<vector<int>> matrix(n, vector<int>(n, 0));
+        for (int u = 0; u < n; ++u) {
+            for (int v = 0; v < n; ++v) {
+                matrix[u][v] = view.getAdjacencyMatrix()[u][v];
+            }
+        }
+        Graph g;
+        g.loadGraph(std::move(matrix));
+        return g;
+    };
+
+    SUBCASE("vertex mask, weight range and predicate") {
+        Graph g;
+        g.loadGraph({{0, 1, 5, 0},
+                     {1, 0, 1, 0},
+                     {5, 1, 0, 2},
+                     {0, 0, 2, 0}});
+        GraphView view(g);
+        CHECK(Algorithms::shortestPath(view, 0, 2) == "0->1->2");
+
+        view.keepVertices({true, false, true, true});
+        CHECK(view.getVertexNum() == 3);
+        CHECK(view.toOriginal(1) == 2);
+        CHECK(view.toView(1) == -1);
+        CHECK(view.getEdgesNum() == 2);
+        CHECK(Algorithms::shortestPath(view, 0, 2) == "0->1->2"); // 0->2->3 in original ids
+        CHECK(Algorithms::isConnected(view) == 1);
+
+        view.keepWeights(1, 4);
+        CHECK(Algorithms::isConnected(view) == 0);
+        CHECK(Algorithms::shortestPath(view, 0, 2) == "-1");
+
+        GraphView oneWay(g);
+        oneWay.keepEdges([](int u, int v, int) { return u < v; });
+        CHECK(oneWay.getIsDirected() == true);
+        CHECK(oneWay.getEdgesNum() == 4);
+        CHECK(Algorithms::isContainsCycle(oneWay) == "0");
+        CHECK(Algorithms::isContainsCycle(g) != "0");
+
+        std::vector<bool> shortMask(2, true);
+        CHECK_THROWS_AS(view.keepVertices(shortMask), std::invalid_argument);
+
+        GraphView empty(g);
+        empty.keepVertices(std::vector<bool>(4, false));
+        CHECK(empty.getVertexNum() == 0);
+        CHECK(empty.getEdgesNum() == 0);
+        CHECK(empty.toView(0) == -1);
+        CHECK(Algorithms::shortestPath(empty, 0, 1) == "-1");
+    }
+
+    SUBCASE("same answers as the materialized subgraph") {
+        GraphGenerator::Options options;
+        options.minWeight = -2;
+        options.maxWeight = 9;
+        for (uint64_t seed = 1; seed <= 8; ++seed) {
+            options.seed = seed;
+            options.directed = seed % 2 == 0;
+            Graph g;
+            GraphGenerator::erdosRenyi(g, 40, 0.15, options);
+            GraphView view(g);
+            std::vector<bool> mask(40);
+            for (int v = 0; v < 40; ++v) {
+                mask[v] = (v * 7 + static_cast<int>(seed)) % 5 != 0;
+            }
+            view.keepVertices(mask);
+            view.keepWeights(seed % 4 == 1 ? -2 : 0, 7);
+            view.keepEdges([](int u, int v, int) { return (u + v) % 11 != 0; });
+            Graph sub = materialize(view);
+
+            CHECK(view.getEdgesNum() == sub.getEdgesNum());
+            CHECK(view.getIsDirected() == sub.getIsDirected());
+            CHECK(view.getIsWeighted() == sub.getIsWeighted());
+            CHECK(view.getHasNegEdges() == sub.getHasNegEdges());
+            CHECK(Algorithms::isConnected(view) == Algorithms::isConnected(sub));
+            CHECK(Algorithms::isContainsCycle(view) == Algorithms::isContainsCycle(sub));
+            CHECK(Algorithms::isBipartite(view) == Algorithms::isBipartite(sub));
+            CHECK(Algorithms::negativeCycle(view) == Algorithms::negativeCycle(sub));
+            for (int t = 1; t < view.getVertexNum(); t += 5) {
+                CHECK(Algorithms::shortestPath(view, 0, t) == Algorithms::shortestPath(sub, 0, t));
+            }
+            vector<int> viewOrder;
+            vector<int> subOrder;
+            CHECK(Algorithms::topologicalSort(view, viewOrder) == Algorithms::topologicalSort(sub, subOrder));
+            CHECK(viewOrder == subOrder);
+        }
+    }
+}
+
+TEST_CASE("ResultWriter encodings") {
+    Graph g;
+    g.loadGraph({{0, 1, 0},
+                 {1, 0, -2},
+                 {0, -2, 0}});
+    vector<int> path = {0, 1, 2};
+    vector<int> cycle = {0, 1, 2, 0};
+    vector<int> setA = {0, 2};
+    vector<int> setB = {1};
+
+    SUBCASE("text") {
+        std::string out;
+        {
+            ResultWriter writer(out, ResultWriter::TEXT);
+            writer.writeMatrix(g);
+            writer.writePath(path);
+            writer.writePath(vector<int>());
+            writer.writeCycle(cycle);
+            writer.writePartition(setA, setB);
+            CHECK(out.empty()); // Nothing is handed over before the flush
+        }
+        CHECK(out == "0 1 0 \n1 0 -2 \n0 -2 0 \n0->1->2\n-1\n0->1->2->0\nA={0, 2}, B={1}\n");
+
+        BasicGraph<double> weighted;
+        weighted.loadGraph({{0, 0.5}, {0.5, 0}});
+        out.clear();
+        ResultWriter writer(out, ResultWriter::TEXT);
+        writer.writeMatrix(weighted);
+        writer.flush();
+        CHECK(out == "0 0.5 \n0.5 0 \n");
+
+        weighted.loadGraph({{0, 1.0 / 3}, {0.1, 0}});
+        out.clear();
+        writer.writeMatrix(weighted);
+        writer.flush();
+        CHECK(out == "0 0.3333333333333333 \n0.1 0 \n"); // Every digit needed to read the weights back, no more
+
+        BasicGraph<float> single;
+        single.loadGraph({{0, 0.1f}, {1.0f / 3, 0}});
+        out.clear();
+        writer.writeMatrix(single);
+        writer.flush();
+        CHECK(out == "0 0.1 \n0.33333334 0 \n");
+    }
+
+    SUBCASE("JSON lines with non-finite weights") {
+        BasicGraph<double> weighted;
+        weighted.loadGraph({{0, std::numeric_limits<double>::infinity()}, {std::nan(""), 0}});
+        std::string out;
+        ResultWriter writer(out, ResultWriter::JSON_LINES);
+        writer.writeMatrix(weighted);
+        writer.flush();
+        CHECK(out == "{\"matrix\":[[0,null],[null,0]]}\n");
+    }
+
+    SUBCASE("JSON lines") {
+        std::string out;
+        ResultWriter writer(out, ResultWriter::JSON_LINES);
+        writer.writeMatrix(g);
+        writer.writePath(path);
+        writer.writePath(vector<int>());
+        writer.writeCycle(cycle);
+        writer.writePartition(setA, setB);
+        writer.flush();
+        CHECK(out == "{\"matrix\":[[0,1,0],[1,0,-2],[0,-2,0]]}\n{\"path\":[0,1,2]}\n{\"path\":null}\n"
+                     "{\"cycle\":[0,1,2,0]}\n{\"A\":[0,2],\"B\":[1]}\n");
+    }
+
+    SUBCASE("binary") {
+        std::string out;
+        ResultWriter writer(out, ResultWriter::BINARY);
+        writer.writeMatrix(g);
+        writer.writePartition(setA, setB);
+        writer.flush();
+        REQUIRE(out.size() == 1 + 4 + 2 + 9 * sizeof(int) + 1 + 4 + 8 + 4 + 4);
+        uint32_t n = 0;
+        memcpy(&n, out.data() + 1, sizeof(n));
+        CHECK(out[0] == ResultWriter::MATRIX);
+        CHECK(n == 3);
+        CHECK(out[5] == sizeof(int));
+        int cell = 0;
+        memcpy(&cell, out.data() + 7 + 5 * sizeof(int), sizeof(cell));
+        CHECK(cell == -2);
+        CHECK(out[7 + 9 * sizeof(int)] == ResultWriter::PARTITION);
+    }
+
+    SUBCASE("file descriptor and small buffer") {
+        FILE *file = tmpfile();
+        REQUIRE(file != nullptr);
+        vector<int> longPath;
+        for (int v = 0; v < 1000; ++v) {
+            longPath.push_back(v);
+        }
+        std::string expected;
+        {
+            ResultWriter writer(fileno(file), ResultWriter::TEXT, 16);
+            ResultWriter copy(expected, ResultWriter::TEXT);
+            writer.writePath(longPath);
+            copy.writePath(longPath);
+        }
+        rewind(file);
+        std::string read;
+        char chunk[256];
+        size_t n = 0;
+        while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            read.append(chunk, n);
+        }
+        fclose(file);
+        CHECK(read == expected);
+        CHECK(read.size() > 3000);
+        CHECK(read.compare(0, 8, "0->1->2-") == 0);
+    }
+}
+
+TEST_CASE("Trace spans") {
+    Graph g;
+    g.loadGraph({{0, 4, 1, 0},
+                 {4, 0, 2, 5},
+                 {1, 2, 0, 8},
+                 {0, 5, 8, 0}});
+
+    Trace::clear();
+    CHECK(Trace::eventCount() == 0);
+    CHECK(Algorithms::shortestPath(g, 0, 3) == "0->2->1->3");
+    CHECK(Trace::eventCount() == 0); // Disabled by default
+
+    Trace::enable(true);
+    g.loadGraph({{0, 1, 0},
+                 {0, 0, -1},
+                 {1, 0, 0}});
+    CHECK(Algorithms::shortestPath(g, 0, 2) == "0->1->2");
+    Trace::enable(false);
+    CHECK(Trace::eventCount() > 0);
+
+    std::ostringstream out;
+    Trace::writeChromeJSON(out);
+    std::string json = out.str();
+    CHECK(json.find("\"traceEvents\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"Graph::loadGraph\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"relaxation round\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"path reconstruction\"") != std::string::npos);
+    CHECK(json.find("\"ph\": \"X\"") != std::string::npos);
+
+    Trace::clear();
+    CHECK(Trace::eventCount() == 0);
+
+    // Short-lived threads, like the connections of a server, reuse the rings of the threads that exited
+    Trace::enable(true);
+    {
+        TRACE_SPAN("main thread");
+    }
+    size_t rings = Trace::ringCount();
+    for (int i = 0; i < 20; ++i) {
+        std::thread([]() {
+            TRACE_SPAN("short-lived thread");
+        }).join();
+    }
+    Trace::enable(false);
+    CHECK(Trace::ringCount() <= rings + 1);
+    CHECK(Trace::eventCount() == 21);
+    Trace::clear();
+}
+
+TEST_CASE("GraphStore snapshots") {
+    GraphStore store;
+    CHECK(store.getVersion() == 1);
+    CHECK(store.snapshot()->getVertexNum() == 0);
+
+    store.loadGraph({{0, 1, 0},
+                     {1, 0, 1},
+                     {0, 1, 0}});
+    CHECK(store.getVersion() == 2);
+    GraphStore::Snapshot before = store.snapshot();
+    CHECK(Algorithms::isConnected(*before) == 1);
+
+    SUBCASE("an update publishes a new version and leaves old snapshots unchanged") {
+        store.update([](Graph &g) {
+            g.setEdge(1, 2, 0);
+            g.setEdge(2, 1, 0);
+        });
+        CHECK(store.getVersion() == 3);
+        CHECK(Algorithms::isConnected(*store.snapshot()) == 0);
+        CHECK(store.snapshot()->getEdgesNum() == 1);
+        CHECK(Algorithms::isConnected(*before) == 1);
+        CHECK(before->getEdgesNum() == 2);
+    }
+
+    SUBCASE("invalid changes keep the current version") {
+        CHECK_THROWS(store.loadGraph({{0, 1}, {1}}));
+        CHECK_THROWS(store.setEdge(0, 3, 1));
+        CHECK(store.getVersion() == 2);
+        CHECK(store.snapshot() == before);
+    }
+
+    SUBCASE("readers only see complete versions while a writer reloads") {
+        std::vector<std::vector<int>> path = {{0, 1, 0, 0},
+                                              {1, 0, 1, 0},
+                                              {0, 1, 0, 1},
+                                              {0, 0, 1, 0}};
+        std::vector<std::vector<int>> split = {{0, 1, 0, 0},
+                                               {1, 0, 0, 0},
+                                               {0, 0, 0, 1},
+                                               {0, 0, 1, 0}};
+        store.loadGraph(path);
+        std::atomic<bool> done(false);
+        std::atomic<int> bad(0);
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&store, &done, &bad]() {
+                GraphStore::Reader reader(store);
+                while (!done.load()) {
+                    const Graph &g = reader.get();
+                    int connected = Algorithms::isConnected(g);
+                    if ((connected == 1) != (g.getEdgesNum() == 3)) {
+                        bad++;
+                    }
+                }
+            });
+        }
+        for (int i = 0; i < 200; ++i) {
+            store.loadGraph(i % 2 == 0 ? split : path);
+        }
+        done = true;
+        for (std::thread &reader : readers) {
+            reader.join();
+        }
+        CHECK(bad.load() == 0);
+        CHECK(store.getVersion() == 203);
+    }
+}
+
+TEST_CASE("ThreadPool methods") {
+    ThreadPool pool(4);
+    CHECK(pool.getWorkerNum() == 4);
+    CHECK(pool.concurrency(0) == 4);
+    CHECK(pool.concurrency(2) == 2);
+    CHECK(pool.concurrency(8) == 4);
+    CHECK_THROWS(ThreadPool(-1));
+
+    SUBCASE("parallelFor covers every index exactly once") {
+        std::vector<std::atomic<int>> hits(1000);
+        for (std::atomic<int> &hit : hits) {
+            hit = 0;
+        }
+        pool.parallelFor(0, 1000, 7, [&hits](int, int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                hits[i]++;
+            }
+        });
+        bool once = true;
+        for (std::atomic<int> &hit : hits) {
+            once = once && hit.load() == 1;
+        }
+        CHECK(once);
+    }
+
+    SUBCASE("maxParallelism limits the number of lanes") {
+        std::atomic<int> maxLane(0);
+        pool.parallelFor(0, 100, 1, [&maxLane](int lane, int, int) {
+            int seen = maxLane.load();
+            while (lane > seen && !maxLane.compare_exchange_weak(seen, lane)) {}
+        }, 2);
+        CHECK(maxLane.load() <= 1);
+    }
+
+    SUBCASE("fork/join tasks nest and rethrow exceptions") {
+        std::function<long long(int)> fib = [&pool, &fib](int n) -> long long {
+            if (n < 12) {
+                return n < 2 ? n : fib(n - 1) + fib(n - 2);
+            }
+            long long a = 0;
+            ThreadPool::TaskGroup group(pool);
+            group.run([&a, &fib, n]() { a = fib(n - 1); });
+            long long b = fib(n - 2);
+            group.wait();
+            return a + b;
+        };
+        CHECK(fib(20) == 6765);
+
+        ThreadPool::TaskGroup group(pool);
+        group.run([]() { throw std::invalid_argument("Invalid task"); });
+        CHECK_THROWS_AS(group.wait(), std::invalid_argument);
+    }
+
+    SUBCASE("batch queries give the same results as single queries") {
+        Graph g;
+        GraphGenerator::Options options;
+        options.maxWeight = 9;
+        GraphGenerator::erdosRenyi(g, 60, 0.1, options);
+        std::vector<std::pair<int, int>> queries;
+        for (int i = 0; i < 60; ++i) {
+            queries.push_back(std::make_pair(i, (i * 7) % 60));
+        }
+        std::vector<std::string> parallel = Algorithms::shortestPaths(g, queries, ExecutionContext(&pool, 3));
+        std::vector<std::string> sequential = Algorithms::shortestPaths(g, queries);
+        REQUIRE(parallel.size() == queries.size());
+        CHECK(parallel == sequential);
+        CHECK(parallel[5] == Algorithms::shortestPath(g, 5, 35));
+    }
+}
+
+TEST_CASE("GraphServer requests") {
+    const char *path = "test_server_graph.txt";
+    const char *otherPath = "test_server_graph2.txt";
+    FILE *f = fopen(path, "w");
+    fputs("0 1 0 0\n1 0 1 0\n0 1 0 1\n0 0 1 0\n", f);
+    fclose(f);
+    f = fopen(otherPath, "w");
+    fputs("0 1 1\n1 0 1\n1 1 0\n", f);
+    fclose(f);
+
+    GraphServer::Options options;
+    options.threads = 2;
+    options.reloadDir = ".";
+    GraphServer server(path, options);
+    CHECK(server.snapshot()->getVertexNum() == 4);
+
+    SUBCASE("queries are answered in order, one line each") {
+        CHECK(server.handle("connected\npath 0 3\ncycle\nbipartite\nnegcycle\n") ==
+              "1\n0->1->2->3\n0\nThe graph is bipartite: A={0, 2}, B={1, 3}\n0\n");
+        CHECK(server.handle("path 3 0") == "3->2->1->0\n"); // The last line may lack its newline
+    }
+
+    SUBCASE("a large pipelined batch matches single queries") {
+        std::string requests;
+        std::string expected;
+        for (int i = 0; i < 200; ++i) {
+            requests += "path " + std::to_string(i % 4) + " " + std::to_string((i / 4) % 4) + "\n";
+            expected += Algorithms::shortestPath(*server.snapshot(), i % 4, (i / 4) % 4) + "\n";
+        }
+        CHECK(server.handle(requests) == expected);
+    }
+
+    SUBCASE("reload is a barrier between the old and the new graph") {
+        std::string reloadOther = std::string("reload ") + otherPath + "\n";
+        CHECK(server.handle("bipartite\n" + reloadOther + "bipartite\nreload\nconnected\n") ==
+              "The graph is bipartite: A={0, 2}, B={1, 3}\nok 3 3\n0\nok 4 3\n1\n");
+    }
+
+    SUBCASE("bad requests answer an error and the rest go on") {
+        CHECK(server.handle("path 0 9\nfoo\nreload missing_file.txt\nquit\nconnected\n") ==
+              "error: Invalid vertex: The vertex does not exist.\n"
+              "error: Invalid request: unknown command\n"
+              "error: Cannot open graph file: ./missing_file.txt\n");
+        CHECK(server.snapshot()->getVertexNum() == 4);
+
+        CHECK(server.handle("path 1 2junk\npath 1 2 3\npath 1\npath 1 2 \n") ==
+              "error: Invalid request: Expected a vertex number.\n"
+              "error: Invalid request: Unexpected input after the vertices.\n"
+              "error: Invalid request: Expected a vertex number.\n"
+              "1->2\n");
+        CHECK(server.handle("reload ../graph.txt\nreload /etc/passwd\n") ==
+              "error: Invalid request: The file must be a name inside the reload directory.\n"
+              "error: Invalid request: The file must be a name inside the reload directory.\n");
+    }
+
+    SUBCASE("reloading another file is opt-in") {
+        GraphServer::Options fixed;
+        fixed.threads = 1;
+        GraphServer fixedServer(path, fixed);
+        CHECK(fixedServer.handle(std::string("reload ") + otherPath + "\nreload\n") ==
+              "error: Invalid request: Reloading another file is disabled.\nok 4 3\n");
+    }
+
+    SUBCASE("an overlong line closes the connection") {
+        GraphServer::Options small;
+        small.threads = 1;
+        small.maxLineLength = 16;
+        GraphServer smallServer(path, small);
+        CHECK(smallServer.handle("connected\npath " + std::string(20, '1') + "\nconnected\n") ==
+              "1\nerror: Invalid request: The line is longer than 16 bytes.\n");
+        CHECK(smallServer.handle("connected\n" + std::string(40, '1')) ==
+              "1\nerror: Invalid request: The line is longer than 16 bytes.\n");
+    }
+
+    remove(path);
+    remove(otherPath);
+}
+
+TEST_CASE("GraphReorder methods") {
+    // A path 0-1-2-3-4-5 with scrambled ids: 3-0-5-1-4-2
+    Graph g;
+    g.loadGraph({{0, 0, 0, 1, 0, 1},
+                 {0, 0, 0, 0, 1, 1},
+                 {0, 0, 0, 0, 1, 0},
+                 {1, 0, 0, 0, 0, 0},
+                 {0, 1, 1, 0, 0, 0},
+                 {1, 1, 0, 0, 0, 0}});
+    GraphReorder::Locality before = GraphReorder::locality(g);
+    CHECK(before.bandwidth == 5);
+
+    SUBCASE("every method gives a permutation") {
+        GraphReorder::Method methods[] = {GraphReorder::REVERSE_CUTHILL_MCKEE, GraphReorder::DEGREE_SORT, GraphReorder::BFS_ORDER};
+        for (GraphReorder::Method method : methods) {
+            std::vector<int> order = GraphReorder::order(g, method);
+            std::vector<int> sorted = order;
+            std::sort(sorted.begin(), sorted.end());
+            CHECK(sorted == std::vector<int>({0, 1, 2, 3, 4, 5}));
+        }
+        CHECK(GraphReorder::order(g, GraphReorder::BFS_ORDER) == std::vector<int>({0, 3, 5, 1, 4, 2}));
+    }
+
+    SUBCASE("RCM turns the path into a band of width 1") {
+        ReorderedGraph reordered(g, GraphReorder::REVERSE_CUTHILL_MCKEE);
+        CHECK(reordered.getLocalityBefore().bandwidth == 5);
+        CHECK(reordered.getLocalityAfter().bandwidth == 1);
+        CHECK(reordered.getLocalityAfter().averageGap == 1.0);
+        CHECK(reordered.getGraph().getEdgesNum() == g.getEdgesNum());
+        for (int v = 0; v < 6; ++v) {
+            CHECK(reordered.toOld(reordered.toNew(v)) == v);
+        }
+    }
+
+    SUBCASE("queries answer in original ids") {
+        ReorderedGraph reordered(g, GraphReorder::DEGREE_SORT);
+        CHECK(reordered.isConnected() == 1);
+        CHECK(reordered.shortestPath(3, 2) == "3->0->5->1->4->2");
+        CHECK(reordered.shortestPath(3, 9) == "-1");
+        CHECK(reordered.isContainsCycle() == "0");
+        CHECK(reordered.negativeCycle() == "0");
+
+        ReorderedGraph triangle;
+        triangle.loadGraph({{0, 1, 1, 0},
+                            {1, 0, 1, 0},
+                            {1, 1, 0, 1},
+                            {0, 0, 1, 0}}, GraphReorder::REVERSE_CUTHILL_MCKEE);
+        std::string cycle = triangle.isContainsCycle();
+        CHECK(cycle.find("The cycle is: ") == 0);
+        CHECK(cycle.find('3') == std::string::npos);
+        CHECK(triangle.isBipartite() == "0");
+
+        // The directed ring v->v+5 (mod 12), with two-digit ids in the results
+        std::vector<std::vector<int>> ring(12, std::vector<int>(12, 0));
+        for (int v = 0; v < 12; ++v) {
+            ring[v][(v + 5) % 12] = 1;
+        }
+        ReorderedGraph reorderedRing;
+        reorderedRing.loadGraph(ring, GraphReorder::REVERSE_CUTHILL_MCKEE);
+        CHECK(reorderedRing.shortestPath(0, 7) == "0->5->10->3->8->1->6->11->4->9->2->7");
+        CHECK(reorderedRing.shortestPath(11, 11) == "11");
+        CHECK(reorderedRing.isContainsCycle().find("The cycle is: ") == 0);
+
+        ring[11][4] = -20;
+        reorderedRing.loadGraph(ring, GraphReorder::REVERSE_CUTHILL_MCKEE);
+        Graph original;
+        original.loadGraph(ring);
+        std::vector<int> expected;
+        CHECK(Algorithms::negativeCycle(original, expected));
+        std::string negative = reorderedRing.negativeCycle();
+        CHECK(negative.find("The negative weight cycle is: ") == 0);
+        CHECK(std::count(negative.begin(), negative.end(), '>') == static_cast<long>(expected.size() - 1));
+        CHECK(negative.find("11->4") != std::string::npos);
+
+        std::vector<std::vector<int>> moved = ring;
+        reorderedRing.loadGraph(std::move(moved), GraphReorder::REVERSE_CUTHILL_MCKEE);
+        CHECK(moved.empty()); // The rvalue overload takes over the storage instead of copying it
+        CHECK(reorderedRing.negativeCycle() == negative);
+    }
+
+    SUBCASE("permute rejects a non-permutation") {
+        Graph out;
+        CHECK_THROWS_AS(GraphReorder::permute(g, {0, 1, 2}, out), std::invalid_argument);
+        CHECK_THROWS_AS(GraphReorder::permute(g, {0, 0, 1, 2, 3, 4}, out), std::invalid_argument);
+    }
+}
+
+TEST_CASE("PartitionedGraph methods") {
+    SUBCASE("results match the single-process algorithms") {
+        for (int seed = 1; seed <= 6; ++seed) {
+            GraphGenerator::Options options;
+            options.seed = seed;
+            options.directed = seed % 2 == 0;
+            Graph g;
+            GraphGenerator::erdosRenyi(g, 40, seed <= 3 ? 0.05 : 0.15, options);
+            PartitionedGraph partitioned(g, 3);
+            CHECK(partitioned.getPartNum() == 3);
+            CHECK(partitioned.isConnected() == Algorithms::isConnected(g));
+            for (int start = 0; start < 40; start += 7) {
+                for (int end = 0; end < 40; end += 5) {
+                    CHECK(partitioned.shortestPath(start, end) == Algorithms::shortestPath(g, start, end));
+                }
+            }
+        }
+    }
+
+    SUBCASE("communication is reported per round") {
+        Graph g;
+        g.loadGraph({{0, 1, 0, 0, 0},
+                     {1, 0, 1, 0, 0},
+                     {0, 1, 0, 1, 0},
+                     {0, 0, 1, 0, 1},
+                     {0, 0, 0, 1, 0}});
+        PartitionedGraph partitioned(g, 2);
+        CHECK(partitioned.shortestPath(0, 4) == "0->1->2->3->4");
+        REQUIRE(partitioned.getRounds().size() == 4);
+        CHECK(partitioned.getRounds()[0].frontierSize == 1);
+        CHECK(partitioned.getRounds()[0].bytesSent == 4 + 2 * 4); // A length word, ROUND and one vertex, to its owner only
+        CHECK(partitioned.getBytesReceived() > 0);
+        CHECK(partitioned.isConnected() == 1);
+        CHECK(partitioned.shortestPath(2, 9) == "-1");
+
+        Graph ring;
+        ring.loadGraph({{0, 1, 0, 0},
+                        {0, 0, 1, 0},
+                        {0, 0, 0, 1},
+                        {1, 0, 0, 0}});
+        PartitionedGraph directed(ring, 2);
+        CHECK(directed.isConnected() == 1);
+        REQUIRE(directed.getRounds().size() == 8);
+        CHECK(directed.getRounds()[0].bytesSent == 4 + 2 * 4);
+        CHECK(directed.getRounds()[4].bytesSent == 2 * (4 + 2 * 4)); // The reverse search needs the whole frontier
+    }
+
+    SUBCASE("workers load their ranges from an edge-list file") {
+        const char *path = "test_partitioned_edges.txt";
+        for (int seed = 1; seed <= 4; ++seed) {
+            GraphGenerator::Options options;
+            options.seed = seed;
+            options.directed = seed % 2 == 0;
+            Graph g;
+            GraphGenerator::erdosRenyi(g, 30, 0.08, options);
+            FILE *f = fopen(path, "w");
+            fputs("# edges\n", f);
+            for (int u = 0; u < 30; ++u) {
+                for (int v = options.directed ? 0 : u; v < 30; ++v) {
+                    if (g.getAdjacencyMatrix()[u][v] != 0) {
+                        fprintf(f, "%d %d\n", u, v);
+                    }
+                }
+            }
+            fputs("29 29 0\n", f); // Makes the last vertex exist without an edge
+            fclose(f);
+
+            PartitionedGraph partitioned(path, !options.directed, 3);
+            CHECK(partitioned.getVertexNum() == 30);
+            CHECK(partitioned.isConnected() == Algorithms::isConnected(g));
+            for (int start = 0; start < 30; start += 4) {
+                for (int end = 0; end < 30; end += 3) {
+                    CHECK(partitioned.shortestPath(start, end) == Algorithms::shortestPath(g, start, end));
+                }
+            }
+        }
+        remove(path);
+        CHECK_THROWS_AS(PartitionedGraph(path, false, 2), std::runtime_error);
+    }
+
+    SUBCASE("invalid use") {
+        Graph weighted;
+        weighted.loadGraph({{0, 3}, {3, 0}});
+        PartitionedGraph partitioned(weighted, 2);
+        CHECK_THROWS_AS(partitioned.shortestPath(0, 1), std::invalid_argument);
+        CHECK(partitioned.isConnected() == 1);
+        CHECK_THROWS_AS(PartitionedGraph(weighted, 0), std::invalid_argument);
+
+        std::atomic<bool> release(false);
+        std::thread other([&]() {
+            while (!release.load()) {
+                std::this_thread::yield();
+            }
+        });
+        CHECK_THROWS_AS(PartitionedGraph(weighted, 2), std::runtime_error); // Forking with another thread running
+        release = true;
+        other.join();
+    }
+}
+
+TEST_CASE("DynamicSSSP updates") {
+    // Distances of a fresh Dijkstra over the matrix, -1 for unreachable vertices
+    auto freshDistances = [](const Graph &g, int source) {
+        const auto &matrix = g.getAdjacencyMatrix();
+        int V = g.getVertexNum();
+        std::vector<long long> dist(V, -1);
+        std::vector<bool> done(V, false);
+        dist[source] = 0;
+        for (int round = 0; round < V; ++round) {
+            int u = -1;
+            for (int v = 0; v < V; ++v) {
+                if (!done[v] && dist[v] != -1 && (u == -1 || dist[v] < dist[u])) {
+                    u = v;
+                }
+            }
+            if (u == -1) {
+                break;
+            }
+            done[u] = true;
+            for (int v = 0; v < V; ++v) {
+                if (matrix[u][v] != 0 && (dist[v] == -1 || dist[u] + matrix[u][v] < dist[v])) {
+                    dist[v] = dist[u] + matrix[u][v];
+                }
+            }
+        }
+        return dist;
+    };
+
+    SUBCASE("random updates match a fresh run") {
+        for (int seed = 1; seed <= 4; ++seed) {
+            GraphGenerator::Options options;
+            options.seed = seed;
+            options.directed = seed % 2 == 0;
+            options.maxWeight = 9;
+            Graph g;
+            GraphGenerator::erdosRenyi(g, 30, 0.1, options);
+            DynamicSSSP sssp(g, 0);
+            unsigned state = static_cast<unsigned>(seed) * 2654435761u;
+            for (int step = 0; step < 300; ++step) {
+                state = state * 1103515245u + 12345u;
+                int u = static_cast<int>((state >> 8) % 30);
+                int v = static_cast<int>((state >> 16) % 30);
+                int weight = static_cast<int>((state >> 24) % 12); // 0 deletes, roughly one update in six
+                sssp.setEdge(u, v, weight > 9 ? 0 : weight);
+            }
+            const Graph &current = sssp.getGraph();
+            std::vector<long long> expected = freshDistances(current, 0);
+            for (int v = 0; v < 30; ++v) {
+                if (expected[v] == -1) {
+                    CHECK(sssp.getDistance(v) == infiniteDistance<long long>());
+                    CHECK(sssp.shortestPath(v) == "-1");
+                    CHECK(Algorithms::DijkstraShortestPath(current, 0, v) == "-1");
+                    continue;
+                }
+                CHECK(sssp.getDistance(v) == expected[v]);
+                long long length = 0;
+                for (int x = v; sssp.getParent(x) != -1; x = sssp.getParent(x)) {
+                    length += current.getAdjacencyMatrix()[sssp.getParent(x)][x];
+                }
+                CHECK(length == expected[v]);
+            }
+        }
+    }
+
+    SUBCASE("updates touch only the affected region") {
+        Graph g;
+        GraphGenerator::grid(g, 20, 20);
+        DynamicSSSP sssp(g, 0);
+        CHECK(sssp.getDistance(399) == 38);
+        CHECK(sssp.shortestPath(0) == "0");
+
+        sssp.setEdge(398, 399, 0); // The corner keeps its path through 379
+        sssp.setEdge(399, 398, 0);
+        CHECK(sssp.getDistance(399) == 38);
+        CHECK(sssp.getAffectedNum() <= 1);
+
+        sssp.setEdge(0, 399, 5); // A shortcut improves the vertices near the corner only
+        CHECK(sssp.getDistance(399) == 5);
+        CHECK(sssp.shortestPath(399) == "0->399");
+        CHECK(sssp.getDistance(398) == 8);
+        CHECK(sssp.getAffectedNum() > 1);
+        CHECK(sssp.getAffectedNum() < 400);
+
+        sssp.setEdge(0, 399, 0); // Deleting it restores the grid distances
+        CHECK(sssp.getDistance(399) == 38);
+        CHECK(sssp.getDistance(398) == 37);
+        CHECK(sssp.getAffectedNum() < 400);
+
+        sssp.setEdge(3, 3, 7);
+        CHECK(sssp.getAffectedNum() == 0);
+        CHECK(sssp.getGraph().getAdjacencyMatrix()[3][3] == 7);
+    }
+
+    SUBCASE("invalid use") {
+        Graph negative;
+        negative.loadGraph({{0, -1}, {2, 0}});
+        CHECK_THROWS_AS(DynamicSSSP(negative, 0), std::invalid_argument);
+        Graph g;
+        g.loadGraph({{0, 1}, {1, 0}});
+        CHECK_THROWS_AS(DynamicSSSP(g, 2), std::invalid_argument);
+        DynamicSSSP sssp(g, 1);
+        CHECK_THROWS_AS(sssp.setEdge(0, 1, -4), std::invalid_argument);
+        CHECK_THROWS_AS(sssp.setEdge(0, 5, 1), std::invalid_argument);
+        CHECK(sssp.shortestPath(0) == "1->0");
+        CHECK(sssp.getSource() == 1);
+    }
+}
+
+TEST_CASE("multiSourceBFS method") {
+    // The number of edges of a path "0->1->2", -1 for "-1"
+    auto edgesOf = [](const std::string &path) {
+        if (path == "-1") {
+            return -1;
+        }
+        int edges = 0;
+        for (size_t i = path.find("->"); i != std::string::npos; i = path.find("->", i + 2)) {
+            edges++;
+        }
+        return edges;
+    };
+
+    SUBCASE("distances match BFS from every source") {
+        ThreadPool pool(3);
+        for (int seed = 1; seed <= 4; ++seed) {
+            GraphGenerator::Options options;
+            options.seed = seed;
+            options.directed = seed % 2 == 0;
+            options.maxWeight = 5;
+            Graph g;
+            GraphGenerator::erdosRenyi(g, 90, 0.03, options);
+            std::vector<int> sources;
+            for (int i = 0; i < 70; ++i) { // Two batches, with repeated sources
+                sources.push_back((i * 7) % 90);
+            }
+            std::vector<std::vector<int>> distances, parallel, compressed;
+            REQUIRE(Algorithms::multiSourceBFS(g, sources, distances) == true);
+            REQUIRE(Algorithms::multiSourceBFS(g, sources, parallel, ExecutionContext(&pool)) == true);
+            REQUIRE(Algorithms::multiSourceBFS(CompressedGraph(g), sources, compressed) == true);
+            REQUIRE(distances.size() == sources.size());
+            CHECK(parallel == distances);
+            CHECK(compressed == distances);
+            for (size_t i = 0; i < sources.size(); i += 3) {
+                for (int v = 0; v < 90; v += 4) {
+                    CHECK(distances[i][v] == edgesOf(Algorithms::BFSShortestPath(g, sources[i], v)));
+                }
+            }
+        }
+    }
+
+    SUBCASE("views and invalid sources") {
+        Graph g;
+        g.loadGraph({{0, 1, 0, 0},
+                     {1, 0, 4, 0},
+                     {0, 4, 0, 1},
+                     {0, 0, 1, 0}});
+        std::vector<std::vector<int>> distances;
+        CHECK(Algorithms::multiSourceBFS(g, {0, 3}, distances) == true);
+        CHECK(distances == std::vector<std::vector<int>>{{0, 1, 2, 3}, {3, 2, 1, 0}});
+        GraphView light(g);
+        light.keepWeights(1, 1);
+        CHECK(Algorithms::multiSourceBFS(light, {0, 3}, distances) == true);
+        CHECK(distances == std::vector<std::vector<int>>{{0, 1, -1, -1}, {-1, -1, 1, 0}});
+        CHECK(Algorithms::multiSourceBFS(g, {}, distances) == true);
+        CHECK(distances.empty());
+        CHECK(Algorithms::multiSourceBFS(g, {1, 4}, distances) == false);
+        CHECK(distances.empty());
+    }
+}
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+#include <malloc.h>
+#define HAS_MALLINFO2
+
+// The bytes handed out by malloc in all arenas, to check ExternalGraph's own accounting from outside
+static long long heapInUse() {
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<long long>(info.uordblks + info.hblkhd);
+}
+#endif
+
+TEST_CASE("ExternalGraph methods") {
+    const char *path = "test_graph.ext";
+    ExternalGraph::Options small;
+    small.blockSize = 256;
+    small.memoryBytes = 16 << 10;
+    small.tempDir = ".";
+
+    SUBCASE("BFS, distance and isConnected match the matrix algorithms") {
+        for (int seed = 1; seed <= 4; ++seed) {
+            GraphGenerator::Options options;
+            options.seed = seed;
+            options.directed = seed % 2 == 0;
+            Graph g;
+            GraphGenerator::erdosRenyi(g, 300, seed <= 2 ? 0.1 : 0.008, options);
+            ExternalGraph::build(g, path, small);
+            ExternalGraph external(path, small);
+            CHECK(external.getVertexNum() == 300);
+            CHECK(external.getEdgesNum() == g.getEdgesNum());
+            CHECK(external.getIsDirected() == g.getIsDirected());
+
+            std::vector<std::vector<int>> expected;
+            REQUIRE(Algorithms::multiSourceBFS(g, {7}, expected) == true);
+            std::vector<int> distances(300, -1);
+            int lastDistance = 0;
+            bool ordered = true;
+            long long heapGrowth = 0;
+#ifdef HAS_MALLINFO2
+            long long heapBefore = heapInUse();
+#endif
+            long long reached = external.BFS(7, [&](int v, int d) {
+                ordered = ordered && d >= lastDistance;
+                lastDistance = d;
+                distances[v] = d;
+#ifdef HAS_MALLINFO2
+                heapGrowth = std::max(heapGrowth, heapInUse() - heapBefore); // Sampled while the levels are merged
+#endif
+            });
+            CHECK(distances == expected[0]);
+            CHECK(ordered);
+            CHECK(heapGrowth <= static_cast<long long>(small.memoryBytes));
+            CHECK(reached == 300 - std::count(distances.begin(), distances.end(), -1));
+            CHECK(external.getStats().peakMemoryBytes <= small.memoryBytes);
+            CHECK(external.getStats().edgesScanned > 0);
+            if (seed <= 2) {
+                CHECK(external.getStats().runFiles > 0); // The neighbours of a level do not fit in the sort buffer
+            }
+            for (int target = 0; target < 300; target += 37) {
+                CHECK(external.distance(7, target) == expected[0][target]);
+            }
+            CHECK(external.isConnected() == Algorithms::isConnected(g));
+        }
+    }
+
+    SUBCASE("edge list files") {
+        const char *textPath = "test_graph.txt";
+        FILE *f = fopen(textPath, "w");
+        fputs("# a path with a repeated edge and an isolated pair\n0 1\n1 2 5\n1 2\n2 3\n4 5\n5 4 0\n", f);
+        fclose(f);
+        ExternalGraph::buildFromEdgeList(textPath, path, true, small);
+        ExternalGraph external(path, small);
+        CHECK(external.getVertexNum() == 6);
+        CHECK(external.getEdgesNum() == 4);
+        CHECK(external.getIsDirected() == false);
+        CHECK(external.distance(0, 3) == 3);
+        CHECK(external.distance(3, 0) == 3);
+        CHECK(external.distance(0, 4) == -1);
+        CHECK(external.isConnected() == 0);
+
+        ExternalGraph::buildFromEdgeList(textPath, path, false, small);
+        external.open(path);
+        CHECK(external.getIsDirected() == true);
+        CHECK(external.distance(0, 3) == 3);
+        CHECK(external.distance(3, 0) == -1);
+
+        f = fopen(textPath, "w");
+        fprintf(f, "# %s\n0 1\n", std::string(2000, 'x').c_str()); // Longer than the 1 KiB chunk of a 16 KiB cap
+        fclose(f);
+        CHECK_THROWS_AS(ExternalGraph::buildFromEdgeList(textPath, path, true, small), GraphParser::ParseError);
+        remove(textPath);
+    }
+
+    SUBCASE("invalid use") {
+        Graph g;
+        g.loadGraph({{0, 1}, {1, 0}});
+        ExternalGraph::Options options = small;
+        options.blockSize = 30;
+        CHECK_THROWS_AS(ExternalGraph::build(g, path, options), std::invalid_argument);
+        options.blockSize = 64;
+        options.memoryBytes = 512;
+        CHECK_THROWS_AS(ExternalGraph::build(g, path, options), std::invalid_argument);
+        ExternalGraph::build(g, path, small);
+        ExternalGraph external(path, small);
+        CHECK(external.isConnected() == 1);
+        CHECK_THROWS_AS(external.distance(0, 2), std::invalid_argument);
+        CHECK_THROWS_AS(ExternalGraph("missing_graph.ext"), std::runtime_error);
+
+        Graph big;
+        GraphGenerator::erdosRenyi(big, 300, 0.1, GraphGenerator::Options());
+        ExternalGraph::build(big, path, small);
+        ExternalGraph::Options tight = small;
+        tight.memoryBytes = 2600; // Two blocks and eight I/O buffers, but not the index of about 150 blocks
+        CHECK_THROWS_AS(ExternalGraph(path, tight), std::runtime_error);
+        FILE *f = fopen(path, "w");
+        fputs("not an external graph file, only some text to fill the header", f);
+        fclose(f);
+        CHECK_THROWS_AS(ExternalGraph external2(path), std::invalid_argument);
+    }
+
+    SUBCASE("corrupt files") {
+        Graph g;
+        g.loadGraph({{0, 1, 0, 0},
+                     {1, 0, 1, 0},
+                     {0, 1, 0, 1},
+                     {0, 0, 1, 0}});
+        ExternalGraphHeader header;
+        // Builds the path graph again and overwrites a field of the given size at the given position
+        auto corrupt = [&](uint64_t at, uint64_t value, size_t size) {
+            ExternalGraph::build(g, path, small);
+            FILE *f = fopen(path, "r+b");
+            REQUIRE(fread(&header, sizeof(header), 1, f) == 1);
+            uint32_t narrow = static_cast<uint32_t>(value);
+            fseek(f, static_cast<long>(at), SEEK_SET);
+            fwrite(size == sizeof(narrow) ? static_cast<const void *>(&narrow) : static_cast<const void *>(&value), size, 1, f);
+            fclose(f);
+        };
+
+        corrupt(offsetof(ExternalGraphHeader, vertexNum), 1ull << 40, 8);
+        CHECK_THROWS_AS(ExternalGraph external(path, small), std::invalid_argument);
+        corrupt(offsetof(ExternalGraphHeader, dataOffset), 1ull << 62, 8);
+        CHECK_THROWS_AS(ExternalGraph external(path, small), std::invalid_argument);
+        corrupt(offsetof(ExternalGraphHeader, forwardBlocks), 1ull << 60, 8); // blocks * blockSize wraps around
+        CHECK_THROWS_AS(ExternalGraph external(path, small), std::invalid_argument);
+        corrupt(offsetof(ExternalGraphHeader, indexOffset), header.indexOffset + 8, 8);
+        CHECK_THROWS_AS(ExternalGraph external(path, small), std::invalid_argument);
+        corrupt(offsetof(ExternalGraphHeader, reverseBlocks), 1, 8); // An undirected graph has no reverse section
+        CHECK_THROWS_AS(ExternalGraph external(path, small), std::invalid_argument);
+        corrupt(offsetof(ExternalGraphHeader, blockSize), 100, 4);
+        CHECK_THROWS_AS(ExternalGraph external(path, small), std::invalid_argument);
+        corrupt(header.indexOffset, 9 << 1, 8); // The first block starts at vertex 9
+        CHECK_THROWS_AS(ExternalGraph external(path, small), std::invalid_argument);
+
+        // Records are "vertex | count | targets": 0 | 1 | 1, then 1 | 2 | 0 2, ...
+        corrupt(header.dataOffset + 4, 1000, 4);
+        {
+            ExternalGraph external(path, small);
+            CHECK_THROWS_AS(external.isConnected(), std::runtime_error);
+        }
+        corrupt(header.dataOffset + 8, 7, 4);
+        {
+            ExternalGraph external(path, small);
+            CHECK_THROWS_AS(external.isConnected(), std::runtime_error);
+        }
+        corrupt(header.dataOffset, 5, 4);
+        {
+            ExternalGraph external(path, small);
+            CHECK_THROWS_AS(external.isConnected(), std::runtime_error);
+        }
+        corrupt(header.dataOffset + 8, 1, 4); // Unchanged
+        ExternalGraph external(path, small);
+        CHECK(external.isConnected() == 1);
+    }
+    remove(path);
+}
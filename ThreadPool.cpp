@@ -0,0 +1,231 @@
+//mail: guyes134@gmail.com
+
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+    // The pool and worker index of the calling thread, or nullptr and -1 outside every pool
+    thread_local const ThreadPool *workerPool = nullptr;
+    thread_local int workerIndex = -1;
+}
+
+/**
+ * @brief Constructor that starts a fixed number of workers.
+ *
+ * @param workerNum The number of workers; 0 uses one per hardware thread.
+ */
+ThreadPool::ThreadPool(int workerNum) : queued(0), nextQueue(0), stopping(false) {
+    if (workerNum < 0) {
+        throw invalid_argument("Invalid thread pool: The number of workers is negative.");
+    }
+    if (workerNum == 0) {
+        workerNum = max(1u, thread::hardware_concurrency());
+    }
+    for (int i = 0; i < workerNum; ++i) {
+        queues.push_back(unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (int i = 0; i < workerNum; ++i) {
+        threads.push_back(thread(&ThreadPool::workerLoop, this, i));
+    }
+}
+
+/**
+ * @brief Destructor that stops and joins the workers. Every task group must have been waited for.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread &worker : threads) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Returns how many tasks of a call limited to maxParallelism workers can run at the same time.
+ *
+ * @param maxParallelism The limit of the call, 0 for no limit.
+ * @return int The number of workers the call may use.
+ */
+int ThreadPool::concurrency(int maxParallelism) const {
+    return maxParallelism > 0 ? min(maxParallelism, getWorkerNum()) : getWorkerNum();
+}
+
+int ThreadPool::currentWorker() const {
+    return workerPool == this ? workerIndex : -1;
+}
+
+/**
+ * @brief Queues a task: on the deque of the calling worker, or round-robin when called from outside the pool.
+ */
+void ThreadPool::push(Task task) {
+    int self = currentWorker();
+    WorkerQueue &queue = *queues[self >= 0 ? self : nextQueue++ % queues.size()];
+    {
+        lock_guard<mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        queued++;
+    }
+    wake.notify_one();
+}
+
+/**
+ * @brief Runs one task: the newest of the own deque, else the oldest of another deque.
+ *
+ * @param self The index of the calling worker, -1 outside the pool.
+ * @return bool Returns true if a task was run, false if every deque was empty.
+ */
+bool ThreadPool::runOne(int self) {
+    Task task;
+    bool found = false;
+    if (self >= 0) {
+        WorkerQueue &own = *queues[self];
+        lock_guard<mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+    int n = static_cast<int>(queues.size());
+    for (int k = 1; !found && k <= n; ++k) {
+        WorkerQueue &victim = *queues[(max(self, 0) + k) % n];
+        lock_guard<mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+    queued--;
+
+    exception_ptr error;
+    try {
+        task.work();
+    } catch (...) {
+        error = current_exception();
+    }
+    task.group->finish(error);
+    return true;
+}
+
+void ThreadPool::workerLoop(int index) {
+    workerPool = this;
+    workerIndex = index;
+    while (true) {
+        if (runOne(index)) {
+            continue;
+        }
+        unique_lock<mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() <= 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Runs body over [begin, end) in chunks of grain indices on at most concurrency(maxParallelism) workers.
+ *
+ * Each of the lanes is a single task that keeps taking the next chunk until none is left, so uneven chunks
+ * balance out. A lane runs on one thread at a time, which makes lane a safe index into per-lane scratch memory
+ * sized with concurrency(maxParallelism). With one lane the body runs on the calling thread.
+ *
+ * @param begin The first index.
+ * @param end One past the last index.
+ * @param grain The number of indices per chunk (at least 1).
+ * @param body Called as body(lane, chunkBegin, chunkEnd).
+ * @param maxParallelism The most workers to use, 0 for all of them.
+ */
+void ThreadPool::parallelFor(int begin, int end, int grain, const function<void(int, int, int)> &body, int maxParallelism) {
+    if (begin >= end) {
+        return;
+    }
+    grain = max(grain, 1);
+    long long chunks = (static_cast<long long>(end) - begin + grain - 1) / grain;
+    int lanes = static_cast<int>(min<long long>(concurrency(maxParallelism), chunks));
+    if (lanes <= 1) {
+        body(0, begin, end);
+        return;
+    }
+
+    atomic<long long> next(begin);
+    TaskGroup group(*this);
+    for (int lane = 0; lane < lanes; ++lane) {
+        group.run([&body, &next, lane, end, grain]() {
+            for (long long lo = next.fetch_add(grain); lo < end; lo = next.fetch_add(grain)) {
+                body(lane, static_cast<int>(lo), static_cast<int>(min<long long>(lo + grain, end)));
+            }
+        });
+    }
+    group.wait();
+}
+
+/**
+ * @brief Constructor for an empty task group on the given pool.
+ */
+ThreadPool::TaskGroup::TaskGroup(ThreadPool &threadPool) : pool(threadPool), pending(0) {}
+
+/**
+ * @brief Destructor that waits for the tasks still running; their exceptions are dropped.
+ */
+ThreadPool::TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+    }
+}
+
+/**
+ * @brief Forks a task onto the pool.
+ *
+ * @param task The work to run.
+ */
+void ThreadPool::TaskGroup::run(function<void()> task) {
+    pending++;
+    pool.push(Task{std::move(task), this});
+}
+
+void ThreadPool::TaskGroup::finish(exception_ptr taskError) {
+    lock_guard<mutex> lock(groupMutex);
+    if (taskError && !error) {
+        error = taskError;
+    }
+    if (--pending == 0) {
+        done.notify_all();
+    }
+}
+
+/**
+ * @brief Waits until every forked task finished, then rethrows the first exception one of them threw.
+ *
+ * A worker of the pool runs other tasks while it waits; any other thread blocks.
+ */
+void ThreadPool::TaskGroup::wait() {
+    int self = pool.currentWorker();
+    if (self >= 0) {
+        while (pending.load() > 0) {
+            if (!pool.runOne(self)) {
+                this_thread::yield();
+            }
+        }
+    }
+    unique_lock<mutex> lock(groupMutex); // Also waits for the last finish to release the group
+    done.wait(lock, [this]() { return pending.load() == 0; });
+    if (error) {
+        exception_ptr taskError = error;
+        error = nullptr;
+        rethrow_exception(taskError);
+    }
+}
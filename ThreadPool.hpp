@@ -0,0 +1,104 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of worker threads that share work by stealing, the one place where Algorithms uses more than one core.
+ *
+ * Every worker owns a deque: it pushes and pops its own tasks at the back (newest first, which keeps the data of a
+ * fork/join recursion hot) and steals from the front of the other deques when its own is empty. Tasks submitted
+ * from outside the pool are dealt round-robin to the workers. A worker that waits for a task group keeps running
+ * tasks meanwhile, so nested parallelism cannot deadlock the pool; a thread outside the pool just blocks.
+ */
+class ThreadPool{
+public:
+    /**
+     * Fork/join: run() forks a task, wait() joins every task forked so far and rethrows the first exception any
+     * of them threw. The destructor waits as well, so a group never outlives its tasks.
+     */
+    class TaskGroup{
+    private:
+        ThreadPool &pool;
+        std::atomic<int> pending;
+        std::mutex groupMutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+
+        void finish(std::exception_ptr taskError);
+        friend class ThreadPool;
+
+    public:
+        explicit TaskGroup(ThreadPool &threadPool);
+        ~TaskGroup();
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+        void run(std::function<void()> task);
+        void wait();
+    };
+
+private:
+    struct Task {
+        std::function<void()> work;
+        TaskGroup *group;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queued;
+    std::atomic<unsigned> nextQueue;
+    bool stopping;
+
+    void push(Task task);
+    bool runOne(int self);
+    void workerLoop(int index);
+    int currentWorker() const;
+
+public:
+    //methods
+    int concurrency(int maxParallelism) const;
+    void parallelFor(int begin, int end, int grain, const std::function<void(int lane, int begin, int end)> &body, int maxParallelism = 0);
+
+    //constructors
+    explicit ThreadPool(int workerNum = 0);
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool();
+
+    int getWorkerNum() const{
+        return static_cast<int>(threads.size());
+    }
+};
+
+/**
+ * How an Algorithms call may run in parallel: on which pool and on how many of its workers at most
+ * (0 means all of them). The default context runs the call on the calling thread only.
+ */
+struct ExecutionContext {
+    ThreadPool *pool;
+    int maxParallelism;
+
+    ExecutionContext(ThreadPool *threadPool = nullptr, int parallelism = 0) : pool(threadPool), maxParallelism(parallelism) {}
+
+    int concurrency() const{
+        return pool == nullptr ? 1 : pool->concurrency(maxParallelism);
+    }
+};
@@ -0,0 +1,192 @@
+//mail: guyes134@gmail.com
+
+#include "Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    struct Event {
+        const char *name;
+        int64_t beginNs;
+        int64_t endNs;
+    };
+
+    const uint64_t RING_SIZE = 1 << 15; // Events kept per thread, a power of two
+
+    /**
+     * The ring of one thread. Only its thread writes it; head is published with release so that a reader
+     * acquiring it sees complete events (a reader racing with a wrap-around can still see an overwritten slot).
+     */
+    struct Ring {
+        vector<Event> events;
+        atomic<uint64_t> head;
+        int tid;
+
+        explicit Ring(int id) : events(RING_SIZE), head(0), tid(id) {}
+    };
+
+    mutex registryMutex;
+    vector<shared_ptr<Ring>> &registry() {
+        static vector<shared_ptr<Ring>> rings;
+        return rings;
+    }
+
+    // The rings of the threads that exited, kept for dumps until a new thread takes them over
+    vector<shared_ptr<Ring>> &freeRings() {
+        static vector<shared_ptr<Ring>> rings;
+        return rings;
+    }
+
+    // Hands the ring of a thread back when the thread exits
+    struct RingHolder {
+        shared_ptr<Ring> ring;
+
+        ~RingHolder() {
+            if (ring) {
+                lock_guard<mutex> lock(registryMutex);
+                freeRings().push_back(ring);
+            }
+        }
+    };
+
+    /**
+     * Gives the calling thread a ring on its first span, the only place that takes a lock. A ring left by an exited
+     * thread is continued before a new one is made, so there are never more rings than threads recording at once:
+     * a server starting a thread per connection does not grow the trace without bound.
+     */
+    Ring &threadRing() {
+        thread_local RingHolder holder;
+        if (!holder.ring) {
+            lock_guard<mutex> lock(registryMutex);
+            if (!freeRings().empty()) {
+                holder.ring = freeRings().back();
+                freeRings().pop_back();
+            } else {
+                holder.ring = make_shared<Ring>(static_cast<int>(registry().size()) + 1);
+                registry().push_back(holder.ring);
+            }
+        }
+        return *holder.ring;
+    }
+
+    void writeName(ostream &out, const char *name) {
+        out << '"';
+        for (const char *p = name; *p != '\0'; ++p) {
+            if (*p == '"' || *p == '\\') {
+                out << '\\';
+            }
+            out << *p;
+        }
+        out << '"';
+    }
+}
+
+atomic<bool> Trace::Detail::enabledFlag(false);
+
+int64_t Trace::Detail::nowNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Appends a span to the ring of the calling thread.
+ *
+ * @param name The name of the span.
+ * @param beginNs The start of the span in steady clock nanoseconds.
+ * @param endNs The end of the span in steady clock nanoseconds.
+ */
+void Trace::Detail::record(const char *name, int64_t beginNs, int64_t endNs) {
+    Ring &ring = threadRing();
+    uint64_t index = ring.head.load(memory_order_relaxed);
+    Event &event = ring.events[index & (RING_SIZE - 1)];
+    event.name = name;
+    event.beginNs = beginNs;
+    event.endNs = endNs;
+    ring.head.store(index + 1, memory_order_release);
+}
+
+/**
+ * @brief Turns span recording on or off for all threads.
+ *
+ * @param on Records spans if true.
+ */
+void Trace::enable(bool on) {
+    Detail::enabledFlag.store(on, memory_order_relaxed);
+}
+
+/**
+ * @brief Drops every recorded span. Should not run while other threads are recording.
+ */
+void Trace::clear() {
+    lock_guard<mutex> lock(registryMutex);
+    for (const shared_ptr<Ring> &ring : registry()) {
+        ring->head.store(0, memory_order_release);
+    }
+}
+
+/**
+ * @brief Returns the number of rings allocated, each holding up to 32768 spans.
+ *
+ * @return size_t The most threads that have recorded at the same time.
+ */
+size_t Trace::ringCount() {
+    lock_guard<mutex> lock(registryMutex);
+    return registry().size();
+}
+
+/**
+ * @brief Returns the number of spans currently held by all rings.
+ *
+ * @return size_t The number of spans a dump would write.
+ */
+size_t Trace::eventCount() {
+    lock_guard<mutex> lock(registryMutex);
+    size_t count = 0;
+    for (const shared_ptr<Ring> &ring : registry()) {
+        count += static_cast<size_t>(min<uint64_t>(ring->head.load(memory_order_acquire), RING_SIZE));
+    }
+    return count;
+}
+
+/**
+ * @brief Writes the recorded spans as Chrome trace-event JSON ({"traceEvents": [...]}).
+ *
+ * Times are microseconds relative to the earliest recorded span. Best called while the traced threads are idle.
+ *
+ * @param out The stream to write to.
+ */
+void Trace::writeChromeJSON(ostream &out) {
+    lock_guard<mutex> lock(registryMutex);
+    int64_t origin = 0;
+    bool haveOrigin = false;
+    for (const shared_ptr<Ring> &ring : registry()) {
+        uint64_t head = ring->head.load(memory_order_acquire);
+        for (uint64_t i = head > RING_SIZE ? head - RING_SIZE : 0; i < head; ++i) {
+            int64_t begin = ring->events[i & (RING_SIZE - 1)].beginNs;
+            if (!haveOrigin || begin < origin) {
+                origin = begin;
+                haveOrigin = true;
+            }
+        }
+    }
+
+    out << "{\"traceEvents\": [";
+    bool first = true;
+    for (const shared_ptr<Ring> &ring : registry()) {
+        uint64_t head = ring->head.load(memory_order_acquire);
+        for (uint64_t i = head > RING_SIZE ? head - RING_SIZE : 0; i < head; ++i) {
+            const Event &event = ring->events[i & (RING_SIZE - 1)];
+            out << (first ? "\n" : ",\n") << "  {\"name\": ";
+            writeName(out, event.name);
+            out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << ring->tid
+                << ", \"ts\": " << (event.beginNs - origin) / 1000.0
+                << ", \"dur\": " << (event.endNs - event.beginNs) / 1000.0 << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+}
@@ -0,0 +1,63 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * Timeline tracing in the Chrome trace-event format (chrome://tracing, Perfetto).
+ *
+ * TRACE_SPAN("name") records the time from its declaration to the end of the enclosing scope. Every thread writes
+ * its spans into its own fixed-size ring buffer without locks (the oldest spans are overwritten once it is full).
+ * The ring of a thread that exits is reused by the next new thread, whose spans go on under the same tid.
+ * Tracing is always compiled in and off by default; while it is off a span costs one relaxed atomic load.
+ * Span names must be string literals or otherwise outlive the trace.
+ */
+namespace Trace{
+    namespace Detail {
+        extern std::atomic<bool> enabledFlag;
+        int64_t nowNs();
+        void record(const char *name, int64_t beginNs, int64_t endNs);
+    }
+
+    void enable(bool on);
+    void clear();
+    size_t eventCount();
+    size_t ringCount();
+    void writeChromeJSON(std::ostream &out);
+
+    inline bool enabled(){
+        return Detail::enabledFlag.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Records one complete ("X") event when it goes out of scope, if tracing was on when it was created.
+     */
+    class Span{
+    private:
+        const char *name;
+        int64_t beginNs;
+
+    public:
+        explicit Span(const char *spanName) : name(enabled() ? spanName : nullptr), beginNs(0){
+            if (name != nullptr) {
+                beginNs = Detail::nowNs();
+            }
+        }
+
+        ~Span(){
+            if (name != nullptr) {
+                Detail::record(name, beginNs, Detail::nowNs());
+            }
+        }
+
+        Span(const Span &) = delete;
+        Span &operator=(const Span &) = delete;
+    };
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SPAN(name) Trace::Span TRACE_CONCAT(traceSpan_, __LINE__)(name)
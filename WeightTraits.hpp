@@ -0,0 +1,79 @@
+//mail: guyes134@gmail.com
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/**
+ * Maps an edge weight type to the type used to accumulate path distances.
+ *
+ * Integer weights are summed in 64 bits, so a path of up to 2^32 edges of 32-bit weights cannot overflow,
+ * and 64-bit weights saturate instead of wrapping (see addDistance). Floating point weights use double.
+ * The algorithms also accept int, long, long long or double distances for integer weights (see Algorithms.hpp).
+ */
+template <typename Weight>
+struct WeightTraits {
+    typedef long long Distance;
+};
+
+template <>
+struct WeightTraits<float> {
+    typedef double Distance;
+};
+
+template <>
+struct WeightTraits<double> {
+    typedef double Distance;
+};
+
+namespace WeightDetail {
+    template <typename Distance>
+    Distance addDistance(Distance dist, Distance weight, std::true_type) {
+        if (weight > 0 && dist >= std::numeric_limits<Distance>::max() - weight) {
+            return std::numeric_limits<Distance>::max() - 1;
+        }
+        if (weight < 0 && dist <= std::numeric_limits<Distance>::min() - weight) {
+            return std::numeric_limits<Distance>::min() + 1;
+        }
+        return dist + weight;
+    }
+
+    template <typename Distance>
+    Distance addDistance(Distance dist, Distance weight, std::false_type) {
+        Distance sum = dist + weight;
+        if (sum >= std::numeric_limits<Distance>::max()) {
+            return std::nextafter(std::numeric_limits<Distance>::max(), Distance(0));
+        }
+        if (sum <= std::numeric_limits<Distance>::lowest()) {
+            return std::nextafter(std::numeric_limits<Distance>::lowest(), Distance(0));
+        }
+        return sum;
+    }
+}
+
+/**
+ * @brief Adds an edge weight to a distance, saturating just inside the limits of the distance type.
+ *
+ * The largest and the lowest values are kept for unreached vertices (see infiniteDistance), so a path whose length
+ * saturates is still told apart from no path at all.
+ *
+ * @param dist The distance so far.
+ * @param weight The weight of the edge.
+ * @return Distance The new distance, clamped to the finite range of Distance.
+ */
+template <typename Distance, typename Weight>
+Distance addDistance(Distance dist, Weight weight) {
+    return WeightDetail::addDistance<Distance>(dist, static_cast<Distance>(weight), std::is_integral<Distance>());
+}
+
+/**
+ * @brief The distance used for unreached vertices (the largest value of the distance type). addDistance never
+ * returns it.
+ */
+template <typename Distance>
+Distance infiniteDistance() {
+    return std::numeric_limits<Distance>::max();
+}
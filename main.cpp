@@ -1,165 +1,218 @@
-//mail: guyes134@gmail.com
-
-#include <string>
-#include <vector>
-#include "Graph.hpp"
-#include "Algorithms.hpp"
-#include <iostream>
-#include <stdexcept>
-
-using namespace std;
-
-int main() {
-    Graph g;
-    vector<vector<int>> graph = {
-            {0, 1, 0},
-            {1, 0, 1},
-            {0, 1, 0}};
-    g.loadGraph(graph);
-
-    g.printGraph();
-    cout << Algorithms::isConnected(g) << endl;
-    cout << Algorithms::shortestPath(g, 0, 2) << endl;
-    cout << Algorithms::isContainsCycle(g) << endl;
-    cout << Algorithms::isBipartite(g) << endl;
-    cout << Algorithms::negativeCycle(g) << endl;
-
-    cout << "" << endl;
-
-    vector<vector<int>> graph2 = {
-            {0, 1, 1, 0, 0},
-            {1, 0, 1, 0, 0},
-            {1, 1, 0, 1, 0},
-            {0, 0, 1, 0, 0},
-            {0, 0, 0, 0, 0}};
-
-    g.loadGraph(graph2);
-
-    g.printGraph();
-    cout << Algorithms::isConnected(g) << endl;
-    cout << Algorithms::shortestPath(g, 0, 4) << endl;
-    cout << Algorithms::isContainsCycle(g) << endl;
-    cout << Algorithms::isBipartite(g) << endl;
-    cout << Algorithms::negativeCycle(g) << endl;
-
-    cout << "" << endl;
-
-    vector<vector<int>> graph3 = {
-            {0, 1, 0, 0, 0},
-            {1, 0, 3, 0, 0},
-            {0, 3, 0, 4, 0},
-            {0, 0, 4, 0, 5},
-            {0, 0, 0, 5, 0}};
-    g.loadGraph(graph3);
-
-    g.printGraph();
-    cout << Algorithms::isConnected(g) << endl;
-    cout << Algorithms::shortestPath(g, 0, 4) << endl;
-    cout << Algorithms::isContainsCycle(g) << endl;
-    cout << Algorithms::isBipartite(g) << endl;
-    cout << Algorithms::negativeCycle(g) << endl;
-
-    cout << "" << endl;
-
-    std::vector<std::vector<int>> graph5 = {
-            {0, 1, 0, 0, 0},
-            {1, 0, 3, 0, 0},
-            {0, 3, 0, 4, 0},
-            {0, 0, 4, 0, 5},
-            {0, 0, 0, 5, 0}
-    };
-
-    g.loadGraph(graph5);
-
-    std::cout << "Graph 5:" << std::endl;
-    g.printGraph();
-    cout << Algorithms::isContainsCycle(g) << endl;
-    cout << Algorithms::negativeCycle(g) << endl;
-
-    std::vector<std::vector<int>> graph6 = {
-            {0, 1, 0, 0, 0},
-            {1, 0, -3, 0, 0},
-            {0, -3, 0, 4, 0},
-            {0, 0, 4, 0, 5},
-            {0, 0, 0, 5, 0}
-    };
-
-    g.loadGraph(graph6);
-
-    std::cout << "Graph 6:" << std::endl;
-    g.printGraph();
-    cout << Algorithms::isContainsCycle(g) << endl;
-    cout << Algorithms::negativeCycle(g) << endl;
-
-    std::vector<std::vector<int>> graph7 = {
-            {0, 1, 0, 0, 0},
-            {1, 0, 3, 0, 0},
-            {0, 3, 0, 4, 0},
-            {0, 0, 4, 0, -5},
-            {0, 0, 0, -5, 0}
-    };
-
-    g.loadGraph(graph7);
-
-    std::cout << "Graph 7:" << std::endl;
-    g.printGraph();
-    cout << Algorithms::isContainsCycle(g) << endl;
-    cout << Algorithms::negativeCycle(g) << endl;
-
-    vector<vector<int>> graph4 = {
-            {0, 1, 2, 0},
-            {1, 0, 3, 0},
-            {2, 3, 0, 4},
-            {0, 0, 4, 0},
-            {0, 0, 0, 5}};
-    try
-    {
-        g.loadGraph(graph4);
-    }
-    catch (const std::invalid_argument &e)
-    {
-        cout << e.what() << endl;
-    }
-
-
-    std::vector<std::vector<int>> graphWithNegativeCycle = {
-            {0, 1, 0, 0, 0},
-            {0, 0, -1, 0, 0},
-            {0, 0, 0, 1, 0},
-            {0, 0, 0, 0, 1},
-            {0, 0, 0, -5, 0}
-    };
-
-    g.loadGraph(graphWithNegativeCycle);
-
-    g.printGraph();
-    cout << Algorithms::isConnected(g) << endl;
-    cout << Algorithms::shortestPath(g, 0, 4) << endl;
-    cout << Algorithms::isContainsCycle(g) << endl;
-    cout << Algorithms::isBipartite(g) << endl;
-    cout << Algorithms::negativeCycle(g) << endl;
-
-    std::vector<std::vector<int>> adjacencyMatrix = {
-            {0, 1, 0, 0},
-            {0, 0, -2, 0},
-            {0, 0, 0, -2},
-            {1, 0, 0, 0}
-    };
-    g.loadGraph(adjacencyMatrix);
-
-    g.printGraph();
-    cout << Algorithms::isConnected(g) << endl;
-    cout << Algorithms::shortestPath(g, 0, 3) << endl;
-    cout << Algorithms::isContainsCycle(g) << endl;
-    cout << Algorithms::isBipartite(g) << endl;
-    cout << Algorithms::negativeCycle(g) << endl;
-
-    vector<vector<int>> matrix1 = {
-            {0,  -1, 7,  8},
-            {10, 0,  -1, 6},
-            {9,  9,  0,  -1},
-            {-1, 7,  8,  0}
-    };
-
-    g.loadGraph(matrix1);
-    cout << Algorithms::negativeCycle(g) << endl;
+//mail: guyes134@gmail.com
+
+#include <string>
+#include <vector>
+#include "Graph.hpp"
+#include "Algorithms.hpp"
+#include "GraphServer.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * @brief Runs the query server: my_program --serve <graph file> [--edges] [--undirected] [--threads n] [--socket path] [--reload-dir dir]
+ *
+ * Without --socket the requests are read from stdin and answered on stdout.
+ */
+int serve(int argc, char *argv[]) {
+    if (argc < 3) {
+        cerr << "usage: " << argv[0] << " --serve <graph file> [--edges] [--undirected] [--threads n] [--socket path] [--reload-dir dir]" << endl;
+        return 2;
+    }
+    GraphServer::Options options;
+    string socketPath;
+    for (int i = 3; i < argc; ++i) {
+        if (strcmp(argv[i], "--edges") == 0) {
+            options.edgeList = true;
+        } else if (strcmp(argv[i], "--undirected") == 0) {
+            options.undirected = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (strcmp(argv[i], "--reload-dir") == 0 && i + 1 < argc) {
+            options.reloadDir = argv[++i];
+        } else {
+            cerr << "unknown option: " << argv[i] << endl;
+            return 2;
+        }
+    }
+
+    try {
+        GraphServer server(argv[2], options);
+        if (socketPath.empty()) {
+            server.serve(0, 1);
+        } else {
+            server.serveUnixSocket(socketPath);
+        }
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--serve") == 0) {
+        return serve(argc, argv);
+    }
+
+    Graph g;
+    vector<vector<int>> graph = {
+            {0, 1, 0},
+            {1, 0, 1},
+            {0, 1, 0}};
+    g.loadGraph(graph);
+
+    g.printGraph();
+    cout << Algorithms::isConnected(g) << endl;
+    cout << Algorithms::shortestPath(g, 0, 2) << endl;
+    cout << Algorithms::isContainsCycle(g) << endl;
+    cout << Algorithms::isBipartite(g) << endl;
+    cout << Algorithms::negativeCycle(g) << endl;
+
+    cout << "" << endl;
+
+    vector<vector<int>> graph2 = {
+            {0, 1, 1, 0, 0},
+            {1, 0, 1, 0, 0},
+            {1, 1, 0, 1, 0},
+            {0, 0, 1, 0, 0},
+            {0, 0, 0, 0, 0}};
+
+    g.loadGraph(graph2);
+
+    g.printGraph();
+    cout << Algorithms::isConnected(g) << endl;
+    cout << Algorithms::shortestPath(g, 0, 4) << endl;
+    cout << Algorithms::isContainsCycle(g) << endl;
+    cout << Algorithms::isBipartite(g) << endl;
+    cout << Algorithms::negativeCycle(g) << endl;
+
+    cout << "" << endl;
+
+    vector<vector<int>> graph3 = {
+            {0, 1, 0, 0, 0},
+            {1, 0, 3, 0, 0},
+            {0, 3, 0, 4, 0},
+            {0, 0, 4, 0, 5},
+            {0, 0, 0, 5, 0}};
+    g.loadGraph(graph3);
+
+    g.printGraph();
+    cout << Algorithms::isConnected(g) << endl;
+    cout << Algorithms::shortestPath(g, 0, 4) << endl;
+    cout << Algorithms::isContainsCycle(g) << endl;
+    cout << Algorithms::isBipartite(g) << endl;
+    cout << Algorithms::negativeCycle(g) << endl;
+
+    cout << "" << endl;
+
+    std::vector<std::vector<int>> graph5 = {
+            {0, 1, 0, 0, 0},
+            {1, 0, 3, 0, 0},
+            {0, 3, 0, 4, 0},
+            {0, 0, 4, 0, 5},
+            {0, 0, 0, 5, 0}
+    };
+
+    g.loadGraph(graph5);
+
+    std::cout << "Graph 5:" << std::endl;
+    g.printGraph();
+    cout << Algorithms::isContainsCycle(g) << endl;
+    cout << Algorithms::negativeCycle(g) << endl;
+
+    std::vector<std::vector<int>> graph6 = {
+            {0, 1, 0, 0, 0},
+            {1, 0, -3, 0, 0},
+            {0, -3, 0, 4, 0},
+            {0, 0, 4, 0, 5},
+            {0, 0, 0, 5, 0}
+    };
+
+    g.loadGraph(graph6);
+
+    std::cout << "Graph 6:" << std::endl;
+    g.printGraph();
+    cout << Algorithms::isContainsCycle(g) << endl;
+    cout << Algorithms::negativeCycle(g) << endl;
+
+    std::vector<std::vector<int>> graph7 = {
+            {0, 1, 0, 0, 0},
+            {1, 0, 3, 0, 0},
+            {0, 3, 0, 4, 0},
+            {0, 0, 4, 0, -5},
+            {0, 0, 0, -5, 0}
+    };
+
+    g.loadGraph(graph7);
+
+    std::cout << "Graph 7:" << std::endl;
+    g.printGraph();
+    cout << Algorithms::isContainsCycle(g) << endl;
+    cout << Algorithms::negativeCycle(g) << endl;
+
+    vector<vector<int>> graph4 = {
+            {0, 1, 2, 0},
+            {1, 0, 3, 0},
+            {2, 3, 0, 4},
+            {0, 0, 4, 0},
+            {0, 0, 0, 5}};
+    try
+    {
+        g.loadGraph(graph4);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        cout << e.what() << endl;
+    }
+
+
+    std::vector<std::vector<int>> graphWithNegativeCycle = {
+            {0, 1, 0, 0, 0},
+            {0, 0, -1, 0, 0},
+            {0, 0, 0, 1, 0},
+            {0, 0, 0, 0, 1},
+            {0, 0, 0, -5, 0}
+    };
+
+    g.loadGraph(graphWithNegativeCycle);
+
+    g.printGraph();
+    cout << Algorithms::isConnected(g) << endl;
+    cout << Algorithms::shortestPath(g, 0, 4) << endl;
+    cout << Algorithms::isContainsCycle(g) << endl;
+    cout << Algorithms::isBipartite(g) << endl;
+    cout << Algorithms::negativeCycle(g) << endl;
+
+    std::vector<std::vector<int>> adjacencyMatrix = {
+            {0, 1, 0, 0},
+            {0, 0, -2, 0},
+            {0, 0, 0, -2},
+            {1, 0, 0, 0}
+    };
+    g.loadGraph(adjacencyMatrix);
+
+    g.printGraph();
+    cout << Algorithms::isConnected(g) << endl;
+    cout << Algorithms::shortestPath(g, 0, 3) << endl;
+    cout << Algorithms::isContainsCycle(g) << endl;
+    cout << Algorithms::isBipartite(g) << endl;
+    cout << Algorithms::negativeCycle(g) << endl;
+
+    vector<vector<int>> matrix1 = {
+            {0,  -1, 7,  8},
+            {10, 0,  -1, 6},
+            {9,  9,  0,  -1},
+            {-1, 7,  8,  0}
+    };
+
+    g.loadGraph(matrix1);
+    cout << Algorithms::negativeCycle(g) << endl;
+
+    return 0;
+}